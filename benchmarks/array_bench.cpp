@@ -0,0 +1,315 @@
+#include <benchmark/benchmark.h>
+
+#include <nostd/array/array.h>
+#include <nostd/storage/arena_storage.h>
+#include <nostd/storage/huge_page_storage.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+
+namespace {
+
+struct Record {
+    int64_t id;
+    int64_t key;
+    double weight;
+};
+
+// Same layouts, relocated element by element
+struct SlowInt64 {
+    int64_t val;
+};
+
+struct SlowRecord : Record {
+};
+
+} // namespace
+
+template <>
+struct nostd::is_trivially_relocatable<SlowInt64> : std::false_type {
+};
+
+template <>
+struct nostd::is_trivially_relocatable<SlowRecord> : std::false_type {
+};
+
+template <typename T>
+static void BM_PushBack(benchmark::State& state) {
+    const auto count = static_cast<size_t>(state.range(0));
+
+    for (auto _ : state) {
+        nostd::Array<T> array;
+        for (size_t idx = 0; idx < count; ++idx) {
+            array.push_back(T{});
+        }
+        benchmark::DoNotOptimize(array.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_PushBack<int64_t>)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_PushBack<SlowInt64>)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_PushBack<Record>)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_PushBack<SlowRecord>)->Range(1 << 10, 1 << 22);
+
+static void BM_Accumulate(benchmark::State& state) {
+    nostd::Array<float> array(static_cast<size_t>(state.range(0)), 1.5f);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::accumulate(array.begin(), array.end(), 0.0f));
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<int64_t>(sizeof(float)));
+}
+
+static void BM_Transform(benchmark::State& state) {
+    nostd::Array<float> src(static_cast<size_t>(state.range(0)), 1.5f);
+    nostd::Array<float> dst(static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        std::transform(src.begin(), src.end(), dst.begin(), [](float val) { return val * 2.0f + 1.0f; });
+        benchmark::DoNotOptimize(dst.data());
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<int64_t>(sizeof(float)));
+}
+
+BENCHMARK(BM_Accumulate)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_Transform)->Range(1 << 10, 1 << 20);
+
+template <typename T>
+static void BM_Copy(benchmark::State& state) {
+    const nostd::Array<T> src(static_cast<size_t>(state.range(0)), T{});
+
+    for (auto _ : state) {
+        nostd::Array<T> copy(src);
+        benchmark::DoNotOptimize(copy.data());
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<int64_t>(sizeof(T)));
+}
+
+static void BM_CopyAssign(benchmark::State& state) {
+    const nostd::Array<uint32_t> src(static_cast<size_t>(state.range(0)), 7);
+    nostd::Array<uint32_t> dst(static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        dst = src;
+        benchmark::DoNotOptimize(dst.data());
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<int64_t>(sizeof(uint32_t)));
+}
+
+static void BM_Clear(benchmark::State& state) {
+    nostd::Array<uint32_t> array;
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        array.resize_for_overwrite(static_cast<size_t>(state.range(0)));
+        state.ResumeTiming();
+
+        array.clear();
+        benchmark::DoNotOptimize(array.data());
+    }
+}
+
+BENCHMARK(BM_Copy<uint32_t>)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_Copy<Record>)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_CopyAssign)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_Clear)->Range(1 << 10, 1 << 24);
+
+// Dependent random loads over the whole array, dominated by TLB misses for large sizes
+template <template <typename> typename Storage>
+static void BM_RandomGather(benchmark::State& state) {
+    const auto size = static_cast<size_t>(state.range(0));
+    nostd::Array<uint64_t, Storage> array(size);
+    std::mt19937_64 gen(42);
+    for (auto& next: array) {
+        next = gen() % size;
+    }
+
+    constexpr size_t LOADS = 1 << 16;
+    uint64_t idx = 0;
+    for (auto _ : state) {
+        for (size_t load = 0; load < LOADS; ++load) {
+            idx = array[idx];
+        }
+    }
+    benchmark::DoNotOptimize(idx);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(LOADS));
+}
+
+BENCHMARK(BM_RandomGather<nostd::storage::DynamicStorage>)->Range(1 << 16, 1 << 26);
+BENCHMARK(BM_RandomGather<nostd::storage::HugePageStorage>)->Range(1 << 16, 1 << 26);
+
+// A request builds many short arrays and drops them together
+static void BM_RequestArrays(benchmark::State& state) {
+    const auto arrays = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        nostd::Array<nostd::Array<int64_t>> request;
+        request.reserve(arrays);
+        for (size_t idx = 0; idx < arrays; ++idx) {
+            request.emplace_back();
+            for (int64_t val = 0; val < 20; ++val) {
+                request.back().push_back(val);
+            }
+        }
+        benchmark::DoNotOptimize(request.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(arrays));
+}
+
+static void BM_RequestArraysArena(benchmark::State& state) {
+    using ArenaArray = nostd::Array<int64_t, nostd::storage::ArenaStorage::storage_type>;
+    const auto arrays = static_cast<size_t>(state.range(0));
+    nostd::storage::Arena arena;
+    for (auto _ : state) {
+        {
+            nostd::Array<ArenaArray> request;
+            request.reserve(arrays);
+            for (size_t idx = 0; idx < arrays; ++idx) {
+                request.emplace_back(arena);
+                for (int64_t val = 0; val < 20; ++val) {
+                    request.back().push_back(val);
+                }
+            }
+            benchmark::DoNotOptimize(request.data());
+        }
+        arena.release();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(arrays));
+}
+
+BENCHMARK(BM_RequestArrays)->Range(1 << 6, 1 << 12);
+BENCHMARK(BM_RequestArraysArena)->Range(1 << 6, 1 << 12);
+
+// Bitmap index query: AND of two large bit vectors, then the hit count
+static void BM_BitmapAndBitwise(benchmark::State& state) {
+    const auto size = static_cast<size_t>(state.range(0));
+    nostd::Array<bool> lhs, rhs;
+    for (size_t idx = 0; idx < size; ++idx) {
+        lhs.push_back(idx % 3 == 0);
+        rhs.push_back(idx % 5 == 0);
+    }
+
+    for (auto _ : state) {
+        nostd::Array<bool> result(size);
+        for (size_t idx = 0; idx < size; ++idx) {
+            result[idx] = lhs[idx] && rhs[idx];
+        }
+        benchmark::DoNotOptimize(std::count(result.begin(), result.end(), true));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(size / 8));
+}
+
+static void BM_BitmapAndWords(benchmark::State& state) {
+    const auto size = static_cast<size_t>(state.range(0));
+    nostd::Array<bool> lhs, rhs;
+    for (size_t idx = 0; idx < size; ++idx) {
+        lhs.push_back(idx % 3 == 0);
+        rhs.push_back(idx % 5 == 0);
+    }
+
+    for (auto _ : state) {
+        nostd::Array<bool> result = lhs;
+        result &= rhs;
+        benchmark::DoNotOptimize(result.count());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(size / 8));
+}
+
+BENCHMARK(BM_BitmapAndBitwise)->Range(1 << 16, 1 << 26);
+BENCHMARK(BM_BitmapAndWords)->Range(1 << 16, 1 << 26);
+
+// Candidate filtering: one bit in 1024 set, the positions are summed
+static nostd::Array<bool> SparseBitmap(size_t size) {
+    nostd::Array<bool> bits(size, false);
+    for (size_t idx = 517; idx < size; idx += 1024) {
+        bits[idx] = true;
+    }
+    return bits;
+}
+
+static void BM_BitmapScanIterator(benchmark::State& state) {
+    const auto bits = SparseBitmap(static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        size_t sum = 0;
+        size_t idx = 0;
+        for (bool bit: bits) {
+            sum += bit ? idx : 0;
+            ++idx;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(bits.size() / 8));
+}
+
+static void BM_BitmapScanSetBits(benchmark::State& state) {
+    const auto bits = SparseBitmap(static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        size_t sum = 0;
+        for (size_t idx: bits.set_bits()) {
+            sum += idx;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(bits.size() / 8));
+}
+
+static void BM_BitmapScanForEach(benchmark::State& state) {
+    const auto bits = SparseBitmap(static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        size_t sum = 0;
+        bits.for_each_set_bit([&](size_t idx) { sum += idx; });
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(bits.size() / 8));
+}
+
+BENCHMARK(BM_BitmapScanIterator)->Range(1 << 16, 1 << 26);
+BENCHMARK(BM_BitmapScanSetBits)->Range(1 << 16, 1 << 26);
+BENCHMARK(BM_BitmapScanForEach)->Range(1 << 16, 1 << 26);
+
+static void BM_BitmapBuildPushBack(benchmark::State& state) {
+    const auto size = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        nostd::Array<bool> bits;
+        for (size_t idx = 0; idx < size; ++idx) {
+            bits.push_back(true);
+        }
+        benchmark::DoNotOptimize(bits.data());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(size / 8));
+}
+
+static void BM_BitmapBuildAppendBits(benchmark::State& state) {
+    const auto size = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        nostd::Array<bool> bits;
+        for (size_t idx = 0; idx < size; idx += 64) {
+            bits.append_bits(0x5555555555555555, 64);
+        }
+        benchmark::DoNotOptimize(bits.data());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(size / 8));
+}
+
+static void BM_BitmapBuildFill(benchmark::State& state) {
+    const auto size = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        nostd::Array<bool> bits(size, true);
+        benchmark::DoNotOptimize(bits.data());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(size / 8));
+}
+
+BENCHMARK(BM_BitmapBuildPushBack)->Range(1 << 16, 1 << 26);
+BENCHMARK(BM_BitmapBuildAppendBits)->Range(1 << 16, 1 << 26);
+BENCHMARK(BM_BitmapBuildFill)->Range(1 << 16, 1 << 26);
@@ -0,0 +1,95 @@
+#include <benchmark/benchmark.h>
+
+#include <nostd/array/array.h>
+#include <nostd/array/atomic_bit_array.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <vector>
+
+namespace {
+
+// Visited marks of a traversal: batches of neighbours, sorted and close together
+constexpr size_t VERTICES = size_t{1} << 24;
+constexpr size_t BATCH = 16;
+constexpr size_t BATCHES = 1 << 14;
+
+std::vector<size_t> Neighbours(uint64_t seed) {
+    std::mt19937_64 gen(seed);
+    std::vector<size_t> result;
+    for (size_t batch = 0; batch < BATCHES; ++batch) {
+        const size_t base = gen() % (VERTICES - 256);
+        const size_t begin = result.size();
+        for (size_t idx = 0; idx < BATCH; ++idx) {
+            result.push_back(base + gen() % 256);
+        }
+        std::sort(result.begin() + static_cast<int64_t>(begin), result.end());
+    }
+    return result;
+}
+
+std::mutex mutex;
+std::unique_ptr<nostd::Array<bool>> locked;
+std::unique_ptr<nostd::AtomicBitArray> atomic;
+
+} // namespace
+
+static void BM_MarkMutex(benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        locked = std::make_unique<nostd::Array<bool>>(VERTICES, false);
+    }
+    const auto neighbours = Neighbours(state.thread_index());
+    size_t batch = 0;
+    for (auto _ : state) {
+        std::lock_guard lock(mutex);
+        for (size_t idx = 0; idx < BATCH; ++idx) {
+            (*locked)[neighbours[batch * BATCH + idx]] = true;
+        }
+        batch = (batch + 1) % BATCHES;
+    }
+    if (state.thread_index() == 0) {
+        locked.reset();
+    }
+    state.SetItemsProcessed(state.iterations() * BATCH);
+}
+
+static void BM_MarkTestAndSet(benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        atomic = std::make_unique<nostd::AtomicBitArray>(VERTICES);
+    }
+    const auto neighbours = Neighbours(state.thread_index());
+    size_t batch = 0;
+    for (auto _ : state) {
+        for (size_t idx = 0; idx < BATCH; ++idx) {
+            benchmark::DoNotOptimize(atomic->test_and_set(neighbours[batch * BATCH + idx], std::memory_order_relaxed));
+        }
+        batch = (batch + 1) % BATCHES;
+    }
+    if (state.thread_index() == 0) {
+        atomic.reset();
+    }
+    state.SetItemsProcessed(state.iterations() * BATCH);
+}
+
+static void BM_MarkSetMany(benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        atomic = std::make_unique<nostd::AtomicBitArray>(VERTICES);
+    }
+    const auto neighbours = Neighbours(state.thread_index());
+    size_t batch = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(atomic->set_many({neighbours.data() + batch * BATCH, BATCH}, std::memory_order_relaxed));
+        batch = (batch + 1) % BATCHES;
+    }
+    if (state.thread_index() == 0) {
+        atomic.reset();
+    }
+    state.SetItemsProcessed(state.iterations() * BATCH);
+}
+
+BENCHMARK(BM_MarkMutex)->ThreadRange(1, 8);
+BENCHMARK(BM_MarkTestAndSet)->ThreadRange(1, 8);
+BENCHMARK(BM_MarkSetMany)->ThreadRange(1, 8);
@@ -0,0 +1,113 @@
+#include <benchmark/benchmark.h>
+
+#include <nostd/array/array.h>
+#include <nostd/bits/compressed_bitmap.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+namespace {
+
+// Runs of about `run` ones, gaps of about `gap` zeros
+nostd::Array<bool> ClusteredBits(size_t size, size_t run, size_t gap, uint64_t seed) {
+    std::mt19937_64 gen(seed);
+    nostd::Array<bool> bits(size, false);
+    std::uniform_int_distribution<size_t> gaps(0, 2 * gap);
+    std::uniform_int_distribution<size_t> runs(1, 2 * run);
+    for (size_t pos = gaps(gen); pos < size;) {
+        const size_t last = std::min(size, pos + runs(gen));
+        bits.fill(pos, last, true);
+        pos = last + gaps(gen) + 1;
+    }
+    return bits;
+}
+
+nostd::Array<bool> RandomBits(size_t size, uint64_t seed) {
+    std::mt19937_64 gen(seed);
+    nostd::Array<bool> bits;
+    for (size_t idx = 0; idx < size; idx += 64) {
+        bits.append_bits(gen(), 64);
+    }
+    return bits;
+}
+
+constexpr size_t SPARSE_BITS = size_t{1} << 30;
+constexpr size_t DENSE_BITS = size_t{1} << 26;
+
+} // namespace
+
+// 0.1% of 2^30 bits in clusters: Array<bool> against CompressedBitmap
+static void BM_SparseAndArray(benchmark::State& state) {
+    const auto lhs = ClusteredBits(SPARSE_BITS, 64, 64000, 1);
+    const auto rhs = ClusteredBits(SPARSE_BITS, 64, 64000, 2);
+
+    for (auto _ : state) {
+        auto result = lhs;
+        result &= rhs;
+        benchmark::DoNotOptimize(result.data());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(2 * SPARSE_BITS / 8));
+    state.counters["bytes"] = static_cast<double>(lhs.capacity() / 8);
+}
+
+static void BM_SparseAndCompressed(benchmark::State& state) {
+    const nostd::bits::CompressedBitmap lhs(ClusteredBits(SPARSE_BITS, 64, 64000, 1));
+    const nostd::bits::CompressedBitmap rhs(ClusteredBits(SPARSE_BITS, 64, 64000, 2));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize((lhs & rhs).empty());
+    }
+    // As bytes of the uncompressed operands
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(2 * SPARSE_BITS / 8));
+    state.counters["bytes"] = static_cast<double>(lhs.memory_bytes());
+}
+
+static void BM_SparseOrCompressed(benchmark::State& state) {
+    const nostd::bits::CompressedBitmap lhs(ClusteredBits(SPARSE_BITS, 64, 64000, 1));
+    const nostd::bits::CompressedBitmap rhs(ClusteredBits(SPARSE_BITS, 64, 64000, 2));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize((lhs | rhs).empty());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(2 * SPARSE_BITS / 8));
+}
+
+// Half the bits set: every chunk is a bitset
+static void BM_DenseAndCompressed(benchmark::State& state) {
+    const nostd::bits::CompressedBitmap lhs(RandomBits(DENSE_BITS, 1));
+    const nostd::bits::CompressedBitmap rhs(RandomBits(DENSE_BITS, 2));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize((lhs & rhs).empty());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(2 * DENSE_BITS / 8));
+}
+
+static void BM_DenseOrCompressed(benchmark::State& state) {
+    const nostd::bits::CompressedBitmap lhs(RandomBits(DENSE_BITS, 1));
+    const nostd::bits::CompressedBitmap rhs(RandomBits(DENSE_BITS, 2));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize((lhs | rhs).empty());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(2 * DENSE_BITS / 8));
+}
+
+static void BM_SparseForEach(benchmark::State& state) {
+    const nostd::bits::CompressedBitmap bitmap(ClusteredBits(SPARSE_BITS, 64, 64000, 1));
+
+    for (auto _ : state) {
+        uint64_t sum = 0;
+        bitmap.for_each([&](uint64_t pos) { sum += pos; });
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(bitmap.cardinality()));
+}
+
+BENCHMARK(BM_SparseAndArray)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SparseAndCompressed)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SparseOrCompressed)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_DenseAndCompressed)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_DenseOrCompressed)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SparseForEach)->Unit(benchmark::kMillisecond);
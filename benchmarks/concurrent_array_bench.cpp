@@ -0,0 +1,49 @@
+#include <benchmark/benchmark.h>
+
+#include <nostd/array/array.h>
+#include <nostd/array/concurrent_array.h>
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace {
+
+// Pushes per thread, the arrays only grow
+constexpr int64_t PUSHES = 1 << 20;
+
+std::mutex mutex;
+std::unique_ptr<nostd::Array<uint64_t>> locked;
+std::unique_ptr<nostd::ConcurrentArray<uint64_t>> concurrent;
+
+} // namespace
+
+static void BM_MutexArrayPush(benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        locked = std::make_unique<nostd::Array<uint64_t>>();
+    }
+    for (auto _ : state) {
+        std::lock_guard lock(mutex);
+        locked->push_back(42);
+    }
+    if (state.thread_index() == 0) {
+        locked.reset();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_ConcurrentArrayPush(benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        concurrent = std::make_unique<nostd::ConcurrentArray<uint64_t>>();
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(concurrent->push_back(42));
+    }
+    if (state.thread_index() == 0) {
+        concurrent.reset();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_MutexArrayPush)->Iterations(PUSHES)->ThreadRange(1, 32)->UseRealTime();
+BENCHMARK(BM_ConcurrentArrayPush)->Iterations(PUSHES)->ThreadRange(1, 32)->UseRealTime();
@@ -0,0 +1,68 @@
+#include <benchmark/benchmark.h>
+
+#include <nostd/array/array.h>
+#include <nostd/parallel/parallel.h>
+
+#include <cmath>
+
+namespace {
+
+constexpr size_t SIZE = size_t{1} << 24;
+
+nostd::Array<double>& Input() {
+    static nostd::Array<double> input(SIZE, 1.25);
+    return input;
+}
+
+} // namespace
+
+static void BM_ParallelReduce(benchmark::State& state) {
+    const auto threads = static_cast<size_t>(state.range(0));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(nostd::parallel::reduce(Input(), 0.0, std::plus<>(), threads));
+    }
+
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(SIZE * sizeof(double)));
+}
+
+static void BM_ParallelTransform(benchmark::State& state) {
+    const auto threads = static_cast<size_t>(state.range(0));
+    nostd::Array<double> out(SIZE, nostd::uninit);
+
+    for (auto _ : state) {
+        nostd::parallel::transform(Input(), out, [](double val) { return std::sqrt(val) * 3.0; }, threads);
+        benchmark::DoNotOptimize(out.data());
+    }
+
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(SIZE * sizeof(double)));
+}
+
+static void BM_ParallelInclusiveScan(benchmark::State& state) {
+    const auto threads = static_cast<size_t>(state.range(0));
+    nostd::Array<double> out(SIZE, nostd::uninit);
+
+    for (auto _ : state) {
+        nostd::parallel::inclusive_scan(Input(), out, std::plus<>(), threads);
+        benchmark::DoNotOptimize(out.data());
+    }
+
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(SIZE * sizeof(double)));
+}
+
+static void BM_ParallelFill(benchmark::State& state) {
+    const auto threads = static_cast<size_t>(state.range(0));
+    nostd::Array<double> out(SIZE, nostd::uninit);
+
+    for (auto _ : state) {
+        nostd::parallel::fill(out, 2.0, threads);
+        benchmark::DoNotOptimize(out.data());
+    }
+
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(SIZE * sizeof(double)));
+}
+
+BENCHMARK(BM_ParallelReduce)->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+BENCHMARK(BM_ParallelTransform)->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+BENCHMARK(BM_ParallelInclusiveScan)->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+BENCHMARK(BM_ParallelFill)->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
@@ -0,0 +1,79 @@
+#include <benchmark/benchmark.h>
+
+#include <nostd/array/array.h>
+#include <nostd/bits/rank_select.h>
+#include <nostd/simd/simd.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+namespace {
+
+nostd::Array<bool> RandomBits(size_t size) {
+    std::mt19937_64 gen(42);
+    nostd::Array<bool> bits;
+    bits.reserve(size);
+    for (size_t idx = 0; idx < size; idx += 64) {
+        bits.append_bits(gen(), 64);
+    }
+    return bits;
+}
+
+} // namespace
+
+// Rank by counting the words before the position
+static void BM_RankScan(benchmark::State& state) {
+    const auto size = static_cast<size_t>(state.range(0));
+    const auto bits = RandomBits(size);
+    const auto& kernels = nostd::simd::bit_kernels();
+    std::mt19937_64 gen(1);
+
+    for (auto _ : state) {
+        const size_t idx = gen() % size;
+        size_t rank = kernels.popcount(bits.data(), idx / 64);
+        rank += std::popcount(bits.data()[idx / 64] & ((uint64_t{1} << (idx % 64)) - 1));
+        benchmark::DoNotOptimize(rank);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_RankIndex(benchmark::State& state) {
+    const auto size = static_cast<size_t>(state.range(0));
+    const auto bits = RandomBits(size);
+    const nostd::bits::RankSelect index(bits);
+    std::mt19937_64 gen(1);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(index.rank1(gen() % size));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_SelectIndex(benchmark::State& state) {
+    const auto size = static_cast<size_t>(state.range(0));
+    const auto bits = RandomBits(size);
+    const nostd::bits::RankSelect index(bits);
+    std::mt19937_64 gen(1);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(index.select1(gen() % index.ones()));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_IndexBuild(benchmark::State& state) {
+    const auto size = static_cast<size_t>(state.range(0));
+    const auto bits = RandomBits(size);
+
+    for (auto _ : state) {
+        nostd::bits::RankSelect index(bits);
+        benchmark::DoNotOptimize(index.ones());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(size / 8));
+}
+
+BENCHMARK(BM_RankScan)->Range(1 << 16, 1 << 26);
+BENCHMARK(BM_RankIndex)->Range(1 << 16, 1 << 26);
+BENCHMARK(BM_SelectIndex)->Range(1 << 16, 1 << 26);
+BENCHMARK(BM_IndexBuild)->Range(1 << 16, 1 << 26);
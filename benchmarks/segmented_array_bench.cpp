@@ -0,0 +1,53 @@
+#include <benchmark/benchmark.h>
+
+#include <nostd/array/array.h>
+#include <nostd/array/segmented_array.h>
+
+#include <cstdint>
+#include <string>
+
+namespace {
+
+// Not trivially relocatable, Array moves every element on growth
+struct Entry {
+    std::string name;
+    int64_t id;
+};
+
+} // namespace
+
+template <typename A>
+static void BM_GrowEntries(benchmark::State& state) {
+    const auto size = static_cast<int64_t>(state.range(0));
+    for (auto _ : state) {
+        A array;
+        for (int64_t idx = 0; idx < size; ++idx) {
+            array.push_back(Entry{"registry entry name", idx});
+        }
+        benchmark::DoNotOptimize(&array[0]);
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template <typename A>
+static void BM_IndexSum(benchmark::State& state) {
+    const auto size = static_cast<size_t>(state.range(0));
+    A array;
+    for (size_t idx = 0; idx < size; ++idx) {
+        array.push_back(static_cast<int64_t>(idx));
+    }
+
+    for (auto _ : state) {
+        int64_t sum = 0;
+        for (size_t idx = 0; idx < size; ++idx) {
+            sum += array[idx];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+
+BENCHMARK(BM_GrowEntries<nostd::Array<Entry>>)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_GrowEntries<nostd::SegmentedArray<Entry>>)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_IndexSum<nostd::Array<int64_t>>)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_IndexSum<nostd::SegmentedArray<int64_t>>)->Range(1 << 10, 1 << 20);
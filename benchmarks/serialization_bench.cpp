@@ -0,0 +1,67 @@
+#include <benchmark/benchmark.h>
+
+#include <nostd/array/array.h>
+#include <nostd/serialization/serialization.h>
+
+#include <numeric>
+#include <sstream>
+
+namespace {
+
+const nostd::Array<double>& Input(size_t size) {
+    static nostd::Array<double> input;
+    if (input.size() != size) {
+        input = nostd::Array<double>(size);
+        std::iota(input.begin(), input.end(), 0.0);
+    }
+    return input;
+}
+
+} // namespace
+
+// What snapshots did before: one stream write per element
+static void BM_StreamPerElement(benchmark::State& state) {
+    const auto& input = Input(static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        std::ostringstream out;
+        for (double val: input) {
+            out.write(reinterpret_cast<const char*>(&val), sizeof(val));
+        }
+        benchmark::DoNotOptimize(out.tellp());
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<int64_t>(sizeof(double)));
+}
+
+static void BM_SerializeStream(benchmark::State& state) {
+    const auto& input = Input(static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        std::ostringstream out;
+        nostd::serialize(input, out);
+        benchmark::DoNotOptimize(out.tellp());
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<int64_t>(sizeof(double)));
+}
+
+static void BM_SerializeBuffer(benchmark::State& state) {
+    const auto& input = Input(static_cast<size_t>(state.range(0)));
+    nostd::Array<std::byte> buffer;
+    buffer.reserve(nostd::serialized_size(input));
+
+    for (auto _ : state) {
+        buffer.clear();
+        nostd::serialize(input, [&](std::span<const std::byte> bytes) {
+            buffer.append_range(bytes);
+        });
+        benchmark::DoNotOptimize(buffer.data());
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<int64_t>(sizeof(double)));
+}
+
+BENCHMARK(BM_StreamPerElement)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_SerializeStream)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_SerializeBuffer)->Range(1 << 10, 1 << 20);
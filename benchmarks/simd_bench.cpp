@@ -0,0 +1,104 @@
+#include <benchmark/benchmark.h>
+
+#include <nostd/array/array.h>
+#include <nostd/simd/simd.h>
+
+#include <cstdint>
+
+namespace {
+
+// Fits in L2, so the kernels are measured rather than memory bandwidth
+constexpr size_t SIZE = size_t{1} << 16;
+
+using nostd::simd::Isa;
+
+template <typename T>
+const nostd::Array<T>& Input() {
+    static const nostd::Array<T> input = [] {
+        nostd::Array<T> array(SIZE);
+        for (size_t idx = 0; idx < SIZE; ++idx) {
+            array[idx] = static_cast<T>(idx % 100);
+        }
+        return array;
+    }();
+    return input;
+}
+
+template <typename T>
+const nostd::simd::Kernels<T>* Kernels(benchmark::State& state) {
+    const auto isa = static_cast<Isa>(state.range(0));
+    if (!nostd::simd::supported(isa)) {
+        state.SkipWithError("instruction set is not supported by this CPU");
+        return nullptr;
+    }
+    return &nostd::simd::kernels<T>(isa);
+}
+
+template <typename T>
+void SetBytes(benchmark::State& state, size_t arrays = 1) {
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(arrays * SIZE * sizeof(T)));
+}
+
+} // namespace
+
+template <typename T>
+static void BM_SimdSum(benchmark::State& state) {
+    const auto* kernels = Kernels<T>(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(kernels->sum(Input<T>().data(), SIZE));
+    }
+    SetBytes<T>(state);
+}
+
+template <typename T>
+static void BM_SimdMinMax(benchmark::State& state) {
+    const auto* kernels = Kernels<T>(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(kernels->minmax(Input<T>().data(), SIZE));
+    }
+    SetBytes<T>(state);
+}
+
+template <typename T>
+static void BM_SimdDot(benchmark::State& state) {
+    const auto* kernels = Kernels<T>(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(kernels->dot(Input<T>().data(), Input<T>().data(), SIZE));
+    }
+    SetBytes<T>(state, 2);
+}
+
+template <typename T>
+static void BM_SimdCount(benchmark::State& state) {
+    const auto* kernels = Kernels<T>(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(kernels->count(Input<T>().data(), SIZE, T(42)));
+    }
+    SetBytes<T>(state);
+}
+
+template <typename T>
+static void BM_SimdFind(benchmark::State& state) {
+    const auto* kernels = Kernels<T>(state);
+    for (auto _ : state) {
+        // Not present, the whole array is scanned
+        benchmark::DoNotOptimize(kernels->find(Input<T>().data(), SIZE, T(101)));
+    }
+    SetBytes<T>(state);
+}
+
+// Argument is the Isa: 0 scalar, 1 SSE2, 2 AVX2, 3 AVX-512
+#define SIMD_BENCHMARK(NAME, T) BENCHMARK(NAME<T>)->DenseRange(0, 3)
+
+SIMD_BENCHMARK(BM_SimdSum, int32_t);
+SIMD_BENCHMARK(BM_SimdSum, float);
+SIMD_BENCHMARK(BM_SimdSum, double);
+SIMD_BENCHMARK(BM_SimdMinMax, int8_t);
+SIMD_BENCHMARK(BM_SimdMinMax, int32_t);
+SIMD_BENCHMARK(BM_SimdMinMax, float);
+SIMD_BENCHMARK(BM_SimdDot, float);
+SIMD_BENCHMARK(BM_SimdDot, int64_t);
+SIMD_BENCHMARK(BM_SimdCount, uint8_t);
+SIMD_BENCHMARK(BM_SimdCount, int32_t);
+SIMD_BENCHMARK(BM_SimdFind, int32_t);
+SIMD_BENCHMARK(BM_SimdFind, double);
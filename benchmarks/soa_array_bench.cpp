@@ -0,0 +1,72 @@
+#include <benchmark/benchmark.h>
+
+#include <nostd/array/array.h>
+#include <nostd/array/soa_array.h>
+#include <nostd/simd/simd.h>
+
+#include <cstddef>
+
+namespace {
+
+// 8 fields, a pass reads one of them
+struct Particle {
+    float x, y, z;
+    float vx, vy, vz;
+    float mass;
+    float charge;
+};
+
+using ParticleSoa = nostd::SoaArray<float, float, float, float, float, float, float, float>;
+
+} // namespace
+
+static void BM_SumFieldAos(benchmark::State& state) {
+    const auto size = static_cast<size_t>(state.range(0));
+    nostd::Array<Particle> particles;
+    for (size_t idx = 0; idx < size; ++idx) {
+        particles.push_back(Particle{0, 0, 0, 0, 0, 0, static_cast<float>(idx % 7), 1});
+    }
+
+    for (auto _ : state) {
+        float sum = 0;
+        for (const auto& particle: particles) {
+            sum += particle.mass;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+
+static void BM_SumFieldSoa(benchmark::State& state) {
+    const auto size = static_cast<size_t>(state.range(0));
+    ParticleSoa particles;
+    for (size_t idx = 0; idx < size; ++idx) {
+        particles.emplace_back(0, 0, 0, 0, 0, 0, static_cast<float>(idx % 7), 1);
+    }
+
+    for (auto _ : state) {
+        float sum = 0;
+        for (float mass: particles.column<6>()) {
+            sum += mass;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+
+static void BM_SumFieldSoaSimd(benchmark::State& state) {
+    const auto size = static_cast<size_t>(state.range(0));
+    ParticleSoa particles;
+    for (size_t idx = 0; idx < size; ++idx) {
+        particles.emplace_back(0, 0, 0, 0, 0, 0, static_cast<float>(idx % 7), 1);
+    }
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(nostd::simd::sum(particles.column<6>()));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+
+BENCHMARK(BM_SumFieldAos)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_SumFieldSoa)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_SumFieldSoaSimd)->Range(1 << 10, 1 << 22);
@@ -0,0 +1,106 @@
+#include <benchmark/benchmark.h>
+
+#include <nostd/array/array.h>
+#include <nostd/sort/sort.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <utility>
+
+namespace {
+
+template <typename T>
+nostd::Array<T> RandomArray(size_t size) {
+    std::mt19937_64 gen(42);
+    nostd::Array<T> array;
+    array.reserve(size);
+    for (size_t idx = 0; idx < size; ++idx) {
+        if constexpr (std::floating_point<T>) {
+            array.push_back(static_cast<T>(std::normal_distribution<double>(0, 1e6)(gen)));
+        } else {
+            array.push_back(static_cast<T>(gen()));
+        }
+    }
+    return array;
+}
+
+} // namespace
+
+// Every iteration sorts a fresh copy, the copy is timed in all of them
+template <typename T>
+static void BM_StdSort(benchmark::State& state) {
+    const auto input = RandomArray<T>(static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        auto array = input;
+        std::sort(array.begin(), array.end());
+        benchmark::DoNotOptimize(array.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T>
+static void BM_RadixSort(benchmark::State& state) {
+    const auto input = RandomArray<T>(static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        auto array = input;
+        nostd::sort(array, 1);
+        benchmark::DoNotOptimize(array.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T>
+static void BM_ParallelSort(benchmark::State& state) {
+    const auto input = RandomArray<T>(static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        auto array = input;
+        nostd::sort(array);
+        benchmark::DoNotOptimize(array.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_StdSortPairs(benchmark::State& state) {
+    const auto keys = RandomArray<uint64_t>(static_cast<size_t>(state.range(0)));
+    nostd::Array<std::pair<uint64_t, uint32_t>> input;
+    for (size_t idx = 0; idx < keys.size(); ++idx) {
+        input.push_back({keys[idx], static_cast<uint32_t>(idx)});
+    }
+
+    for (auto _ : state) {
+        auto array = input;
+        std::stable_sort(array.begin(), array.end(), [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+        benchmark::DoNotOptimize(array.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_SortByKey(benchmark::State& state) {
+    const auto input = RandomArray<uint64_t>(static_cast<size_t>(state.range(0)));
+    nostd::Array<uint32_t> indices(input.size());
+    for (size_t idx = 0; idx < input.size(); ++idx) {
+        indices[idx] = static_cast<uint32_t>(idx);
+    }
+
+    for (auto _ : state) {
+        auto keys = input;
+        auto values = indices;
+        nostd::sort_by_key(keys, values);
+        benchmark::DoNotOptimize(values.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_StdSort<uint64_t>)->Range(1 << 6, 1 << 24);
+BENCHMARK(BM_RadixSort<uint64_t>)->Range(1 << 6, 1 << 24);
+BENCHMARK(BM_ParallelSort<uint64_t>)->Range(1 << 18, 1 << 24);
+BENCHMARK(BM_StdSort<uint32_t>)->Range(1 << 10, 1 << 24);
+BENCHMARK(BM_RadixSort<uint32_t>)->Range(1 << 10, 1 << 24);
+BENCHMARK(BM_StdSort<double>)->Range(1 << 10, 1 << 24);
+BENCHMARK(BM_RadixSort<double>)->Range(1 << 10, 1 << 24);
+BENCHMARK(BM_StdSortPairs)->Range(1 << 10, 1 << 24);
+BENCHMARK(BM_SortByKey)->Range(1 << 10, 1 << 24);
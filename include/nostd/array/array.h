@@ -1,78 +1,135 @@
 #pragma once
 
+#include <algorithm>
+#include <bit>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <ranges>
 #include <stdexcept>
 #include <compare>
 
+#include <nostd/array/growth_policy.h>
 #include <nostd/concepts/concepts.h>
+#include <nostd/simd/simd.h>
 #include <nostd/storage/storage.h>
+#include <nostd/util.h>
 
 namespace nostd {
 
+// Tag for sizing without initialization of elements
+struct uninit_t {
+    explicit uninit_t() = default;
+};
+
+inline constexpr uninit_t uninit{};
+
 // ============================================================================
 
-template <typename T, template<typename StorageT> typename Storage = storage::DynamicStorage>
+template <typename T,
+          template<typename StorageT> typename Storage = storage::DynamicStorage,
+          typename Growth = growth::Doubling>
 struct Array {
+    /*
+     * Plain pointer to the element, models std::contiguous_iterator.
+     * With NOSTD_DEBUG_ITERATORS the owning array is kept as well and
+     * iterators of different arrays throw on comparison.
+     */
     template <bool isConst>
     class ArrayIterator {
     public:
-        using difference_type = int64_t;
+        using difference_type   = std::ptrdiff_t;
         using iterator_category = std::random_access_iterator_tag;
+        using iterator_concept  = std::contiguous_iterator_tag;
+
+        using value_type   = T;
+        using element_type = std::conditional_t<isConst, const T, T>;
+        using pointer      = element_type*;
+        using reference    = element_type&;
+
+        ArrayIterator() noexcept = default;
+
+        template <bool otherConst> requires (isConst && !otherConst)
+        ArrayIterator(const ArrayIterator<otherConst>& other) noexcept // NOLINT
+            : ptr_(other.ptr_)
+#ifdef NOSTD_DEBUG_ITERATORS
+            , array_(other.array_)
+#endif
+        {}
+
+        friend bool operator==(const ArrayIterator& lhs, const ArrayIterator& rhs) {
+            lhs.verify_array(rhs);
+            return lhs.ptr_ == rhs.ptr_;
+        }
+        friend std::strong_ordering operator<=>(const ArrayIterator& lhs, const ArrayIterator& rhs) {
+            lhs.verify_array(rhs);
+            return lhs.ptr_ <=> rhs.ptr_;
+        }
 
-        using value_type = std::conditional_t<isConst, const T, T>;
-        using pointer    = std::conditional_t<isConst, const T*, T*>;
-        using reference  = std::conditional_t<isConst, const T&, T&>;
-
-        bool operator==(const ArrayIterator& other) const {return index_ == other.index_ && array_ == other.array_;}
-        bool operator!=(const ArrayIterator& other) const {return index_ != other.index_ || array_ != other.array_;}
-
-        reference operator*()  const {return (*array_)[index_];}
-        pointer   operator->() const {return array_ + index_;}
+        reference operator*()  const noexcept {return *ptr_;}
+        pointer   operator->() const noexcept {return ptr_;}
+        reference operator[](difference_type diff) const noexcept {return ptr_[diff];}
 
-        ArrayIterator& operator++() noexcept {++index_; return *this;}
+        ArrayIterator& operator++() noexcept {++ptr_; return *this;}
         ArrayIterator operator++(int) noexcept { // NOLINT
             ArrayIterator prev(*this);
             this->operator++();
             return prev;
         }
 
-        ArrayIterator& operator--() noexcept {--index_; return *this;}
+        ArrayIterator& operator--() noexcept {--ptr_; return *this;}
         ArrayIterator operator--(int) noexcept { // NOLINT
             ArrayIterator prev(*this);
             this->operator--();
             return prev;
         }
 
-        ArrayIterator& operator+=(difference_type diff) noexcept {index_ += diff; return *this;}
-        ArrayIterator& operator-=(difference_type diff) noexcept {index_ -= diff; return *this;}
+        ArrayIterator& operator+=(difference_type diff) noexcept {ptr_ += diff; return *this;}
+        ArrayIterator& operator-=(difference_type diff) noexcept {ptr_ -= diff; return *this;}
 
-        ArrayIterator operator+(difference_type diff) const noexcept { return ArrayIterator(index_ + diff, array_); }
-        ArrayIterator operator-(difference_type diff) const noexcept { return ArrayIterator(index_ - diff, array_); }
-
-        difference_type operator-(ArrayIterator& other) const {
-            verify_array(other);
-            return index_ - other.index_;
+        ArrayIterator operator+(difference_type diff) const noexcept {
+            ArrayIterator it(*this);
+            return it += diff;
+        }
+        ArrayIterator operator-(difference_type diff) const noexcept {
+            ArrayIterator it(*this);
+            return it -= diff;
+        }
+        friend ArrayIterator operator+(difference_type diff, const ArrayIterator& it) noexcept {
+            return it + diff;
         }
 
-        bool operator> (const  ArrayIterator& other) const {verify_array(other); return index_ > other.index_;}
-        bool operator< (const  ArrayIterator& other) const {verify_array(other); return index_ < other.index_;}
-        bool operator>=(const  ArrayIterator& other) const {verify_array(other); return index_ >= other.index_;}
-        bool operator<=(const  ArrayIterator& other) const {verify_array(other); return index_ <= other.index_;}
+        friend difference_type operator-(const ArrayIterator& lhs, const ArrayIterator& rhs) {
+            lhs.verify_array(rhs);
+            return lhs.ptr_ - rhs.ptr_;
+        }
 
     private:
         friend Array;
-        ArrayIterator(size_t index, Array* array) : index_(static_cast<int64_t>(index)), array_(array) {}
+        template <bool> friend class ArrayIterator;
+
+        ArrayIterator(pointer ptr, [[maybe_unused]] const Array* array) noexcept
+            : ptr_(ptr)
+#ifdef NOSTD_DEBUG_ITERATORS
+            , array_(array)
+#endif
+        {}
 
-        void verify_array(const ArrayIterator& other) const {
+        void verify_array([[maybe_unused]] const ArrayIterator& other) const {
+#ifdef NOSTD_DEBUG_ITERATORS
             if (array_ != other.array_) {
                 throw std::invalid_argument("array iterators belong to different arrays");
             }
+#endif
         }
 
-        int64_t index_;
-        Array* array_;
+        pointer ptr_{nullptr};
+#ifdef NOSTD_DEBUG_ITERATORS
+        const Array* array_{nullptr};
+#endif
     };
 
     using value_type = T;
@@ -87,15 +144,29 @@ struct Array {
     using const_iterator = ArrayIterator<true>;
     using reverse_iterator = std::reverse_iterator<iterator>;
     using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    using allocator_type = typename storage::allocator_of<Storage<T>>::type;
 
     // Creating
     Array() noexcept;
+    // Growth keeps the allocator, copies take the one chosen by
+    // select_on_container_copy_construction, moves and swaps exchange them
+    explicit Array(const allocator_type& alloc) noexcept requires storage::allocator_aware_storage<Storage<T>>;
 
     // Exception guarantees destruction of created elements
     explicit Array(size_type size);
+    Array(size_type size, const allocator_type& alloc) requires storage::allocator_aware_storage<Storage<T>>;
     Array(size_type size, const value_type& val);
+    Array(size_type size, const value_type& val, const allocator_type& alloc)
+        requires storage::allocator_aware_storage<Storage<T>>;
+    // Elements are left for the caller to overwrite
+    Array(size_type size, uninit_t) requires implicit_lifetime<T>;
+    Array(size_type size, uninit_t, const allocator_type& alloc)
+        requires implicit_lifetime<T> && storage::allocator_aware_storage<Storage<T>>;
     Array(std::initializer_list<value_type> list) requires move_constructible<T>;
     Array(std::initializer_list<value_type> list) requires only_copy_constructible<T>;
+    // Adopts a storage holding size elements already (e.g. a mapped file)
+    Array(Storage<T>&& storage, size_type size) requires implicit_lifetime<T>;
+    explicit Array(Storage<T>&& storage) requires implicit_lifetime<T>;
 
     Array(const Array &other);
     Array &operator=(const Array &other);
@@ -105,6 +176,8 @@ struct Array {
 
     ~Array();
 
+    [[nodiscard]] allocator_type get_allocator() const requires storage::allocator_aware_storage<Storage<T>>;
+
     // Access
     // Nice one
     [[nodiscard]] reference at(size_type idx);
@@ -141,10 +214,14 @@ struct Array {
     void reserve(size_type new_cap);
     [[nodiscard]] size_type capacity() const noexcept;
     void shrink_to_fit();
+    // New elements are left for the caller to overwrite
+    void resize_for_overwrite(size_type new_size) requires implicit_lifetime<T>;
     pointer data() noexcept;
     const_pointer data() const noexcept;
 
     // Modifiers
+    // O(1) when there are no destructors to run
+    void clear() requires trivially_destructible<T>;
     void clear();
     void push_back(const value_type& value);
     void push_back(value_type &&value);
@@ -160,85 +237,168 @@ struct Array {
         }
     }
 
+    // Bulk modifiers: sized sources reallocate at most once.
+    // Source must not refer to elements of this array.
+    template <std::ranges::input_range R>
+    void append_range(R&& range);
+    template <std::ranges::input_range R>
+    void assign_range(R&& range);
+    template <std::input_iterator It>
+    iterator insert(const_iterator pos, It first, It last);
+
 protected:
     Storage<T> storage_;
     size_type size_{};
 
 private:
-    template<typename... Args>
-    void emplace_back_resize(Args &&... args) requires move_constructible<T> {
-        Array new_array;
-        new_array.reserve(calc_new_cap());
-
-        for (size_t idx = 0; idx < size(); ++idx) {
-            new_array.emplace_back(std::move(operator[](idx)));
+    static constexpr bool reallocatable =
+        trivially_relocatable<T> && storage::reallocatable_storage<Storage<T>>;
+    static constexpr bool allocator_aware = storage::allocator_aware_storage<Storage<T>>;
+    static constexpr bool propagate_on_copy = [] {
+        if constexpr (allocator_aware) {
+            return std::allocator_traits<allocator_type>::propagate_on_container_copy_assignment::value;
+        } else {
+            return false;
         }
-        new_array.emplace_back( std::forward<Args>(args)...);
+    }();
 
-        swap(new_array);
+    template<typename... Args>
+    void emplace_back_resize(Args &&... args) {
+        if constexpr (reallocatable) {
+            // args may refer to an element of this array, which moves with the buffer
+            T value(std::forward<Args>(args)...);
+            if (storage_.reallocate(calc_new_cap())) {
+                storage_.construct(size_++, std::move(value));
+            } else {
+                emplace_back_relocate(std::move(value));
+            }
+        } else {
+            emplace_back_relocate(std::forward<Args>(args)...);
+        }
     }
+
     template<typename... Args>
-    void emplace_back_resize(Args &&... args) requires only_copy_constructible<T> {
-        Array new_array;
-        new_array.reserve(calc_new_cap());
+    void emplace_back_relocate(Args &&... args) {
+        const size_type old_size = size();
 
-        for (size_t idx = 0; idx < size(); ++idx) {
-            new_array.emplace_back(operator[](idx));
+        Array new_array = empty_like();
+        new_array.storage_.allocate(calc_new_cap());
+
+        // Constructed first: args may refer to an element of this array
+        new_array.storage_.construct(old_size, std::forward<Args>(args)...);
+        try {
+            relocate_to(new_array);
+        }
+        catch (...) {
+            new_array.storage_.destruct(old_size);
+            throw;
         }
-        new_array.emplace_back( std::forward<Args>(args)...);
+        ++new_array.size_;
 
         swap(new_array);
     }
 
+    // Unallocated storage, or empty array, on the allocator of this one;
+    // for copies the allocator is chosen by select_on_container_copy_construction
+    [[nodiscard]] Storage<T> empty_storage() const;
+    [[nodiscard]] Array empty_like(bool copy = false) const;
+
+    // Fill the unallocated storage, nothing is left on exception
+    void construct_fill(size_type size, const value_type& val);
+    // Allocates size elements for the caller to overwrite
+    void construct_uninit(size_type size) requires implicit_lifetime<T>;
+    void construct_copy(const Array& other);
+
+    // Moves elements to the empty allocated storage of new_array
+    void relocate_to(Array& new_array) requires trivially_relocatable<T>;
+    void relocate_to(Array& new_array) requires move_constructible<T>;
+    void relocate_to(Array& new_array) requires only_copy_constructible<T>;
+
+    // Constructs count elements at idx from first, nothing is left on exception
+    template <typename It>
+    void construct_range(size_type idx, It first, size_type count);
+
     [[nodiscard]] size_type calc_new_cap() const;
     void check_range(size_type idx) const;
-    void resize(size_type new_cap) requires move_constructible<T>;
-    void resize(size_type new_cap) requires only_copy_constructible<T>;
-
-    static constexpr size_type MIN_SIZE{4};
+    void reallocate(size_type new_cap);
+    // Reallocates once to fit new_size elements
+    void grow_to(size_type new_size);
 };
 
 // ========================== Creating ========================================
 // ----------------------------------------------------------------------------
 
-template <typename T, template<typename StorageT> typename Storage>
-Array<T, Storage>::Array() noexcept
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+Array<T, Storage, Growth>::Array() noexcept
     : size_(0) {
 }
 
-template <typename T, template<typename StorageT> typename Storage>
-Array<T, Storage>::Array(size_type size)
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+Array<T, Storage, Growth>::Array(const allocator_type& alloc) noexcept
+    requires storage::allocator_aware_storage<Storage<T>>
+    : storage_(alloc), size_(0) {
+}
+
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+Array<T, Storage, Growth>::Array(size_type size)
     : Array(size, T()) {
 }
 
-template <typename T, template<typename StorageT> typename Storage>
-Array<T, Storage>::Array(size_type size, const value_type& val)
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+Array<T, Storage, Growth>::Array(size_type size, const allocator_type& alloc)
+    requires storage::allocator_aware_storage<Storage<T>>
+    : Array(alloc) {
+    construct_fill(size, T());
+}
+
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+Array<T, Storage, Growth>::Array(size_type size, const value_type& val)
     : Array() {
-    if (size == 0) {
-        return;
-    }
+    construct_fill(size, val);
+}
 
-    storage_.allocate(size);
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+Array<T, Storage, Growth>::Array(size_type size, const value_type& val, const allocator_type& alloc)
+    requires storage::allocator_aware_storage<Storage<T>>
+    : Array(alloc) {
+    construct_fill(size, val);
+}
 
-    size_type idx = 0;
-    try {
-        for (; idx < size; ++idx) {
-            storage_.construct(idx, val);
-        }
-    }
-    catch (...) {
-        while (idx--) {
-            storage_.destruct(idx);
-        }
-        storage_.deallocate();
-        throw;
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+Array<T, Storage, Growth>::Array(size_type size, uninit_t) requires implicit_lifetime<T>
+    : Array() {
+    construct_uninit(size);
+}
+
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+Array<T, Storage, Growth>::Array(size_type size, uninit_t, const allocator_type& alloc)
+    requires implicit_lifetime<T> && storage::allocator_aware_storage<Storage<T>>
+    : Array(alloc) {
+    construct_uninit(size);
+}
+
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+Array<T, Storage, Growth>::Array(Storage<T>&& storage, size_type size) requires implicit_lifetime<T>
+    : Array() {
+    if (size > storage.capacity()) {
+        throw std::length_error("Array: adopted storage holds fewer elements than size");
     }
 
+    if constexpr (storage::sized_swap_storage<Storage<T>>) {
+        storage_.swap(storage, 0, size);
+    } else {
+        storage_.swap(storage);
+    }
     size_ = size;
 }
 
-template <typename T, template<typename StorageT> typename Storage>
-Array<T, Storage>::Array(std::initializer_list<value_type> list) requires move_constructible<T>
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+Array<T, Storage, Growth>::Array(Storage<T>&& storage) requires implicit_lifetime<T>
+    : Array(std::move(storage), storage.capacity()) {
+}
+
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+Array<T, Storage, Growth>::Array(std::initializer_list<value_type> list) requires move_constructible<T>
     : Array() {
     if (list.size() == 0) {
         return;
@@ -264,8 +424,8 @@ Array<T, Storage>::Array(std::initializer_list<value_type> list) requires move_c
     size_ = list.size();
 }
 
-template <typename T, template<typename StorageT> typename Storage>
-Array<T, Storage>::Array(std::initializer_list<value_type> list) requires only_copy_constructible<T>
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+Array<T, Storage, Growth>::Array(std::initializer_list<value_type> list) requires only_copy_constructible<T>
     : Array() {
     if (list.size() == 0) {
         return;
@@ -291,51 +451,49 @@ Array<T, Storage>::Array(std::initializer_list<value_type> list) requires only_c
     size_ = list.size();
 }
 
-template <typename T, template<typename StorageT> typename Storage>
-Array<T, Storage>::Array(const Array& other)
-    : Array() {
-    if (other.empty()) {
-        return;
-    }
-
-    storage_.allocate(other.size());
-
-    size_type idx = 0;
-    try {
-        for (; idx < other.size(); ++idx) {
-            storage_.construct(idx, other[idx]);
-        }
-    }
-    catch (...) {
-        while (idx--) {
-            storage_.destruct(idx);
-        }
-        storage_.deallocate();
-        throw;
-    }
-
-    size_ = other.size();
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+Array<T, Storage, Growth>::Array(const Array& other)
+    : Array(other.empty_like(true)) {
+    construct_copy(other);
 }
 
-template <typename T, template<typename StorageT> typename Storage>
-Array<T, Storage>& Array<T, Storage>::operator=(const Array& other) {
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+Array<T, Storage, Growth>& Array<T, Storage, Growth>::operator=(const Array& other) {
     if (this == &other) {
         return *this;
     }
 
-    Array tmp(other);
+    // The allocator of other replaces this one only if it propagates
+    bool same_allocator = true;
+    if constexpr (propagate_on_copy) {
+        same_allocator = storage_.get_allocator() == other.storage_.get_allocator();
+    }
+
+    if constexpr (trivially_copyable<T>) {
+        // Copying cannot throw, the buffer is reused when it fits
+        if (same_allocator && other.size() <= capacity()) {
+            clear();
+            construct_range(0, other.data(), other.size());
+            size_ = other.size();
+            return *this;
+        }
+    }
+
+    Array tmp = propagate_on_copy ? other.empty_like() : empty_like();
+    tmp.construct_copy(other);
     swap(tmp);
 
     return *this;
 }
 
-template <typename T, template<typename StorageT> typename Storage>
-Array<T, Storage>::Array(Array&& other) noexcept {
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+Array<T, Storage, Growth>::Array(Array&& other) noexcept
+    : storage_(other.empty_storage()) {
     swap(other);
 }
 
-template <typename T, template<typename StorageT> typename Storage>
-Array<T, Storage>& Array<T, Storage>::operator=(Array&& other) noexcept {
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+Array<T, Storage, Growth>& Array<T, Storage, Growth>::operator=(Array&& other) noexcept {
     if (this == &other) {
         return *this;
     }
@@ -344,143 +502,155 @@ Array<T, Storage>& Array<T, Storage>::operator=(Array&& other) noexcept {
     return *this;
 }
 
-template <typename T, template<typename StorageT> typename Storage>
-Array<T, Storage>::~Array() {
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+Array<T, Storage, Growth>::~Array() {
     clear();
     storage_.deallocate();
 }
 
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+typename Array<T, Storage, Growth>::allocator_type Array<T, Storage, Growth>::get_allocator() const
+    requires storage::allocator_aware_storage<Storage<T>> {
+    return storage_.get_allocator();
+}
+
 // ========================== Access =======================================
 // ----------------------------------------------------------------------------
 
-template <typename T, template<typename StorageT> typename Storage>
-typename Array<T, Storage>::reference Array<T, Storage>::at(size_type idx) {
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+typename Array<T, Storage, Growth>::reference Array<T, Storage, Growth>::at(size_type idx) {
     check_range(idx);
     return operator[](idx);
 }
 
-template <typename T, template<typename StorageT> typename Storage>
-typename Array<T, Storage>::const_reference Array<T, Storage>::at(size_type idx) const {
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+typename Array<T, Storage, Growth>::const_reference Array<T, Storage, Growth>::at(size_type idx) const {
     check_range(idx);
     return operator[](idx);
 }
 
-template <typename T, template<typename StorageT> typename Storage>
-typename Array<T, Storage>::const_reference Array<T, Storage>::operator[](size_t idx) const {
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+typename Array<T, Storage, Growth>::const_reference Array<T, Storage, Growth>::operator[](size_t idx) const {
     return storage_[idx];
 }
 
-template <typename T, template<typename StorageT> typename Storage>
-typename Array<T, Storage>::reference Array<T, Storage>::operator[](size_t idx) {
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+typename Array<T, Storage, Growth>::reference Array<T, Storage, Growth>::operator[](size_t idx) {
     return storage_[idx];
 }
 
-template <typename T, template<typename StorageT> typename Storage>
-typename Array<T, Storage>::reference Array<T, Storage>::front() {
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+typename Array<T, Storage, Growth>::reference Array<T, Storage, Growth>::front() {
     return operator[](0);
 }
 
-template <typename T, template<typename StorageT> typename Storage>
-typename Array<T, Storage>::const_reference Array<T, Storage>::front() const {
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+typename Array<T, Storage, Growth>::const_reference Array<T, Storage, Growth>::front() const {
     return operator[](0);
 }
 
-template <typename T, template<typename StorageT> typename Storage>
-typename Array<T, Storage>::reference Array<T, Storage>::back() {
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+typename Array<T, Storage, Growth>::reference Array<T, Storage, Growth>::back() {
     return operator[](size_ - 1);
 }
 
-template <typename T, template<typename StorageT> typename Storage>
-typename Array<T, Storage>::const_reference Array<T, Storage>::back() const {
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+typename Array<T, Storage, Growth>::const_reference Array<T, Storage, Growth>::back() const {
     return operator[](size_ - 1);
 }
 
 // ========================== Iterators =======================================
 // ----------------------------------------------------------------------------
 
-template <typename T, template<typename StorageT> typename Storage>
-typename Array<T, Storage>::iterator Array<T, Storage>::begin() noexcept {
-    return iterator(0, this);
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+typename Array<T, Storage, Growth>::iterator Array<T, Storage, Growth>::begin() noexcept {
+    return iterator(data(), this);
 }
 
-template <typename T, template<typename StorageT> typename Storage>
-typename Array<T, Storage>::const_iterator Array<T, Storage>::begin() const noexcept {
-    return const_iterator(0, this);
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+typename Array<T, Storage, Growth>::const_iterator Array<T, Storage, Growth>::begin() const noexcept {
+    return const_iterator(data(), this);
 }
 
-template <typename T, template<typename StorageT> typename Storage>
-typename Array<T, Storage>::iterator Array<T, Storage>::end() noexcept {
-    return iterator(size_, this);
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+typename Array<T, Storage, Growth>::iterator Array<T, Storage, Growth>::end() noexcept {
+    return iterator(data() + size_, this);
 }
 
-template <typename T, template<typename StorageT> typename Storage>
-typename Array<T, Storage>::const_iterator Array<T, Storage>::end() const noexcept {
-    return const_iterator(size_, this);
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+typename Array<T, Storage, Growth>::const_iterator Array<T, Storage, Growth>::end() const noexcept {
+    return const_iterator(data() + size_, this);
 }
 
-template <typename T, template<typename StorageT> typename Storage>
-typename Array<T, Storage>::reverse_iterator Array<T, Storage>::rbegin() noexcept {
-    return reverse_iterator(size_, this);
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+typename Array<T, Storage, Growth>::reverse_iterator Array<T, Storage, Growth>::rbegin() noexcept {
+    return reverse_iterator(end());
 }
 
-template <typename T, template<typename StorageT> typename Storage>
-typename Array<T, Storage>::const_reverse_iterator Array<T, Storage>::rbegin() const noexcept {
-    return const_reverse_iterator(size_, this);
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+typename Array<T, Storage, Growth>::const_reverse_iterator Array<T, Storage, Growth>::rbegin() const noexcept {
+    return const_reverse_iterator(end());
 }
 
-template <typename T, template<typename StorageT> typename Storage>
-typename Array<T, Storage>::reverse_iterator Array<T, Storage>::rend() noexcept {
-    return reverse_iterator(0, this);
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+typename Array<T, Storage, Growth>::reverse_iterator Array<T, Storage, Growth>::rend() noexcept {
+    return reverse_iterator(begin());
 }
 
-template <typename T, template<typename StorageT> typename Storage>
-typename Array<T, Storage>::const_reverse_iterator Array<T, Storage>::rend() const noexcept {
-    return const_reverse_iterator(0, this);
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+typename Array<T, Storage, Growth>::const_reverse_iterator Array<T, Storage, Growth>::rend() const noexcept {
+    return const_reverse_iterator(begin());
 }
 
 // ========================== Capacity ========================================
 // ----------------------------------------------------------------------------
 
-template <typename T, template<typename StorageT> typename Storage>
-bool Array<T, Storage>::empty() const noexcept {
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+bool Array<T, Storage, Growth>::empty() const noexcept {
     return size() == 0;
 }
 
-template <typename T, template<typename StorageT> typename Storage>
-size_t Array<T, Storage>::size() const noexcept {
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+size_t Array<T, Storage, Growth>::size() const noexcept {
     return size_;
 }
 
-template <typename T, template<typename StorageT> typename Storage>
-void Array<T, Storage>::reserve(size_type new_cap) {
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+void Array<T, Storage, Growth>::reserve(size_type new_cap) {
     if (new_cap <= capacity()) {
         return;
     }
 
-    resize(new_cap);
+    reallocate(new_cap);
 }
 
-template <typename T, template<typename StorageT> typename Storage>
-typename Array<T, Storage>::size_type Array<T, Storage>::capacity() const noexcept {
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+typename Array<T, Storage, Growth>::size_type Array<T, Storage, Growth>::capacity() const noexcept {
     return storage_.capacity();
 }
 
-template <typename T, template<typename StorageT> typename Storage>
-void Array<T, Storage>::shrink_to_fit() {
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+void Array<T, Storage, Growth>::shrink_to_fit() {
     if (size() == capacity()) {
         return;
     }
 
-    resize(size());
+    reallocate(size());
+}
+
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+void Array<T, Storage, Growth>::resize_for_overwrite(size_type new_size) requires implicit_lifetime<T> {
+    grow_to(new_size);
+    size_ = new_size;
 }
 
-template <typename T, template<typename StorageT> typename Storage>
-typename Array<T, Storage>::pointer Array<T, Storage>::data() noexcept {
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+typename Array<T, Storage, Growth>::pointer Array<T, Storage, Growth>::data() noexcept {
     return const_cast<pointer>(const_cast<const Array*>(this)->data());
 }
 
-template <typename T, template<typename StorageT> typename Storage>
-typename Array<T, Storage>::const_pointer Array<T, Storage>::data() const noexcept {
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+typename Array<T, Storage, Growth>::const_pointer Array<T, Storage, Growth>::data() const noexcept {
     if (capacity() == 0) {
         return nullptr;
     }
@@ -491,103 +661,313 @@ typename Array<T, Storage>::const_pointer Array<T, Storage>::data() const noexce
 // ========================== Modifiers =======================================
 // ----------------------------------------------------------------------------
 
-template <typename T, template<typename StorageT> typename Storage>
-void Array<T, Storage>::clear() {
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+void Array<T, Storage, Growth>::clear() requires trivially_destructible<T> {
+    size_ = 0;
+}
+
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+void Array<T, Storage, Growth>::clear() {
     while (!empty()) {
         pop_back();
     }
 }
 
-template <typename T, template<typename StorageT> typename Storage>
-void Array<T, Storage>::push_back(const T& value) {
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+void Array<T, Storage, Growth>::push_back(const T& value) {
     emplace_back(value);
 }
 
-template <typename T, template<typename StorageT> typename Storage>
-void Array<T, Storage>::push_back(T&& value) {
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+void Array<T, Storage, Growth>::push_back(T&& value) {
     emplace_back(std::move(value));
 }
 
-template <typename T, template<typename StorageT> typename Storage>
-void Array<T, Storage>::pop_back() {
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+void Array<T, Storage, Growth>::pop_back() {
     storage_.destruct(--size_);
 }
 
-template <typename T, template<typename StorageT> typename Storage>
-void Array<T, Storage>::swap(Array& other) noexcept {
-    storage_.swap(other.storage_);
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+void Array<T, Storage, Growth>::swap(Array& other) noexcept {
+    if constexpr (storage::sized_swap_storage<Storage<T>>) {
+        storage_.swap(other.storage_, size_, other.size_);
+    } else {
+        storage_.swap(other.storage_);
+    }
     std::swap(size_, other.size_);
 }
 
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+template <std::ranges::input_range R>
+void Array<T, Storage, Growth>::append_range(R&& range) {
+    if constexpr (std::ranges::forward_range<R> || std::ranges::sized_range<R>) {
+        const auto count = static_cast<size_type>(std::ranges::distance(range));
+        grow_to(size() + count);
+
+        construct_range(size(), std::ranges::begin(range), count);
+        size_ += count;
+    } else {
+        for (auto&& value: range) {
+            emplace_back(std::forward<decltype(value)>(value));
+        }
+    }
+}
+
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+template <std::ranges::input_range R>
+void Array<T, Storage, Growth>::assign_range(R&& range) {
+    // Cleared first: growth has nothing to relocate
+    clear();
+    append_range(std::forward<R>(range));
+}
+
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+template <std::input_iterator It>
+typename Array<T, Storage, Growth>::iterator
+Array<T, Storage, Growth>::insert(const_iterator pos, It first, It last) {
+    const auto idx = static_cast<size_type>(pos - const_iterator(begin()));
+    const size_type old_size = size();
+
+    if constexpr (std::forward_iterator<It>) {
+        const auto count = static_cast<size_type>(std::distance(first, last));
+        if (count == 0) {
+            return begin() + idx;
+        }
+        grow_to(old_size + count);
+
+        if constexpr (trivially_relocatable<T>) {
+            T* gap = &storage_[idx];
+            std::memmove(static_cast<void*>(gap + count), static_cast<const void*>(gap),
+                         (old_size - idx) * sizeof(T));
+            try {
+                construct_range(idx, first, count);
+            }
+            catch (...) {
+                std::memmove(static_cast<void*>(gap), static_cast<const void*>(gap + count),
+                             (old_size - idx) * sizeof(T));
+                throw;
+            }
+            size_ += count;
+            return begin() + idx;
+        }
+
+        construct_range(old_size, first, count);
+        size_ += count;
+    } else {
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+    }
+
+    std::rotate(begin() + idx, begin() + old_size, end());
+    return begin() + idx;
+}
+
 // ----------------------------------------------------------------------------
 
-template <typename T, template<typename StorageT> typename Storage>
-typename Array<T, Storage>::size_type Array<T, Storage>::calc_new_cap() const {
-    return size_ == 0 ? MIN_SIZE : size_ * 2;
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+template <typename It>
+void Array<T, Storage, Growth>::construct_range(size_type idx, It first, size_type count) {
+    if constexpr (std::contiguous_iterator<It> && trivially_copyable<T> &&
+                  std::is_same_v<std::iter_value_t<It>, T>) {
+        if (count != 0) {
+            std::memcpy(static_cast<void*>(&storage_[idx]),
+                        static_cast<const void*>(std::to_address(first)),
+                        count * sizeof(T));
+        }
+    } else {
+        size_type done = 0;
+        try {
+            for (; done < count; ++done, ++first) {
+                storage_.construct(idx + done, *first);
+            }
+        }
+        catch (...) {
+            while (done--) {
+                storage_.destruct(idx + done);
+            }
+            throw;
+        }
+    }
+}
+
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+typename Array<T, Storage, Growth>::size_type Array<T, Storage, Growth>::calc_new_cap() const {
+    return Growth::next_capacity(capacity(), sizeof(T));
 }
 
-template <typename T, template<typename StorageT> typename Storage>
-void Array<T, Storage>::check_range(size_type idx) const {
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+void Array<T, Storage, Growth>::check_range(size_type idx) const {
     if (idx >= size()) {
         throw std::out_of_range("Array::check_range failed");
     }
 }
 
-template <typename T, template<typename StorageT> typename Storage>
-void Array<T, Storage>::resize(size_type new_cap) requires move_constructible<T> {
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+void Array<T, Storage, Growth>::reallocate(size_type new_cap) {
     if (new_cap < size()) {
         return;
     }
 
-    Array new_array;
+    if constexpr (reallocatable) {
+        if (storage_.reallocate(new_cap)) {
+            return;
+        }
+    }
+
+    Array new_array = empty_like();
     new_array.storage_.allocate(new_cap);
 
-    for (size_type idx = 0; idx < size(); ++idx) {
-        new_array.emplace_back(std::move(operator[](idx)));
-    }
+    relocate_to(new_array);
 
     swap(new_array);
 }
 
-template <typename T, template<typename StorageT> typename Storage>
-void Array<T, Storage>::resize(size_type new_cap) requires only_copy_constructible<T> {
-    if (new_cap < size()) {
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+void Array<T, Storage, Growth>::grow_to(size_type new_size) {
+    if (new_size <= capacity()) {
         return;
     }
 
-    Array new_array;
-    new_array.storage_.allocate(new_cap);
+    size_type new_cap = capacity();
+    while (new_cap < new_size) {
+        new_cap = Growth::next_capacity(new_cap, sizeof(T));
+    }
 
+    reallocate(new_cap);
+}
+
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+Storage<T> Array<T, Storage, Growth>::empty_storage() const {
+    if constexpr (allocator_aware) {
+        return Storage<T>(storage_.get_allocator());
+    } else {
+        return Storage<T>();
+    }
+}
+
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+Array<T, Storage, Growth> Array<T, Storage, Growth>::empty_like(bool copy) const {
+    if constexpr (allocator_aware) {
+        using traits_t = std::allocator_traits<allocator_type>;
+        return Array(copy ? traits_t::select_on_container_copy_construction(storage_.get_allocator())
+                          : storage_.get_allocator());
+    } else {
+        return Array();
+    }
+}
+
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+void Array<T, Storage, Growth>::construct_fill(size_type size, const value_type& val) {
+    if (size == 0) {
+        return;
+    }
+
+    storage_.allocate(size);
+
+    size_type idx = 0;
+    try {
+        for (; idx < size; ++idx) {
+            storage_.construct(idx, val);
+        }
+    }
+    catch (...) {
+        while (idx--) {
+            storage_.destruct(idx);
+        }
+        storage_.deallocate();
+        throw;
+    }
+
+    size_ = size;
+}
+
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+void Array<T, Storage, Growth>::construct_uninit(size_type size) requires implicit_lifetime<T> {
+    if (size == 0) {
+        return;
+    }
+
+    storage_.allocate(size);
+    size_ = size;
+}
+
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+void Array<T, Storage, Growth>::construct_copy(const Array& other) {
+    if (other.empty()) {
+        return;
+    }
+
+    storage_.allocate(other.size());
+
+    // Trivially copyable elements are copied with a single memcpy
+    try {
+        construct_range(0, other.data(), other.size());
+    }
+    catch (...) {
+        storage_.deallocate();
+        throw;
+    }
+
+    size_ = other.size();
+}
+
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+void Array<T, Storage, Growth>::relocate_to(Array& new_array) requires trivially_relocatable<T> {
+    if (!empty()) {
+        std::memcpy(static_cast<void*>(&new_array.storage_[0]),
+                    static_cast<const void*>(&storage_[0]),
+                    size() * sizeof(T));
+    }
+
+    new_array.size_ = size();
+    // Elements now live in new_array, old copies must not be destroyed
+    size_ = 0;
+}
+
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+void Array<T, Storage, Growth>::relocate_to(Array& new_array) requires move_constructible<T> {
     for (size_type idx = 0; idx < size(); ++idx) {
-        new_array.emplace_back(operator[](idx));
+        new_array.storage_.construct(idx, std::move(operator[](idx)));
+        ++new_array.size_;
     }
+}
 
-    swap(new_array);
+template <typename T, template<typename StorageT> typename Storage, typename Growth>
+void Array<T, Storage, Growth>::relocate_to(Array& new_array) requires only_copy_constructible<T> {
+    for (size_type idx = 0; idx < size(); ++idx) {
+        new_array.storage_.construct(idx, operator[](idx));
+        ++new_array.size_;
+    }
 }
 
 // ============================================================================
 // ============================================================================
 // ============================================================================
 
-template <template <typename StorageType> typename Storage>
-struct Array<bool, Storage> {
+template <template <typename StorageType> typename Storage, typename Growth>
+struct Array<bool, Storage, Growth> {
+    using word_type = uint64_t;
+    static constexpr size_t WORD_BITS = 64;
+
 private:
     struct Reference {
-        Reference(uint8_t* chunk, uint8_t offset)
-            : chunk_(chunk), offset_(offset) {
+        Reference(word_type* word, uint8_t offset)
+            : word_(word), offset_(offset) {
         }
 
         operator bool() const { // NOLINT
-            return (*chunk_) & (1 << offset_);
+            return (*word_ >> offset_) & 1;
         }
 
         Reference(const Reference& other) {
-            chunk_ = other.chunk_;
+            word_ = other.word_;
             offset_ = other.offset_;
         }
 
         Reference(Reference&& other) noexcept {
-            chunk_ = other.chunk_;
+            word_ = other.word_;
             offset_ = other.offset_;
         }
 
@@ -603,7 +983,7 @@ private:
         }
 
         friend std::strong_ordering operator<=>(const Reference& lhs, const Reference& rhs) {
-            if (auto cmp = lhs.chunk_ <=> rhs.chunk_; cmp != 0) {
+            if (auto cmp = lhs.word_ <=> rhs.word_; cmp != 0) {
                 return cmp;
             }
             return lhs.offset_ <=> rhs.offset_;
@@ -611,15 +991,15 @@ private:
 
         Reference& operator=(bool other) {
             if (other) {
-                *chunk_ = (*chunk_) | (1 << offset_);
+                *word_ |= word_type{1} << offset_;
             } else {
-                *chunk_ = (*chunk_) & (~(1 << offset_));
+                *word_ &= ~(word_type{1} << offset_);
             }
 
             return *this;
         }
 
-        uint8_t* chunk_;
+        word_type* word_;
         uint8_t offset_;
     };
 
@@ -634,20 +1014,20 @@ public:
         using reference  = std::conditional_t<isConst, const Reference, Reference>;
 
         bool operator==(const ArrayIterator& other) const {
-            return ref_.chunk_ == other.ref_.chunk_ && ref_.offset_ == other.ref_.offset_;
+            return ref_.word_ == other.ref_.word_ && ref_.offset_ == other.ref_.offset_;
         }
         bool operator!=(const ArrayIterator& other) const {
-            return ref_.chunk_ != other.ref_.chunk_ || ref_.offset_ != other.ref_.offset_;
+            return ref_.word_ != other.ref_.word_ || ref_.offset_ != other.ref_.offset_;
         }
 
         reference operator*() const {return ref_;}
 
         ArrayIterator& operator++() noexcept {
-            if (ref_.offset_ != 7) {
+            if (ref_.offset_ != WORD_BITS - 1) {
                 ref_.offset_++;
             } else {
                 ref_.offset_ = 0;
-                ref_.chunk_++;
+                ref_.word_++;
             }
 
             return *this;
@@ -662,8 +1042,8 @@ public:
             if (ref_.offset_ != 0) {
                 ref_.offset_--;
             } else {
-                ref_.offset_ = 7;
-                ref_.chunk_--;
+                ref_.offset_ = WORD_BITS - 1;
+                ref_.word_--;
             }
 
             return *this;
@@ -675,27 +1055,21 @@ public:
         }
 
         ArrayIterator& operator+=(difference_type diff) noexcept {
-            ref_.offset_ += diff;
-
-            ref_.chunk_ += (ref_.offset_ / 8);
-            ref_.offset_ %= 8;
+            constexpr auto bits = static_cast<difference_type>(WORD_BITS);
+            // Floor division, diff may be negative
+            difference_type words = (ref_.offset_ + diff) / bits;
+            difference_type offset = (ref_.offset_ + diff) % bits;
+            if (offset < 0) {
+                offset += bits;
+                --words;
+            }
 
+            ref_.word_ += words;
+            ref_.offset_ = static_cast<uint8_t>(offset);
             return *this;
         }
         ArrayIterator& operator-=(difference_type diff) noexcept {
-            auto offset_diff = diff % 8;
-            auto chunk_diff =  diff / 8;
-
-            if (ref_.offset_ < offset_diff) {
-                ref_.offset_ -= offset_diff - 8;
-                ref_.chunk_  -= chunk_diff + 1;
-            } else {
-                ref_.offset_ -= offset_diff;
-                ref_.chunk_  -=   chunk_diff;
-            }
-
-
-            return *this;
+            return *this += -diff;
         }
 
         ArrayIterator operator+(difference_type diff) const noexcept {
@@ -709,12 +1083,9 @@ public:
             return it;
         }
 
-        difference_type operator-(ArrayIterator& other) const {
-            difference_type chunk_diff = ref_.chunk_ - other.ref_.chunk_;
-            if (ref_.offset_ < other.ref_.offset_) {
-                return ((ref_.offset_ + 8) - other.ref_.offset_) + 8 * (chunk_diff - 1);
-            }
-            return (ref_.offset_ - other.ref_.offset_) + 8 * (chunk_diff);
+        difference_type operator-(const ArrayIterator& other) const {
+            const difference_type word_diff = ref_.word_ - other.ref_.word_;
+            return word_diff * static_cast<difference_type>(WORD_BITS) + ref_.offset_ - other.ref_.offset_;
         }
 
         friend std::strong_ordering operator<=>(const ArrayIterator& lhs, const ArrayIterator& rhs) {
@@ -738,9 +1109,12 @@ public:
     using const_iterator = ArrayIterator<true>;
     using reverse_iterator = std::reverse_iterator<iterator>;
     using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    using allocator_type = typename storage::allocator_of<Storage<word_type>>::type;
 
     // Creating
     Array() noexcept = default;
+    // Allocators are passed on like in the generic Array
+    explicit Array(const allocator_type& alloc) noexcept requires storage::allocator_aware_storage<Storage<word_type>>;
 
     // Exception guarantees destruction of created elements
     explicit Array(size_type size);
@@ -755,6 +1129,8 @@ public:
 
     ~Array();
 
+    [[nodiscard]] allocator_type get_allocator() const requires storage::allocator_aware_storage<Storage<word_type>>;
+
     // Access
     // Nice one
     [[nodiscard]] reference at(size_type idx);
@@ -791,6 +1167,26 @@ public:
     void reserve(size_type new_cap);
     [[nodiscard]] size_type capacity() const noexcept;
     void shrink_to_fit();
+    // Packed words: bit idx is bit (idx % 64) of word idx / 64, bits past size() are zero
+    word_type* data() noexcept;
+    const word_type* data() const noexcept;
+
+    // Bit queries, word at a time
+    [[nodiscard]] size_type count() const noexcept;
+    [[nodiscard]] bool any() const noexcept;
+    [[nodiscard]] bool all() const noexcept;
+    [[nodiscard]] bool none() const noexcept;
+    // Index of the first set bit, or size() if there is none
+    [[nodiscard]] size_type find_first() const noexcept;
+    // Index of the first set bit after idx, or size()
+    [[nodiscard]] size_type find_next(size_type idx) const noexcept;
+
+    // Set bits, visited in increasing order at a cost of the popcount plus the zero words skipped
+    class SetBits;
+    [[nodiscard]] SetBits set_bits() const noexcept;
+    // Calls fn(idx) for every set bit
+    template <typename F>
+    void for_each_set_bit(F&& fn) const;
 
     // Modifiers
     void clear();
@@ -798,105 +1194,197 @@ public:
     void pop_back();
     void swap(Array& other) noexcept;
 
+    // Bulk modifiers, whole words at a time
+    // Bits past the old size are set to value
+    void resize(size_type new_size, value_type value = false);
+    // Sets the bits in [first, last), UNSAFE: last <= size()
+    void fill(size_type first, size_type last, value_type value);
+    // Appends the low nbits of bits, lowest first, nbits <= WORD_BITS
+    void append_bits(word_type bits, size_type nbits);
+
     void emplace_back(value_type value) {
         if (size() == capacity()) {
             emplace_back_resize(value);
         } else {
-            operator[](size_++) = value;
+            append_bit(value);
         }
     }
 
+    // Bitwise operations of arrays of the same size, std::invalid_argument otherwise
+    Array& operator&=(const Array& other);
+    Array& operator|=(const Array& other);
+    Array& operator^=(const Array& other);
+    [[nodiscard]] Array operator~() const;
+
+    friend Array operator&(Array lhs, const Array& rhs) {
+        return lhs &= rhs;
+    }
+    friend Array operator|(Array lhs, const Array& rhs) {
+        return lhs |= rhs;
+    }
+    friend Array operator^(Array lhs, const Array& rhs) {
+        return lhs ^= rhs;
+    }
+
+    // Forward range of the indices of set bits, invalidated by modifications
+    class SetBits {
+    public:
+        class Iterator {
+        public:
+            using difference_type = std::ptrdiff_t;
+            using value_type = size_type;
+            using iterator_category = std::forward_iterator_tag;
+
+            Iterator() noexcept = default;
+
+            value_type operator*() const noexcept {
+                return word_ * WORD_BITS + std::countr_zero(bits_);
+            }
+
+            Iterator& operator++() noexcept {
+                // Clears the lowest set bit, moves on to the next nonzero word once none is left
+                bits_ &= bits_ - 1;
+                if (bits_ == 0) {
+                    ++word_;
+                    word_ += simd::bit_kernels().find_nonzero(words_ + word_, word_count_ - word_);
+                    bits_ = word_ == word_count_ ? 0 : words_[word_];
+                }
+                return *this;
+            }
+            Iterator operator++(int) noexcept {
+                Iterator prev(*this);
+                ++*this;
+                return prev;
+            }
+
+            bool operator==(const Iterator& other) const noexcept {
+                return word_ == other.word_ && bits_ == other.bits_;
+            }
+
+        private:
+            friend SetBits;
+            Iterator(const word_type* words, size_type word, size_type word_count) noexcept
+                : words_(words), word_(word), word_count_(word_count),
+                  bits_(word == word_count ? 0 : words[word]) {
+            }
+
+            const word_type* words_ = nullptr;
+            size_type word_ = 0;
+            size_type word_count_ = 0;
+            word_type bits_ = 0;  // the rest of the current word
+        };
+
+        using iterator = Iterator;
+        using const_iterator = Iterator;
+
+        Iterator begin() const noexcept {
+            return Iterator(words_, simd::bit_kernels().find_nonzero(words_, word_count_), word_count_);
+        }
+        Iterator end() const noexcept {
+            return Iterator(words_, word_count_, word_count_);
+        }
+
+    private:
+        friend Array;
+        SetBits(const word_type* words, size_type word_count) noexcept
+            : words_(words), word_count_(word_count) {
+        }
+
+        const word_type* words_;
+        size_type word_count_;
+    };
+
 protected:
-    Storage<uint8_t> storage_;
+    Storage<word_type> storage_;
     size_type size_{}; // count of bits
 
 private:
+    static constexpr bool allocator_aware = storage::allocator_aware_storage<Storage<word_type>>;
+    static constexpr bool propagate_on_copy = [] {
+        if constexpr (allocator_aware) {
+            return std::allocator_traits<allocator_type>::propagate_on_container_copy_assignment::value;
+        } else {
+            return false;
+        }
+    }();
+
+    [[nodiscard]] Storage<word_type> empty_storage() const;
+    [[nodiscard]] Array empty_like(bool copy = false) const;
+    void construct_copy(const Array& other);
+
     void emplace_back_resize(value_type value);
+    // The word of the bit is written whole when the bit starts it, that keeps the tail zero
+    void append_bit(value_type value);
+
+    // Binary word operations keep zero tails, ~ clears the tail after
+    void check_same_size(const Array& other) const;
+    void clear_tail() noexcept;
 
     [[nodiscard]] size_type calc_new_cap() const;
-    [[nodiscard]] size_type real_size() const;
+    // Words holding size() bits
+    [[nodiscard]] size_type word_count() const;
 
     void check_range(size_type idx) const;
-    void resize(size_type new_cap);
-
-    static constexpr size_type MIN_SIZE{4};
+    void reallocate(size_type new_cap);
+    // Reallocates once to fit new_size bits
+    void grow_to(size_type new_size);
 };
 
 // ========================== Creating ========================================
 // ----------------------------------------------------------------------------
 
-template <template<typename StorageT> typename Storage>
-Array<bool, Storage>::Array(size_type size)
-    : Array(size, false) {
+template <template <typename StorageT> typename Storage, typename Growth>
+Array<bool, Storage, Growth>::Array(const allocator_type& alloc) noexcept
+    requires storage::allocator_aware_storage<Storage<word_type>>
+    : storage_(alloc) {
 }
 
-template <template<typename StorageT> typename Storage>
-Array<bool, Storage>::Array(size_type size, value_type val)
-    : size_(size) {
-    if (size == 0) {
-        return;
-    }
-
-    storage_.allocate(real_size());
-
-    size_type idx = 0;
-    for (; idx < size; ++idx) {
-        operator[](idx) = val;
-    }
+template <template <typename StorageT> typename Storage, typename Growth>
+Array<bool, Storage, Growth>::Array(size_type size)
+    : Array(size, false) {
 }
 
-template <template<typename StorageT> typename Storage>
-Array<bool, Storage>::Array(std::initializer_list<value_type> list)
-    : size_(list.size()) {
-    if (list.size() == 0) {
-        return;
-    }
-
-    storage_.allocate(real_size());
-
-    size_type idx = 0;
-    auto it = list.begin();
-    for (; idx < list.size(); ++idx, ++it) {
-        operator[](idx) = *it;
-    }
+template <template <typename StorageT> typename Storage, typename Growth>
+Array<bool, Storage, Growth>::Array(size_type size, value_type val) {
+    reserve(size);
+    resize(size, val);
 }
 
-template <template <typename StorageT> typename Storage>
-Array<bool, Storage>::Array(const Array& other)
-    : size_(other.size()) {
-    if (other.empty()) {
-        return;
-    }
-
-    storage_.allocate(real_size());
-
-    size_type idx = 0;
-    for (; idx < other.size(); ++idx) {
-        storage_.construct(idx, other[idx]);
+template <template <typename StorageT> typename Storage, typename Growth>
+Array<bool, Storage, Growth>::Array(std::initializer_list<value_type> list) {
+    reserve(list.size());
+    for (value_type val: list) {
+        append_bit(val);
     }
+}
 
-    size_ = other.size();
+template <template <typename StorageT> typename Storage, typename Growth>
+Array<bool, Storage, Growth>::Array(const Array& other)
+    : Array(other.empty_like(true)) {
+    construct_copy(other);
 }
 
-template <template <typename StorageT> typename Storage>
-Array<bool, Storage>& Array<bool, Storage>::operator=(const Array& other) {
+template <template <typename StorageT> typename Storage, typename Growth>
+Array<bool, Storage, Growth>& Array<bool, Storage, Growth>::operator=(const Array& other) {
     if (this == &other) {
         return *this;
     }
 
-    Array tmp(other);
+    Array tmp = propagate_on_copy ? other.empty_like() : empty_like();
+    tmp.construct_copy(other);
     swap(tmp);
 
     return *this;
 }
 
-template <template<typename StorageT> typename Storage>
-Array<bool, Storage>::Array(Array&& other) noexcept {
+template <template <typename StorageT> typename Storage, typename Growth>
+Array<bool, Storage, Growth>::Array(Array&& other) noexcept
+    : storage_(other.empty_storage()) {
     swap(other);
 }
 
-template <template<typename StorageT> typename Storage>
-Array<bool, Storage>& Array<bool, Storage>::operator=(Array&& other) noexcept {
+template <template <typename StorageT> typename Storage, typename Growth>
+Array<bool, Storage, Growth>& Array<bool, Storage, Growth>::operator=(Array&& other) noexcept {
     if (this == &other) {
         return *this;
     }
@@ -905,58 +1393,64 @@ Array<bool, Storage>& Array<bool, Storage>::operator=(Array&& other) noexcept {
     return *this;
 }
 
-template <template<typename StorageT> typename Storage>
-Array<bool, Storage>::~Array() {
+template <template <typename StorageT> typename Storage, typename Growth>
+Array<bool, Storage, Growth>::~Array() {
     clear();
     storage_.deallocate();
 }
 
+template <template <typename StorageT> typename Storage, typename Growth>
+typename Array<bool, Storage, Growth>::allocator_type Array<bool, Storage, Growth>::get_allocator() const
+    requires storage::allocator_aware_storage<Storage<word_type>> {
+    return storage_.get_allocator();
+}
+
 // ========================== Access =======================================
 // ----------------------------------------------------------------------------
 
-template <template <typename StorageT> typename Storage>
-typename Array<bool, Storage>::reference
-Array<bool, Storage>::at(size_type idx) {
+template <template <typename StorageT> typename Storage, typename Growth>
+typename Array<bool, Storage, Growth>::reference
+Array<bool, Storage, Growth>::at(size_type idx) {
     check_range(idx);
     return operator[](idx);
 }
 
-template <template<typename StorageT> typename Storage>
-typename Array<bool, Storage>::const_reference
-Array<bool, Storage>::at(size_type idx) const {
+template <template <typename StorageT> typename Storage, typename Growth>
+typename Array<bool, Storage, Growth>::const_reference
+Array<bool, Storage, Growth>::at(size_type idx) const {
     check_range(idx);
     return operator[](idx);
 }
 
-template <template <typename StorageType> typename Storage>
-typename Array<bool, Storage>::const_reference
-Array<bool, Storage>::operator[](size_t idx) const {
-    return storage_[idx >> 3] & (1 << (idx & 7));
+template <template <typename StorageType> typename Storage, typename Growth>
+typename Array<bool, Storage, Growth>::const_reference
+Array<bool, Storage, Growth>::operator[](size_t idx) const {
+    return (storage_[idx / WORD_BITS] >> (idx % WORD_BITS)) & 1;
 }
 
-template <template <typename StorageType> typename Storage>
-typename Array<bool, Storage>::reference
-Array<bool, Storage>::operator[](size_t idx) {
-    return Reference(&storage_[idx >> 3], (idx & 7));
+template <template <typename StorageType> typename Storage, typename Growth>
+typename Array<bool, Storage, Growth>::reference
+Array<bool, Storage, Growth>::operator[](size_t idx) {
+    return Reference(&storage_[idx / WORD_BITS], idx % WORD_BITS);
 }
 
-template <template <typename StorageT> typename Storage>
-typename Array<bool, Storage>::reference Array<bool, Storage>::front() {
+template <template <typename StorageT> typename Storage, typename Growth>
+typename Array<bool, Storage, Growth>::reference Array<bool, Storage, Growth>::front() {
     return operator[](0);
 }
 
-template <template <typename StorageT> typename Storage>
-typename Array<bool, Storage>::const_reference Array<bool, Storage>::front() const {
+template <template <typename StorageT> typename Storage, typename Growth>
+typename Array<bool, Storage, Growth>::const_reference Array<bool, Storage, Growth>::front() const {
     return operator[](0);
 }
 
-template <template <typename StorageT> typename Storage>
-typename Array<bool, Storage>::reference Array<bool, Storage>::back() {
+template <template <typename StorageT> typename Storage, typename Growth>
+typename Array<bool, Storage, Growth>::reference Array<bool, Storage, Growth>::back() {
     return operator[](size() - 1);
 }
 
-template <template <typename StorageT> typename Storage>
-typename Array<bool, Storage>::const_reference Array<bool, Storage>::back() const {
+template <template <typename StorageT> typename Storage, typename Growth>
+typename Array<bool, Storage, Growth>::const_reference Array<bool, Storage, Growth>::back() const {
     return operator[](size() - 1);
 }
 
@@ -964,158 +1458,411 @@ typename Array<bool, Storage>::const_reference Array<bool, Storage>::back() cons
 // ----------------------------------------------------------------------------
 
 
-template <template <typename StorageT> typename Storage>
-typename Array<bool, Storage>::iterator Array<bool, Storage>::begin() noexcept {
+template <template <typename StorageT> typename Storage, typename Growth>
+typename Array<bool, Storage, Growth>::iterator Array<bool, Storage, Growth>::begin() noexcept {
     return iterator(0, this);
 }
 
-template <template <typename StorageT> typename Storage>
-typename Array<bool, Storage>::const_iterator Array<bool, Storage>::begin() const noexcept {
-    return const_iterator(0, this);
+template <template <typename StorageT> typename Storage, typename Growth>
+typename Array<bool, Storage, Growth>::const_iterator Array<bool, Storage, Growth>::begin() const noexcept {
+    // const Reference does not write through the word pointer
+    return const_iterator(0, const_cast<Array*>(this));
 }
 
-template <template <typename StorageT> typename Storage>
-typename Array<bool, Storage>::iterator Array<bool, Storage>::end() noexcept {
+template <template <typename StorageT> typename Storage, typename Growth>
+typename Array<bool, Storage, Growth>::iterator Array<bool, Storage, Growth>::end() noexcept {
     return iterator(size_, this);
 }
 
-template <template <typename StorageT> typename Storage>
-typename Array<bool, Storage>::const_iterator Array<bool, Storage>::end() const noexcept {
-    return const_iterator(size_, this);
+template <template <typename StorageT> typename Storage, typename Growth>
+typename Array<bool, Storage, Growth>::const_iterator Array<bool, Storage, Growth>::end() const noexcept {
+    // const Reference does not write through the word pointer
+    return const_iterator(size_, const_cast<Array*>(this));
 }
 
-template <template<typename StorageT> typename Storage>
-typename Array<bool, Storage>::reverse_iterator Array<bool, Storage>::rbegin() noexcept {
-    return reverse_iterator(size_, this);
+template <template <typename StorageT> typename Storage, typename Growth>
+typename Array<bool, Storage, Growth>::reverse_iterator Array<bool, Storage, Growth>::rbegin() noexcept {
+    return reverse_iterator(end());
 }
 
-template <template<typename StorageT> typename Storage>
-typename Array<bool, Storage>::const_reverse_iterator Array<bool, Storage>::rbegin() const noexcept {
-    return const_reverse_iterator(size_, this);
+template <template <typename StorageT> typename Storage, typename Growth>
+typename Array<bool, Storage, Growth>::const_reverse_iterator Array<bool, Storage, Growth>::rbegin() const noexcept {
+    return const_reverse_iterator(end());
 }
 
-template <template<typename StorageT> typename Storage>
-typename Array<bool, Storage>::reverse_iterator Array<bool, Storage>::rend() noexcept {
-    return reverse_iterator(0, this);
+template <template <typename StorageT> typename Storage, typename Growth>
+typename Array<bool, Storage, Growth>::reverse_iterator Array<bool, Storage, Growth>::rend() noexcept {
+    return reverse_iterator(begin());
 }
 
-template <template<typename StorageT> typename Storage>
-typename Array<bool, Storage>::const_reverse_iterator Array<bool, Storage>::rend() const noexcept {
-    return const_reverse_iterator(0, this);
+template <template <typename StorageT> typename Storage, typename Growth>
+typename Array<bool, Storage, Growth>::const_reverse_iterator Array<bool, Storage, Growth>::rend() const noexcept {
+    return const_reverse_iterator(begin());
 }
 
 // ========================== Capacity ========================================
 // ----------------------------------------------------------------------------
 
-template <template<typename StorageT> typename Storage>
-bool Array<bool, Storage>::empty() const noexcept {
+template <template <typename StorageT> typename Storage, typename Growth>
+bool Array<bool, Storage, Growth>::empty() const noexcept {
     return size() == 0;
 }
 
-template <template<typename StorageT> typename Storage>
-size_t Array<bool, Storage>::size() const noexcept {
+template <template <typename StorageT> typename Storage, typename Growth>
+size_t Array<bool, Storage, Growth>::size() const noexcept {
     return size_;
 }
 
-template <template<typename StorageT> typename Storage>
-void Array<bool, Storage>::reserve(size_type new_cap) {
+template <template <typename StorageT> typename Storage, typename Growth>
+void Array<bool, Storage, Growth>::reserve(size_type new_cap) {
     if (new_cap <= capacity()) {
         return;
     }
 
-    resize(new_cap);
+    reallocate(new_cap);
 }
 
-template <template<typename StorageT> typename Storage>
-typename Array<bool, Storage>::size_type Array<bool, Storage>::capacity() const noexcept {
-    return storage_.capacity() * 8;
+template <template <typename StorageT> typename Storage, typename Growth>
+typename Array<bool, Storage, Growth>::size_type Array<bool, Storage, Growth>::capacity() const noexcept {
+    return storage_.capacity() * WORD_BITS;
 }
 
-template <template<typename StorageT> typename Storage>
-void Array<bool, Storage>::shrink_to_fit() {
+template <template <typename StorageT> typename Storage, typename Growth>
+void Array<bool, Storage, Growth>::shrink_to_fit() {
     if (size() == capacity()) {
         return;
     }
 
-    resize(size());
+    reallocate(size());
+}
+
+template <template <typename StorageT> typename Storage, typename Growth>
+typename Array<bool, Storage, Growth>::word_type* Array<bool, Storage, Growth>::data() noexcept {
+    return const_cast<word_type*>(const_cast<const Array*>(this)->data());
+}
+
+template <template <typename StorageT> typename Storage, typename Growth>
+const typename Array<bool, Storage, Growth>::word_type* Array<bool, Storage, Growth>::data() const noexcept {
+    if (storage_.capacity() == 0) {
+        return nullptr;
+    }
+
+    return &storage_[0];
+}
+
+template <template <typename StorageT> typename Storage, typename Growth>
+typename Array<bool, Storage, Growth>::size_type Array<bool, Storage, Growth>::count() const noexcept {
+    return simd::bit_kernels().popcount(data(), word_count());
+}
+
+template <template <typename StorageT> typename Storage, typename Growth>
+bool Array<bool, Storage, Growth>::any() const noexcept {
+    return simd::bit_kernels().find_nonzero(data(), word_count()) != word_count();
+}
+
+template <template <typename StorageT> typename Storage, typename Growth>
+bool Array<bool, Storage, Growth>::all() const noexcept {
+    return count() == size();
+}
+
+template <template <typename StorageT> typename Storage, typename Growth>
+bool Array<bool, Storage, Growth>::none() const noexcept {
+    return !any();
+}
+
+template <template <typename StorageT> typename Storage, typename Growth>
+typename Array<bool, Storage, Growth>::size_type Array<bool, Storage, Growth>::find_first() const noexcept {
+    const size_type words = word_count();
+    const size_type word = simd::bit_kernels().find_nonzero(data(), words);
+    if (word == words) {
+        return size();
+    }
+    return word * WORD_BITS + std::countr_zero(storage_[word]);
+}
+
+template <template <typename StorageT> typename Storage, typename Growth>
+typename Array<bool, Storage, Growth>::size_type Array<bool, Storage, Growth>::find_next(size_type idx) const noexcept {
+    if (idx + 1 >= size()) {
+        return size();
+    }
+
+    // The rest of the word of idx first, then whole words
+    const size_type next = idx + 1;
+    const word_type rest = storage_[next / WORD_BITS] & (~word_type{0} << (next % WORD_BITS));
+    if (rest != 0) {
+        return next / WORD_BITS * WORD_BITS + std::countr_zero(rest);
+    }
+
+    const size_type words = word_count();
+    const size_type from = next / WORD_BITS + 1;
+    const size_type word = from + simd::bit_kernels().find_nonzero(data() + from, words - from);
+    if (word == words) {
+        return size();
+    }
+    return word * WORD_BITS + std::countr_zero(storage_[word]);
+}
+
+template <template <typename StorageT> typename Storage, typename Growth>
+typename Array<bool, Storage, Growth>::SetBits Array<bool, Storage, Growth>::set_bits() const noexcept {
+    return SetBits(data(), word_count());
+}
+
+template <template <typename StorageT> typename Storage, typename Growth>
+template <typename F>
+void Array<bool, Storage, Growth>::for_each_set_bit(F&& fn) const {
+    const word_type* words = data();
+    const size_type count = word_count();
+    const auto find_nonzero = simd::bit_kernels().find_nonzero;
+
+    // Zero words are skipped by the kernel, set bits are taken off lowest first
+    for (size_type word = find_nonzero(words, count); word < count; word += 1 + find_nonzero(words + word + 1, count - word - 1)) {
+        for (word_type bits = words[word]; bits != 0; bits &= bits - 1) {
+            fn(word * WORD_BITS + std::countr_zero(bits));
+        }
+    }
 }
 
 // ========================== Modifiers =======================================
 // ----------------------------------------------------------------------------
 
-template <template<typename StorageT> typename Storage>
-void Array<bool, Storage>::clear() {
-    while (!empty()) {
-        pop_back();
-    }
+template <template <typename StorageT> typename Storage, typename Growth>
+void Array<bool, Storage, Growth>::clear() {
+    size_ = 0;
 }
 
-template <template<typename StorageT> typename Storage>
-void Array<bool, Storage>::push_back(value_type value) {
+template <template <typename StorageT> typename Storage, typename Growth>
+void Array<bool, Storage, Growth>::push_back(value_type value) {
     emplace_back(value);
 }
 
-template <template<typename StorageT> typename Storage>
-void Array<bool, Storage>::pop_back() {
+template <template <typename StorageT> typename Storage, typename Growth>
+void Array<bool, Storage, Growth>::pop_back() {
     --size_;
+    operator[](size_) = false;
 }
 
-template <template<typename StorageT> typename Storage>
-void Array<bool, Storage>::swap(Array& other) noexcept {
-    storage_.swap(other.storage_);
+template <template <typename StorageT> typename Storage, typename Growth>
+void Array<bool, Storage, Growth>::swap(Array& other) noexcept {
+    if constexpr (storage::sized_swap_storage<Storage<word_type>>) {
+        storage_.swap(other.storage_, word_count(), other.word_count());
+    } else {
+        storage_.swap(other.storage_);
+    }
     std::swap(size_, other.size_);
 }
 
+template <template <typename StorageT> typename Storage, typename Growth>
+void Array<bool, Storage, Growth>::resize(size_type new_size, value_type value) {
+    if (new_size <= size()) {
+        size_ = new_size;
+        clear_tail();
+        return;
+    }
+
+    grow_to(new_size);
+    // New words start cleared, the tail of the last old word is zero already
+    const size_type old_size = size();
+    const size_type old_words = word_count();
+    size_ = new_size;
+    if (word_count() != old_words) {
+        std::memset(&storage_[old_words], 0, (word_count() - old_words) * sizeof(word_type));
+    }
+    if (value) {
+        fill(old_size, new_size, true);
+    }
+}
+
+template <template <typename StorageT> typename Storage, typename Growth>
+void Array<bool, Storage, Growth>::fill(size_type first, size_type last, value_type value) {
+    if (first >= last) {
+        return;
+    }
+
+    const auto set = [value](word_type& word, word_type mask) {
+        word = value ? word | mask : word & ~mask;
+    };
+
+    const size_type first_word = first / WORD_BITS;
+    const size_type last_word = (last - 1) / WORD_BITS;
+    const word_type head = ~word_type{0} << (first % WORD_BITS);
+    const word_type tail = ~word_type{0} >> (WORD_BITS - 1 - (last - 1) % WORD_BITS);
+    if (first_word == last_word) {
+        set(storage_[first_word], head & tail);
+        return;
+    }
+
+    set(storage_[first_word], head);
+    if (last_word - first_word > 1) {
+        std::memset(&storage_[first_word + 1], value ? 0xff : 0, (last_word - first_word - 1) * sizeof(word_type));
+    }
+    set(storage_[last_word], tail);
+}
+
+template <template <typename StorageT> typename Storage, typename Growth>
+void Array<bool, Storage, Growth>::append_bits(word_type bits, size_type nbits) {
+    if (nbits == 0) {
+        return;
+    }
+    if (nbits < WORD_BITS) {
+        bits &= (word_type{1} << nbits) - 1;
+    }
+
+    grow_to(size() + nbits);
+    // Same as append_bit: a word the bits start is written whole, so is the one they spill into
+    const size_type offset = size_ % WORD_BITS;
+    word_type& word = storage_[size_ / WORD_BITS];
+    word = offset == 0 ? bits : word | (bits << offset);
+    if (offset != 0 && offset + nbits > WORD_BITS) {
+        storage_[size_ / WORD_BITS + 1] = bits >> (WORD_BITS - offset);
+    }
+    size_ += nbits;
+}
+
+template <template <typename StorageT> typename Storage, typename Growth>
+Array<bool, Storage, Growth>& Array<bool, Storage, Growth>::operator&=(const Array& other) {
+    check_same_size(other);
+    simd::bit_kernels().bit_and(data(), other.data(), word_count());
+    return *this;
+}
+
+template <template <typename StorageT> typename Storage, typename Growth>
+Array<bool, Storage, Growth>& Array<bool, Storage, Growth>::operator|=(const Array& other) {
+    check_same_size(other);
+    simd::bit_kernels().bit_or(data(), other.data(), word_count());
+    return *this;
+}
+
+template <template <typename StorageT> typename Storage, typename Growth>
+Array<bool, Storage, Growth>& Array<bool, Storage, Growth>::operator^=(const Array& other) {
+    check_same_size(other);
+    simd::bit_kernels().bit_xor(data(), other.data(), word_count());
+    return *this;
+}
+
+template <template <typename StorageT> typename Storage, typename Growth>
+Array<bool, Storage, Growth> Array<bool, Storage, Growth>::operator~() const {
+    Array result(*this);
+    simd::bit_kernels().bit_not(result.data(), result.word_count());
+    result.clear_tail();
+    return result;
+}
+
 // ----------------------------------------------------------------------------
 
-template <template<typename StorageT> typename Storage>
-typename Array<bool, Storage>::size_type Array<bool, Storage>::calc_new_cap() const {
-    return size() == 0 ? MIN_SIZE : size() * 2;
+template <template <typename StorageT> typename Storage, typename Growth>
+typename Array<bool, Storage, Growth>::size_type Array<bool, Storage, Growth>::calc_new_cap() const {
+    // Policy works on words, capacity is in bits
+    return Growth::next_capacity(storage_.capacity(), sizeof(word_type)) * WORD_BITS;
 }
 
-template <template<typename StorageT> typename Storage>
-void Array<bool, Storage>::check_range(size_type idx) const {
+template <template <typename StorageT> typename Storage, typename Growth>
+void Array<bool, Storage, Growth>::check_range(size_type idx) const {
     if (idx >= size()) {
         throw std::out_of_range("Array::check_range failed");
     }
 }
 
-template <template <typename StorageT> typename Storage>
-typename Array<bool, Storage>::size_type Array<bool, Storage>::real_size() const {
-    return size() / 8 + (size() % 8 == 0 ? 0 : 1);
+template <template <typename StorageT> typename Storage, typename Growth>
+void Array<bool, Storage, Growth>::check_same_size(const Array& other) const {
+    if (size() != other.size()) {
+        throw std::invalid_argument("Array<bool>: bitwise operation on arrays of different sizes");
+    }
+}
+
+template <template <typename StorageT> typename Storage, typename Growth>
+void Array<bool, Storage, Growth>::clear_tail() noexcept {
+    if (size_ % WORD_BITS != 0) {
+        storage_[size_ / WORD_BITS] &= (word_type{1} << (size_ % WORD_BITS)) - 1;
+    }
 }
 
-template <template <typename StorageT> typename Storage>
-void Array<bool, Storage>::emplace_back_resize(value_type value) {
-    Array new_array;
+template <template <typename StorageT> typename Storage, typename Growth>
+typename Array<bool, Storage, Growth>::size_type Array<bool, Storage, Growth>::word_count() const {
+    return util::CeilDiv(size(), WORD_BITS);
+}
 
+template <template <typename StorageT> typename Storage, typename Growth>
+Storage<typename Array<bool, Storage, Growth>::word_type> Array<bool, Storage, Growth>::empty_storage() const {
+    if constexpr (allocator_aware) {
+        return Storage<word_type>(storage_.get_allocator());
+    } else {
+        return Storage<word_type>();
+    }
+}
 
-    new_array.reserve(calc_new_cap());
+template <template <typename StorageT> typename Storage, typename Growth>
+Array<bool, Storage, Growth> Array<bool, Storage, Growth>::empty_like(bool copy) const {
+    if constexpr (allocator_aware) {
+        using traits_t = std::allocator_traits<allocator_type>;
+        return Array(copy ? traits_t::select_on_container_copy_construction(storage_.get_allocator())
+                          : storage_.get_allocator());
+    } else {
+        return Array();
+    }
+}
 
-    for (size_t idx = 0; idx < size(); ++idx) {
-        new_array.push_back(operator[](idx));
+template <template <typename StorageT> typename Storage, typename Growth>
+void Array<bool, Storage, Growth>::construct_copy(const Array& other) {
+    if (other.empty()) {
+        return;
     }
-    new_array.emplace_back(value);
 
-    swap(new_array);
+    storage_.allocate(other.word_count());
+    std::memcpy(&storage_[0], &other.storage_[0], other.word_count() * sizeof(word_type));
+    size_ = other.size();
 }
 
-template <template<typename StorageT> typename Storage>
-void Array<bool, Storage>::resize(size_type new_cap) {
+template <template <typename StorageT> typename Storage, typename Growth>
+void Array<bool, Storage, Growth>::emplace_back_resize(value_type value) {
+    reallocate(calc_new_cap());
+    append_bit(value);
+}
+
+template <template <typename StorageT> typename Storage, typename Growth>
+void Array<bool, Storage, Growth>::append_bit(value_type value) {
+    const size_type offset = size_ % WORD_BITS;
+    word_type& word = storage_[size_ / WORD_BITS];
+    word = offset == 0 ? word_type{value} : word | (word_type{value} << offset);
+    ++size_;
+}
+
+template <template <typename StorageT> typename Storage, typename Growth>
+void Array<bool, Storage, Growth>::reallocate(size_type new_cap) {
     if (new_cap < size()) {
         return;
     }
 
-    Array new_array;
-    new_array.storage_.allocate(new_cap / 8 + 1);
+    const size_type words = util::CeilDiv(new_cap, WORD_BITS);
+    if constexpr (storage::reallocatable_storage<Storage<word_type>>) {
+        if (storage_.reallocate(words)) {
+            return;
+        }
+    }
 
-    for (size_type idx = 0; idx < size(); ++idx) {
-        new_array[idx] = operator[](idx);
+    Array new_array = empty_like();
+    new_array.storage_.allocate(words);
+    if (!empty()) {
+        std::memcpy(&new_array.storage_[0], &storage_[0], word_count() * sizeof(word_type));
     }
+    new_array.size_ = size();
 
     swap(new_array);
 }
 
+template <template <typename StorageT> typename Storage, typename Growth>
+void Array<bool, Storage, Growth>::grow_to(size_type new_size) {
+    if (new_size <= capacity()) {
+        return;
+    }
+
+    size_type new_cap = capacity();
+    while (new_cap < new_size) {
+        new_cap = Growth::next_capacity(new_cap / WORD_BITS, sizeof(word_type)) * WORD_BITS;
+    }
+
+    reallocate(new_cap);
+}
+
 } // nostd
 
 // ============================================================================
@@ -0,0 +1,277 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <utility>
+
+#include <nostd/array/array.h>
+#include <nostd/util.h>
+
+namespace nostd {
+
+/*
+ * Fixed-size bit array for many writers, in the word layout of
+ * Array<bool>. Every word is a std::atomic, so bits in the same word can
+ * be set, reset and tested from different threads: one fetch_or or
+ * fetch_and per update, test_and_set returns whether this call set the
+ * bit, which makes it a visited mark for parallel traversals.
+ *
+ * Orderings default to acq_rel for updates and acquire for reads; pass
+ * relaxed when the bits carry no data published by the writer.
+ * Bulk reads load every word relaxed and see each of them at some point
+ * during the call, they are exact once the writers are joined.
+ */
+struct AtomicBitArray {
+    using word_type = uint64_t;
+    using size_type = size_t;
+    static constexpr size_t WORD_BITS = 64;
+
+    AtomicBitArray() noexcept = default;
+    // All bits clear
+    explicit AtomicBitArray(size_type size);
+    template <template <typename> typename Storage, typename Growth>
+    explicit AtomicBitArray(const Array<bool, Storage, Growth>& bits);
+
+    AtomicBitArray(const AtomicBitArray&) = delete;
+    AtomicBitArray& operator=(const AtomicBitArray&) = delete;
+
+    // Not thread safe, no other thread may use either array
+    // The moved-from array is empty
+    AtomicBitArray(AtomicBitArray&& other) noexcept;
+    AtomicBitArray& operator=(AtomicBitArray&& other) noexcept;
+
+    // Thread safe, UNSAFE: idx < size()
+    [[nodiscard]] bool test(size_type idx, std::memory_order order = std::memory_order_acquire) const noexcept;
+    // Return the previous value of the bit
+    bool test_and_set(size_type idx, std::memory_order order = std::memory_order_acq_rel) noexcept;
+    bool reset(size_type idx, std::memory_order order = std::memory_order_acq_rel) noexcept;
+
+    // Whole word updates, return the previous word. UNSAFE: bits past size() stay clear
+    word_type fetch_or(size_type word, word_type mask, std::memory_order order = std::memory_order_acq_rel) noexcept;
+    word_type fetch_and(size_type word, word_type mask, std::memory_order order = std::memory_order_acq_rel) noexcept;
+
+    // Sets the bits of indices, one fetch_or per run of indices in the same word:
+    // sorted indices cost one atomic per touched word. Returns the count of bits it set.
+    // UNSAFE: every index < size()
+    size_type set_many(std::span<const size_type> indices, std::memory_order order = std::memory_order_acq_rel) noexcept;
+
+    // Clears every bit, relaxed
+    void clear() noexcept;
+
+    // Capacity
+    [[nodiscard]] size_type size() const noexcept;
+    [[nodiscard]] bool empty() const noexcept;
+
+    // Bulk reads like Array<bool>, word at a time
+    [[nodiscard]] size_type count() const noexcept;
+    [[nodiscard]] bool any() const noexcept;
+    [[nodiscard]] bool all() const noexcept;
+    [[nodiscard]] bool none() const noexcept;
+    // Index of the first set bit, or size() if there is none
+    [[nodiscard]] size_type find_first() const noexcept;
+    // Index of the first set bit after idx, or size()
+    [[nodiscard]] size_type find_next(size_type idx) const noexcept;
+    // Calls fn(idx) for every set bit
+    template <typename F>
+    void for_each_set_bit(F&& fn) const;
+    // Snapshot as a packed bit array
+    [[nodiscard]] Array<bool> to_bits() const;
+
+private:
+    using atomic_type = std::atomic<word_type>;
+    static_assert(atomic_type::is_always_lock_free);
+
+    // The load half of an update ordering
+    [[nodiscard]] static constexpr std::memory_order load_order(std::memory_order order) noexcept;
+    [[nodiscard]] size_type word_count() const noexcept;
+    // Index of the first set bit in the words from `from` on, or size().
+    // The bit is taken from the same load that found the word nonzero
+    [[nodiscard]] size_type find_from_word(size_type from) const noexcept;
+
+    std::unique_ptr<atomic_type[]> words_;
+    size_type size_ = 0;
+};
+
+// ========================== Creating ========================================
+// ----------------------------------------------------------------------------
+
+inline AtomicBitArray::AtomicBitArray(size_type size)
+    : words_(std::make_unique<atomic_type[]>(util::CeilDiv(size, WORD_BITS))), size_(size) {
+}
+
+template <template <typename> typename Storage, typename Growth>
+AtomicBitArray::AtomicBitArray(const Array<bool, Storage, Growth>& bits)
+    : AtomicBitArray(bits.size()) {
+    for (size_type word = 0; word < word_count(); ++word) {
+        words_[word].store(bits.data()[word], std::memory_order_relaxed);
+    }
+}
+
+inline AtomicBitArray::AtomicBitArray(AtomicBitArray&& other) noexcept
+    : words_(std::move(other.words_)), size_(std::exchange(other.size_, 0)) {
+}
+
+inline AtomicBitArray& AtomicBitArray::operator=(AtomicBitArray&& other) noexcept {
+    if (this == &other) {
+        return *this;
+    }
+
+    words_ = std::move(other.words_);
+    size_ = std::exchange(other.size_, 0);
+    return *this;
+}
+
+// ========================== Updates =========================================
+// ----------------------------------------------------------------------------
+
+inline bool AtomicBitArray::test(size_type idx, std::memory_order order) const noexcept {
+    return (words_[idx / WORD_BITS].load(order) >> (idx % WORD_BITS)) & 1;
+}
+
+inline bool AtomicBitArray::test_and_set(size_type idx, std::memory_order order) noexcept {
+    const word_type bit = word_type{1} << (idx % WORD_BITS);
+    // A load first: marking a set bit again does not take the cache line exclusive
+    if (words_[idx / WORD_BITS].load(load_order(order)) & bit) {
+        return true;
+    }
+    return words_[idx / WORD_BITS].fetch_or(bit, order) & bit;
+}
+
+inline bool AtomicBitArray::reset(size_type idx, std::memory_order order) noexcept {
+    const word_type bit = word_type{1} << (idx % WORD_BITS);
+    return words_[idx / WORD_BITS].fetch_and(~bit, order) & bit;
+}
+
+inline AtomicBitArray::word_type AtomicBitArray::fetch_or(size_type word, word_type mask, std::memory_order order) noexcept {
+    return words_[word].fetch_or(mask, order);
+}
+
+inline AtomicBitArray::word_type AtomicBitArray::fetch_and(size_type word, word_type mask, std::memory_order order) noexcept {
+    return words_[word].fetch_and(mask, order);
+}
+
+inline AtomicBitArray::size_type AtomicBitArray::set_many(std::span<const size_type> indices, std::memory_order order) noexcept {
+    size_type set = 0;
+    for (size_type pos = 0; pos < indices.size();) {
+        const size_type word = indices[pos] / WORD_BITS;
+        word_type mask = 0;
+        for (; pos < indices.size() && indices[pos] / WORD_BITS == word; ++pos) {
+            mask |= word_type{1} << (indices[pos] % WORD_BITS);
+        }
+        // Like test_and_set, no fetch_or when the bits are already set
+        if ((mask & ~words_[word].load(load_order(order))) != 0) {
+            set += std::popcount(mask & ~words_[word].fetch_or(mask, order));
+        }
+    }
+    return set;
+}
+
+inline void AtomicBitArray::clear() noexcept {
+    for (size_type word = 0; word < word_count(); ++word) {
+        words_[word].store(0, std::memory_order_relaxed);
+    }
+}
+
+// ========================== Capacity ========================================
+// ----------------------------------------------------------------------------
+
+inline AtomicBitArray::size_type AtomicBitArray::size() const noexcept {
+    return size_;
+}
+
+inline bool AtomicBitArray::empty() const noexcept {
+    return size_ == 0;
+}
+
+// ========================== Bulk reads ======================================
+// ----------------------------------------------------------------------------
+
+inline AtomicBitArray::size_type AtomicBitArray::count() const noexcept {
+    size_type result = 0;
+    for (size_type word = 0; word < word_count(); ++word) {
+        result += std::popcount(words_[word].load(std::memory_order_relaxed));
+    }
+    return result;
+}
+
+inline bool AtomicBitArray::any() const noexcept {
+    return find_from_word(0) != size();
+}
+
+inline bool AtomicBitArray::all() const noexcept {
+    return count() == size();
+}
+
+inline bool AtomicBitArray::none() const noexcept {
+    return !any();
+}
+
+inline AtomicBitArray::size_type AtomicBitArray::find_first() const noexcept {
+    return find_from_word(0);
+}
+
+inline AtomicBitArray::size_type AtomicBitArray::find_next(size_type idx) const noexcept {
+    if (idx + 1 >= size()) {
+        return size();
+    }
+
+    // The rest of the word of idx first, then whole words
+    const size_type next = idx + 1;
+    const word_type rest = words_[next / WORD_BITS].load(std::memory_order_relaxed) & (~word_type{0} << (next % WORD_BITS));
+    if (rest != 0) {
+        return next / WORD_BITS * WORD_BITS + std::countr_zero(rest);
+    }
+
+    return find_from_word(next / WORD_BITS + 1);
+}
+
+template <typename F>
+void AtomicBitArray::for_each_set_bit(F&& fn) const {
+    for (size_type word = 0; word < word_count(); ++word) {
+        for (word_type bits = words_[word].load(std::memory_order_relaxed); bits != 0; bits &= bits - 1) {
+            fn(word * WORD_BITS + std::countr_zero(bits));
+        }
+    }
+}
+
+inline Array<bool> AtomicBitArray::to_bits() const {
+    Array<bool> result(size_, false);
+    for (size_type word = 0; word < word_count(); ++word) {
+        result.data()[word] = words_[word].load(std::memory_order_relaxed);
+    }
+    return result;
+}
+
+// ----------------------------------------------------------------------------
+
+constexpr std::memory_order AtomicBitArray::load_order(std::memory_order order) noexcept {
+    switch (order) {
+        case std::memory_order_release:
+            return std::memory_order_relaxed;
+        case std::memory_order_acq_rel:
+            return std::memory_order_acquire;
+        default:
+            return order;
+    }
+}
+
+inline AtomicBitArray::size_type AtomicBitArray::word_count() const noexcept {
+    return util::CeilDiv(size_, WORD_BITS);
+}
+
+inline AtomicBitArray::size_type AtomicBitArray::find_from_word(size_type from) const noexcept {
+    for (size_type word = from; word < word_count(); ++word) {
+        // A second load could see the word reset to zero by another thread
+        const word_type bits = words_[word].load(std::memory_order_relaxed);
+        if (bits != 0) {
+            return word * WORD_BITS + std::countr_zero(bits);
+        }
+    }
+    return size();
+}
+
+} // nostd
@@ -0,0 +1,256 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+
+#include <nostd/array/segmented_array.h>
+#include <nostd/concepts/concepts.h>
+
+namespace nostd {
+
+/*
+ * Append-only array for many producers, lock-free.
+ * A push takes its slot with one fetch_add on the size and constructs the
+ * element in place; segments of doubling size are installed with a CAS
+ * in a fixed table, so nothing is ever relocated and no thread waits for
+ * another. Readers are wait-free: an element is published with a release
+ * store of its flag once constructed, get() returns nullptr before that.
+ *
+ * Slots below size() may still be under construction, or stay empty if
+ * the constructor threw. After the producers are joined every slot
+ * below size() is published, except those.
+ */
+template <typename T, size_t FirstSegment = 64>
+struct ConcurrentArray {
+    using value_type = T;
+    using size_type = size_t;
+    using const_reference = const value_type&;
+
+    ConcurrentArray() noexcept = default;
+    explicit ConcurrentArray(size_type reserve);
+
+    ConcurrentArray(const ConcurrentArray&) = delete;
+    ConcurrentArray& operator=(const ConcurrentArray&) = delete;
+
+    ~ConcurrentArray();
+
+    // Thread safe, return the index of the element, published on return
+    template <typename... Args>
+    size_type emplace_back(Args&&... args);
+    size_type push_back(const value_type& value);
+    size_type push_back(value_type&& value);
+
+    // Allocates the segments for new_cap elements ahead of the producers
+    void reserve(size_type new_cap);
+
+    // Slots handed out so far
+    [[nodiscard]] size_type size() const noexcept;
+    [[nodiscard]] bool empty() const noexcept;
+
+    // Wait-free
+    [[nodiscard]] bool published(size_type idx) const noexcept;
+    [[nodiscard]] const T* get(size_type idx) const noexcept;
+
+    // UNSAFE: idx must be published
+    [[nodiscard]] const_reference operator[](size_type idx) const;
+
+    // Calls fn(idx, element) for the published elements, in index order
+    template <typename F>
+    void for_each(F&& fn) const;
+
+private:
+    using index_t = detail::SegmentIndex<FirstSegment>;
+    using flag_t = std::atomic<uint8_t>;
+
+    // A segment holds the elements, then one publication flag per element
+    static std::byte* allocate_segment(size_type segment);
+    static void deallocate_segment(std::byte* block);
+    [[nodiscard]] static T* elements(std::byte* block) noexcept;
+    [[nodiscard]] static flag_t* flags(std::byte* block, size_type segment) noexcept;
+
+    // Loads the segment, installs it if no one did yet
+    std::byte* segment(size_type seg);
+
+    std::array<std::atomic<std::byte*>, index_t::MAX_SEGMENTS> segments_{};
+    // Every producer writes it, it gets a cache line of its own
+    alignas(64) std::atomic<size_type> size_{0};
+};
+
+// ========================== Creating ========================================
+// ----------------------------------------------------------------------------
+
+template <typename T, size_t FirstSegment>
+ConcurrentArray<T, FirstSegment>::ConcurrentArray(size_type reserve) {
+    this->reserve(reserve);
+}
+
+template <typename T, size_t FirstSegment>
+ConcurrentArray<T, FirstSegment>::~ConcurrentArray() {
+    const size_type size = size_.load(std::memory_order_acquire);
+    for (size_type segment = 0; segment < index_t::MAX_SEGMENTS; ++segment) {
+        std::byte* block = segments_[segment].load(std::memory_order_acquire);
+        if (block == nullptr) {
+            continue;
+        }
+
+        if constexpr (!trivially_destructible<T>) {
+            const size_type begin = index_t::segment_begin(segment);
+            const size_type count = begin < size ? std::min(index_t::segment_size(segment), size - begin) : 0;
+            for (size_type offset = 0; offset < count; ++offset) {
+                if (flags(block, segment)[offset].load(std::memory_order_acquire) != 0) {
+                    std::destroy_at(elements(block) + offset);
+                }
+            }
+        }
+        deallocate_segment(block);
+    }
+}
+
+// ========================== Modifiers =======================================
+// ----------------------------------------------------------------------------
+
+template <typename T, size_t FirstSegment>
+template <typename... Args>
+typename ConcurrentArray<T, FirstSegment>::size_type ConcurrentArray<T, FirstSegment>::emplace_back(Args&&... args) {
+    const size_type idx = size_.fetch_add(1, std::memory_order_relaxed);
+    const size_type seg = index_t::segment(idx);
+    const size_type offset = index_t::offset(idx);
+
+    std::byte* block = segment(seg);
+    if (offset == 0 && seg + 1 < index_t::MAX_SEGMENTS) {
+        // The first producer in a segment installs the next one before the others need it
+        segment(seg + 1);
+    }
+
+    std::construct_at(elements(block) + offset, std::forward<Args>(args)...);
+    flags(block, seg)[offset].store(1, std::memory_order_release);
+    return idx;
+}
+
+template <typename T, size_t FirstSegment>
+typename ConcurrentArray<T, FirstSegment>::size_type ConcurrentArray<T, FirstSegment>::push_back(const value_type& value) {
+    return emplace_back(value);
+}
+
+template <typename T, size_t FirstSegment>
+typename ConcurrentArray<T, FirstSegment>::size_type ConcurrentArray<T, FirstSegment>::push_back(value_type&& value) {
+    return emplace_back(std::move(value));
+}
+
+template <typename T, size_t FirstSegment>
+void ConcurrentArray<T, FirstSegment>::reserve(size_type new_cap) {
+    for (size_type seg = 0; index_t::segment_begin(seg) < new_cap; ++seg) {
+        segment(seg);
+    }
+}
+
+// ========================== Access ==========================================
+// ----------------------------------------------------------------------------
+
+template <typename T, size_t FirstSegment>
+typename ConcurrentArray<T, FirstSegment>::size_type ConcurrentArray<T, FirstSegment>::size() const noexcept {
+    return size_.load(std::memory_order_acquire);
+}
+
+template <typename T, size_t FirstSegment>
+bool ConcurrentArray<T, FirstSegment>::empty() const noexcept {
+    return size() == 0;
+}
+
+template <typename T, size_t FirstSegment>
+bool ConcurrentArray<T, FirstSegment>::published(size_type idx) const noexcept {
+    return get(idx) != nullptr;
+}
+
+template <typename T, size_t FirstSegment>
+const T* ConcurrentArray<T, FirstSegment>::get(size_type idx) const noexcept {
+    if (idx >= size()) {
+        return nullptr;
+    }
+
+    const size_type seg = index_t::segment(idx);
+    std::byte* block = segments_[seg].load(std::memory_order_acquire);
+    if (block == nullptr || flags(block, seg)[index_t::offset(idx)].load(std::memory_order_acquire) == 0) {
+        return nullptr;
+    }
+    return elements(block) + index_t::offset(idx);
+}
+
+template <typename T, size_t FirstSegment>
+typename ConcurrentArray<T, FirstSegment>::const_reference ConcurrentArray<T, FirstSegment>::operator[](size_type idx) const {
+    std::byte* block = segments_[index_t::segment(idx)].load(std::memory_order_acquire);
+    return elements(block)[index_t::offset(idx)];
+}
+
+template <typename T, size_t FirstSegment>
+template <typename F>
+void ConcurrentArray<T, FirstSegment>::for_each(F&& fn) const {
+    const size_type size = this->size();
+    for (size_type seg = 0; index_t::segment_begin(seg) < size; ++seg) {
+        std::byte* block = segments_[seg].load(std::memory_order_acquire);
+        if (block == nullptr) {
+            continue;
+        }
+
+        const size_type begin = index_t::segment_begin(seg);
+        const size_type count = std::min(index_t::segment_size(seg), size - begin);
+        for (size_type offset = 0; offset < count; ++offset) {
+            if (flags(block, seg)[offset].load(std::memory_order_acquire) != 0) {
+                fn(begin + offset, std::as_const(elements(block)[offset]));
+            }
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+template <typename T, size_t FirstSegment>
+std::byte* ConcurrentArray<T, FirstSegment>::allocate_segment(size_type segment) {
+    const size_type count = index_t::segment_size(segment);
+    auto* block = static_cast<std::byte*>(::operator new(count * (sizeof(T) + sizeof(flag_t)),
+                                                         std::align_val_t{alignof(T)}));
+    for (size_type offset = 0; offset < count; ++offset) {
+        std::construct_at(flags(block, segment) + offset, 0);
+    }
+    return block;
+}
+
+template <typename T, size_t FirstSegment>
+void ConcurrentArray<T, FirstSegment>::deallocate_segment(std::byte* block) {
+    ::operator delete(block, std::align_val_t{alignof(T)});
+}
+
+template <typename T, size_t FirstSegment>
+T* ConcurrentArray<T, FirstSegment>::elements(std::byte* block) noexcept {
+    return reinterpret_cast<T*>(block);
+}
+
+template <typename T, size_t FirstSegment>
+typename ConcurrentArray<T, FirstSegment>::flag_t* ConcurrentArray<T, FirstSegment>::flags(std::byte* block, size_type segment) noexcept {
+    static_assert(sizeof(flag_t) == 1 && alignof(flag_t) == 1);
+    return reinterpret_cast<flag_t*>(block + index_t::segment_size(segment) * sizeof(T));
+}
+
+template <typename T, size_t FirstSegment>
+std::byte* ConcurrentArray<T, FirstSegment>::segment(size_type seg) {
+    std::byte* block = segments_[seg].load(std::memory_order_acquire);
+    if (block != nullptr) [[likely]] {
+        return block;
+    }
+
+    std::byte* fresh = allocate_segment(seg);
+    if (segments_[seg].compare_exchange_strong(block, fresh, std::memory_order_acq_rel, std::memory_order_acquire)) {
+        return fresh;
+    }
+    // Another producer installed it first
+    deallocate_segment(fresh);
+    return block;
+}
+
+} // nostd
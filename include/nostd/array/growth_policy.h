@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+
+namespace nostd::growth {
+
+inline constexpr size_t PAGE_SIZE      = size_t{4} << 10;
+inline constexpr size_t HUGE_PAGE_SIZE = size_t{2} << 20;
+
+// ----------------------------------------------------------------------------
+
+struct Doubling {
+    static constexpr size_t next_capacity(size_t capacity, size_t /*value_size*/) {
+        return capacity < MIN_SIZE ? MIN_SIZE : capacity * 2;
+    }
+
+    static constexpr size_t MIN_SIZE{4};
+};
+
+/*
+ * Freed blocks 1, 1.5, 2.25, ... sum up to a size the next
+ * request fits in, so allocator can reuse them.
+ */
+struct OneAndHalf {
+    static constexpr size_t next_capacity(size_t capacity, size_t /*value_size*/) {
+        return capacity < MIN_SIZE ? MIN_SIZE : capacity + capacity / 2;
+    }
+
+    static constexpr size_t MIN_SIZE{4};
+};
+
+// Grows as Inner does, then fills the last page of the buffer
+template <size_t PageSize = PAGE_SIZE, typename Inner = Doubling>
+struct PageGranular {
+    static_assert(PageSize != 0 && (PageSize & (PageSize - 1)) == 0, "page size must be a power of two");
+
+    static constexpr size_t next_capacity(size_t capacity, size_t value_size) {
+        size_t bytes = Inner::next_capacity(capacity, value_size) * value_size;
+        bytes = (bytes + PageSize - 1) & ~(PageSize - 1);
+        return bytes / value_size;
+    }
+};
+
+template <size_t Chunk>
+struct FixedChunk {
+    static_assert(Chunk != 0, "chunk must not be empty");
+
+    static constexpr size_t next_capacity(size_t capacity, size_t /*value_size*/) {
+        return capacity + Chunk;
+    }
+};
+
+template <typename Inner = Doubling>
+using HugePageGranular = PageGranular<HUGE_PAGE_SIZE, Inner>;
+
+} // nostd::growth
+
+/*
+ * Growth policy requirements:
+
+ * static size_t next_capacity(size_t capacity, size_t value_size);
+   returns capacity > given one, value_size is the size of a storage unit
+ */
@@ -0,0 +1,641 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <utility>
+
+#include <nostd/concepts/concepts.h>
+
+namespace nostd {
+
+namespace detail {
+
+/*
+ * Segment k holds First << k elements and starts at index (First << k) - First,
+ * so idx + First has the segment in its highest bit and the offset below it.
+ * The table of MAX_SEGMENTS pointers covers the whole size_t range and never moves.
+ */
+template <size_t First>
+struct SegmentIndex {
+    static_assert(std::has_single_bit(First), "first segment size must be a power of two");
+
+    static constexpr size_t FIRST_BITS = std::countr_zero(First);
+    static constexpr size_t MAX_SEGMENTS = std::numeric_limits<size_t>::digits - FIRST_BITS;
+
+    // | First bounds the result by MAX_SEGMENTS even if idx + First wraps,
+    // which -Warray-bounds can not rule out; it changes no valid index
+    [[nodiscard]] static constexpr size_t segment(size_t idx) noexcept {
+        return std::bit_width((idx + First) | First) - 1 - FIRST_BITS;
+    }
+
+    [[nodiscard]] static constexpr size_t offset(size_t idx) noexcept {
+        const size_t biased = idx + First;
+        return biased ^ std::bit_floor(biased);
+    }
+
+    [[nodiscard]] static constexpr size_t segment_size(size_t segment) noexcept {
+        return First << segment;
+    }
+
+    // Also the capacity of the first `segment` segments
+    [[nodiscard]] static constexpr size_t segment_begin(size_t segment) noexcept {
+        return (First << segment) - First;
+    }
+};
+
+} // nostd::detail
+
+// ============================================================================
+
+/*
+ * Array growing by whole segments of doubling size instead of relocating:
+ * elements never move, references and pointers stay valid until the
+ * element is removed, also across moves and swaps of the array.
+ * Iterators refer to the array object, a move or swap leaves them on it.
+ * Indexing is O(1), two bit operations on the index.
+ * Memory is not contiguous, for_each_segment() visits the contiguous parts.
+ */
+template <typename T, size_t FirstSegment = 16, typename Allocator = std::allocator<T>>
+    requires std::is_same_v<T, typename Allocator::value_type>
+struct SegmentedArray {
+private:
+    template <bool Const>
+    class SegmentedIterator {
+    public:
+        using iterator_concept = std::random_access_iterator_tag;
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const T*, T*>;
+        using reference = std::conditional_t<Const, const T&, T&>;
+        using array_pointer = std::conditional_t<Const, const SegmentedArray*, SegmentedArray*>;
+
+        SegmentedIterator() noexcept = default;
+
+        template <bool C = Const> requires C
+        SegmentedIterator(const SegmentedIterator<false>& other) noexcept // NOLINT
+            : array_(other.array_), idx_(other.idx_) {
+        }
+
+        reference operator*() const {
+            return (*array_)[idx_];
+        }
+
+        pointer operator->() const {
+            return &(*array_)[idx_];
+        }
+
+        reference operator[](difference_type diff) const {
+            return (*array_)[idx_ + diff];
+        }
+
+        SegmentedIterator& operator++() {
+            ++idx_;
+            return *this;
+        }
+
+        SegmentedIterator operator++(int) {
+            SegmentedIterator it = *this;
+            ++idx_;
+            return it;
+        }
+
+        SegmentedIterator& operator--() {
+            --idx_;
+            return *this;
+        }
+
+        SegmentedIterator operator--(int) {
+            SegmentedIterator it = *this;
+            --idx_;
+            return it;
+        }
+
+        SegmentedIterator& operator+=(difference_type diff) {
+            idx_ += diff;
+            return *this;
+        }
+
+        SegmentedIterator& operator-=(difference_type diff) {
+            idx_ -= diff;
+            return *this;
+        }
+
+        friend SegmentedIterator operator+(SegmentedIterator it, difference_type diff) {
+            return it += diff;
+        }
+
+        friend SegmentedIterator operator+(difference_type diff, SegmentedIterator it) {
+            return it += diff;
+        }
+
+        friend SegmentedIterator operator-(SegmentedIterator it, difference_type diff) {
+            return it -= diff;
+        }
+
+        friend difference_type operator-(const SegmentedIterator& lhs, const SegmentedIterator& rhs) {
+            return static_cast<difference_type>(lhs.idx_ - rhs.idx_);
+        }
+
+        friend bool operator==(const SegmentedIterator& lhs, const SegmentedIterator& rhs) {
+            return lhs.idx_ == rhs.idx_;
+        }
+
+        friend auto operator<=>(const SegmentedIterator& lhs, const SegmentedIterator& rhs) {
+            return lhs.idx_ <=> rhs.idx_;
+        }
+
+    private:
+        friend SegmentedArray;
+        template <bool> friend class SegmentedIterator;
+
+        SegmentedIterator(array_pointer array, size_t idx) noexcept
+            : array_(array), idx_(idx) {
+        }
+
+        array_pointer array_{nullptr};
+        size_t idx_{};
+    };
+
+    using index_t = detail::SegmentIndex<FirstSegment>;
+    using traits_t = std::allocator_traits<Allocator>;
+
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using pointer = value_type*;
+    using const_pointer = const value_type*;
+    using allocator_type = Allocator;
+
+    using iterator = SegmentedIterator<false>;
+    using const_iterator = SegmentedIterator<true>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    // Creating
+    SegmentedArray() noexcept = default;
+    explicit SegmentedArray(const allocator_type& alloc) noexcept;
+
+    // Exception guarantees destruction of created elements
+    explicit SegmentedArray(size_type size, const allocator_type& alloc = allocator_type());
+    SegmentedArray(size_type size, const value_type& val, const allocator_type& alloc = allocator_type());
+    SegmentedArray(std::initializer_list<value_type> list, const allocator_type& alloc = allocator_type());
+
+    SegmentedArray(const SegmentedArray& other);
+    SegmentedArray& operator=(const SegmentedArray& other);
+
+    SegmentedArray(SegmentedArray&& other) noexcept;
+    SegmentedArray& operator=(SegmentedArray&& other) noexcept;
+
+    ~SegmentedArray();
+
+    [[nodiscard]] allocator_type get_allocator() const;
+
+    // Access
+    [[nodiscard]] reference at(size_type idx);
+    [[nodiscard]] const_reference at(size_type idx) const;
+
+    // UNSAFE
+    [[nodiscard]] reference operator[](size_type idx);
+    [[nodiscard]] const_reference operator[](size_type idx) const;
+
+    // UNSAFE
+    [[nodiscard]] reference front();
+    [[nodiscard]] const_reference front() const;
+
+    // UNSAFE
+    [[nodiscard]] reference back();
+    [[nodiscard]] const_reference back() const;
+
+    // Calls fn with a std::span<T> (const T for const arrays) per non-empty segment, in order
+    template <typename F>
+    void for_each_segment(F&& fn);
+    template <typename F>
+    void for_each_segment(F&& fn) const;
+
+    // Iterators
+    iterator begin() noexcept;
+    const_iterator begin() const noexcept;
+
+    iterator end() noexcept;
+    const_iterator end() const noexcept;
+
+    reverse_iterator rbegin() noexcept;
+    const_reverse_iterator rbegin() const noexcept;
+
+    reverse_iterator rend() noexcept;
+    const_reverse_iterator rend() const noexcept;
+
+    // Capacity
+    [[nodiscard]] bool empty() const noexcept;
+    [[nodiscard]] size_type size() const noexcept;
+    [[nodiscard]] size_type capacity() const noexcept;
+    [[nodiscard]] size_type segment_count() const noexcept;
+    // Allocates segments up to new_cap, nothing moves
+    void reserve(size_type new_cap);
+    // Frees the segments past the last element
+    void shrink_to_fit();
+
+    // Modifiers
+    void clear();
+    void push_back(const value_type& value);
+    void push_back(value_type&& value);
+    void pop_back();
+    void swap(SegmentedArray& other) noexcept;
+
+    // Returns the new element, its address is stable
+    template <typename... Args>
+    reference emplace_back(Args&&... args) {
+        if (size_ == capacity()) {
+            add_segment();
+        }
+
+        T* slot = segments_[index_t::segment(size_)] + index_t::offset(size_);
+        traits_t::construct(alloc_, slot, std::forward<Args>(args)...);
+        ++size_;
+        return *slot;
+    }
+
+private:
+    static constexpr bool propagate_on_copy = traits_t::propagate_on_container_copy_assignment::value;
+
+    // Copies the elements of other into this empty array
+    void construct_copy(const SegmentedArray& other);
+    void add_segment();
+    // Destroys elements from new_size on
+    void destroy_from(size_type new_size);
+    void free_segments(size_type count);
+    void check_range(size_type idx) const;
+
+    Allocator alloc_;
+    std::array<T*, index_t::MAX_SEGMENTS> segments_{};
+    size_type segment_count_{};
+    size_type size_{};
+};
+
+// ========================== Creating ========================================
+// ----------------------------------------------------------------------------
+
+template <typename T, size_t FirstSegment, typename Allocator>
+    requires std::is_same_v<T, typename Allocator::value_type>
+SegmentedArray<T, FirstSegment, Allocator>::SegmentedArray(const allocator_type& alloc) noexcept
+    : alloc_(alloc) {
+}
+
+template <typename T, size_t FirstSegment, typename Allocator>
+    requires std::is_same_v<T, typename Allocator::value_type>
+SegmentedArray<T, FirstSegment, Allocator>::SegmentedArray(size_type size, const allocator_type& alloc)
+    : SegmentedArray(alloc) {
+    reserve(size);
+    while (size_ < size) {
+        emplace_back();
+    }
+}
+
+template <typename T, size_t FirstSegment, typename Allocator>
+    requires std::is_same_v<T, typename Allocator::value_type>
+SegmentedArray<T, FirstSegment, Allocator>::SegmentedArray(size_type size, const value_type& val,
+                                                           const allocator_type& alloc)
+    : SegmentedArray(alloc) {
+    reserve(size);
+    while (size_ < size) {
+        emplace_back(val);
+    }
+}
+
+template <typename T, size_t FirstSegment, typename Allocator>
+    requires std::is_same_v<T, typename Allocator::value_type>
+SegmentedArray<T, FirstSegment, Allocator>::SegmentedArray(std::initializer_list<value_type> list,
+                                                           const allocator_type& alloc)
+    : SegmentedArray(alloc) {
+    reserve(list.size());
+    for (const auto& val: list) {
+        emplace_back(val);
+    }
+}
+
+template <typename T, size_t FirstSegment, typename Allocator>
+    requires std::is_same_v<T, typename Allocator::value_type>
+SegmentedArray<T, FirstSegment, Allocator>::SegmentedArray(const SegmentedArray& other)
+    : SegmentedArray(traits_t::select_on_container_copy_construction(other.alloc_)) {
+    construct_copy(other);
+}
+
+template <typename T, size_t FirstSegment, typename Allocator>
+    requires std::is_same_v<T, typename Allocator::value_type>
+SegmentedArray<T, FirstSegment, Allocator>& SegmentedArray<T, FirstSegment, Allocator>::operator=(const SegmentedArray& other) {
+    if (this != &other) {
+        // The allocator of other replaces this one only if it propagates
+        SegmentedArray tmp(propagate_on_copy ? other.alloc_ : alloc_);
+        tmp.construct_copy(other);
+        swap(tmp);
+    }
+    return *this;
+}
+
+template <typename T, size_t FirstSegment, typename Allocator>
+    requires std::is_same_v<T, typename Allocator::value_type>
+void SegmentedArray<T, FirstSegment, Allocator>::construct_copy(const SegmentedArray& other) {
+    reserve(other.size());
+
+    // Both arrays have the same segment layout, so segments copy one to one
+    other.for_each_segment([this](std::span<const T> segment) {
+        T* dst = segments_[index_t::segment(size_)];
+        if constexpr (trivially_copyable<T>) {
+            std::memcpy(static_cast<void*>(dst), segment.data(), segment.size_bytes());
+            size_ += segment.size();
+        } else {
+            for (const T& val: segment) {
+                traits_t::construct(alloc_, dst++, val);
+                ++size_;
+            }
+        }
+    });
+}
+
+template <typename T, size_t FirstSegment, typename Allocator>
+    requires std::is_same_v<T, typename Allocator::value_type>
+SegmentedArray<T, FirstSegment, Allocator>::SegmentedArray(SegmentedArray&& other) noexcept
+    : alloc_(other.alloc_) {
+    swap(other);
+}
+
+template <typename T, size_t FirstSegment, typename Allocator>
+    requires std::is_same_v<T, typename Allocator::value_type>
+SegmentedArray<T, FirstSegment, Allocator>& SegmentedArray<T, FirstSegment, Allocator>::operator=(SegmentedArray&& other) noexcept {
+    if (this != &other) {
+        swap(other);
+    }
+    return *this;
+}
+
+template <typename T, size_t FirstSegment, typename Allocator>
+    requires std::is_same_v<T, typename Allocator::value_type>
+SegmentedArray<T, FirstSegment, Allocator>::~SegmentedArray() {
+    clear();
+    free_segments(0);
+}
+
+template <typename T, size_t FirstSegment, typename Allocator>
+    requires std::is_same_v<T, typename Allocator::value_type>
+typename SegmentedArray<T, FirstSegment, Allocator>::allocator_type SegmentedArray<T, FirstSegment, Allocator>::get_allocator() const {
+    return alloc_;
+}
+
+// ========================== Access ==========================================
+// ----------------------------------------------------------------------------
+
+template <typename T, size_t FirstSegment, typename Allocator>
+    requires std::is_same_v<T, typename Allocator::value_type>
+typename SegmentedArray<T, FirstSegment, Allocator>::reference SegmentedArray<T, FirstSegment, Allocator>::at(size_type idx) {
+    check_range(idx);
+    return operator[](idx);
+}
+
+template <typename T, size_t FirstSegment, typename Allocator>
+    requires std::is_same_v<T, typename Allocator::value_type>
+typename SegmentedArray<T, FirstSegment, Allocator>::const_reference SegmentedArray<T, FirstSegment, Allocator>::at(size_type idx) const {
+    check_range(idx);
+    return operator[](idx);
+}
+
+template <typename T, size_t FirstSegment, typename Allocator>
+    requires std::is_same_v<T, typename Allocator::value_type>
+typename SegmentedArray<T, FirstSegment, Allocator>::reference SegmentedArray<T, FirstSegment, Allocator>::operator[](size_type idx) {
+    return segments_[index_t::segment(idx)][index_t::offset(idx)];
+}
+
+template <typename T, size_t FirstSegment, typename Allocator>
+    requires std::is_same_v<T, typename Allocator::value_type>
+typename SegmentedArray<T, FirstSegment, Allocator>::const_reference SegmentedArray<T, FirstSegment, Allocator>::operator[](size_type idx) const {
+    return segments_[index_t::segment(idx)][index_t::offset(idx)];
+}
+
+template <typename T, size_t FirstSegment, typename Allocator>
+    requires std::is_same_v<T, typename Allocator::value_type>
+typename SegmentedArray<T, FirstSegment, Allocator>::reference SegmentedArray<T, FirstSegment, Allocator>::front() {
+    return segments_[0][0];
+}
+
+template <typename T, size_t FirstSegment, typename Allocator>
+    requires std::is_same_v<T, typename Allocator::value_type>
+typename SegmentedArray<T, FirstSegment, Allocator>::const_reference SegmentedArray<T, FirstSegment, Allocator>::front() const {
+    return segments_[0][0];
+}
+
+template <typename T, size_t FirstSegment, typename Allocator>
+    requires std::is_same_v<T, typename Allocator::value_type>
+typename SegmentedArray<T, FirstSegment, Allocator>::reference SegmentedArray<T, FirstSegment, Allocator>::back() {
+    return operator[](size_ - 1);
+}
+
+template <typename T, size_t FirstSegment, typename Allocator>
+    requires std::is_same_v<T, typename Allocator::value_type>
+typename SegmentedArray<T, FirstSegment, Allocator>::const_reference SegmentedArray<T, FirstSegment, Allocator>::back() const {
+    return operator[](size_ - 1);
+}
+
+template <typename T, size_t FirstSegment, typename Allocator>
+    requires std::is_same_v<T, typename Allocator::value_type>
+template <typename F>
+void SegmentedArray<T, FirstSegment, Allocator>::for_each_segment(F&& fn) {
+    for (size_type segment = 0; index_t::segment_begin(segment) < size_; ++segment) {
+        const size_type count = std::min(index_t::segment_size(segment), size_ - index_t::segment_begin(segment));
+        fn(std::span<T>(segments_[segment], count));
+    }
+}
+
+template <typename T, size_t FirstSegment, typename Allocator>
+    requires std::is_same_v<T, typename Allocator::value_type>
+template <typename F>
+void SegmentedArray<T, FirstSegment, Allocator>::for_each_segment(F&& fn) const {
+    for (size_type segment = 0; index_t::segment_begin(segment) < size_; ++segment) {
+        const size_type count = std::min(index_t::segment_size(segment), size_ - index_t::segment_begin(segment));
+        fn(std::span<const T>(segments_[segment], count));
+    }
+}
+
+// ========================== Iterators =======================================
+// ----------------------------------------------------------------------------
+
+template <typename T, size_t FirstSegment, typename Allocator>
+    requires std::is_same_v<T, typename Allocator::value_type>
+typename SegmentedArray<T, FirstSegment, Allocator>::iterator SegmentedArray<T, FirstSegment, Allocator>::begin() noexcept {
+    return iterator(this, 0);
+}
+
+template <typename T, size_t FirstSegment, typename Allocator>
+    requires std::is_same_v<T, typename Allocator::value_type>
+typename SegmentedArray<T, FirstSegment, Allocator>::const_iterator SegmentedArray<T, FirstSegment, Allocator>::begin() const noexcept {
+    return const_iterator(this, 0);
+}
+
+template <typename T, size_t FirstSegment, typename Allocator>
+    requires std::is_same_v<T, typename Allocator::value_type>
+typename SegmentedArray<T, FirstSegment, Allocator>::iterator SegmentedArray<T, FirstSegment, Allocator>::end() noexcept {
+    return iterator(this, size_);
+}
+
+template <typename T, size_t FirstSegment, typename Allocator>
+    requires std::is_same_v<T, typename Allocator::value_type>
+typename SegmentedArray<T, FirstSegment, Allocator>::const_iterator SegmentedArray<T, FirstSegment, Allocator>::end() const noexcept {
+    return const_iterator(this, size_);
+}
+
+template <typename T, size_t FirstSegment, typename Allocator>
+    requires std::is_same_v<T, typename Allocator::value_type>
+typename SegmentedArray<T, FirstSegment, Allocator>::reverse_iterator SegmentedArray<T, FirstSegment, Allocator>::rbegin() noexcept {
+    return reverse_iterator(end());
+}
+
+template <typename T, size_t FirstSegment, typename Allocator>
+    requires std::is_same_v<T, typename Allocator::value_type>
+typename SegmentedArray<T, FirstSegment, Allocator>::const_reverse_iterator SegmentedArray<T, FirstSegment, Allocator>::rbegin() const noexcept {
+    return const_reverse_iterator(end());
+}
+
+template <typename T, size_t FirstSegment, typename Allocator>
+    requires std::is_same_v<T, typename Allocator::value_type>
+typename SegmentedArray<T, FirstSegment, Allocator>::reverse_iterator SegmentedArray<T, FirstSegment, Allocator>::rend() noexcept {
+    return reverse_iterator(begin());
+}
+
+template <typename T, size_t FirstSegment, typename Allocator>
+    requires std::is_same_v<T, typename Allocator::value_type>
+typename SegmentedArray<T, FirstSegment, Allocator>::const_reverse_iterator SegmentedArray<T, FirstSegment, Allocator>::rend() const noexcept {
+    return const_reverse_iterator(begin());
+}
+
+// ========================== Capacity ========================================
+// ----------------------------------------------------------------------------
+
+template <typename T, size_t FirstSegment, typename Allocator>
+    requires std::is_same_v<T, typename Allocator::value_type>
+bool SegmentedArray<T, FirstSegment, Allocator>::empty() const noexcept {
+    return size_ == 0;
+}
+
+template <typename T, size_t FirstSegment, typename Allocator>
+    requires std::is_same_v<T, typename Allocator::value_type>
+typename SegmentedArray<T, FirstSegment, Allocator>::size_type SegmentedArray<T, FirstSegment, Allocator>::size() const noexcept {
+    return size_;
+}
+
+template <typename T, size_t FirstSegment, typename Allocator>
+    requires std::is_same_v<T, typename Allocator::value_type>
+typename SegmentedArray<T, FirstSegment, Allocator>::size_type SegmentedArray<T, FirstSegment, Allocator>::capacity() const noexcept {
+    return index_t::segment_begin(segment_count_);
+}
+
+template <typename T, size_t FirstSegment, typename Allocator>
+    requires std::is_same_v<T, typename Allocator::value_type>
+typename SegmentedArray<T, FirstSegment, Allocator>::size_type SegmentedArray<T, FirstSegment, Allocator>::segment_count() const noexcept {
+    return segment_count_;
+}
+
+template <typename T, size_t FirstSegment, typename Allocator>
+    requires std::is_same_v<T, typename Allocator::value_type>
+void SegmentedArray<T, FirstSegment, Allocator>::reserve(size_type new_cap) {
+    while (capacity() < new_cap) {
+        add_segment();
+    }
+}
+
+template <typename T, size_t FirstSegment, typename Allocator>
+    requires std::is_same_v<T, typename Allocator::value_type>
+void SegmentedArray<T, FirstSegment, Allocator>::shrink_to_fit() {
+    free_segments(empty() ? 0 : index_t::segment(size_ - 1) + 1);
+}
+
+// ========================== Modifiers =======================================
+// ----------------------------------------------------------------------------
+
+template <typename T, size_t FirstSegment, typename Allocator>
+    requires std::is_same_v<T, typename Allocator::value_type>
+void SegmentedArray<T, FirstSegment, Allocator>::clear() {
+    destroy_from(0);
+}
+
+template <typename T, size_t FirstSegment, typename Allocator>
+    requires std::is_same_v<T, typename Allocator::value_type>
+void SegmentedArray<T, FirstSegment, Allocator>::push_back(const value_type& value) {
+    emplace_back(value);
+}
+
+template <typename T, size_t FirstSegment, typename Allocator>
+    requires std::is_same_v<T, typename Allocator::value_type>
+void SegmentedArray<T, FirstSegment, Allocator>::push_back(value_type&& value) {
+    emplace_back(std::move(value));
+}
+
+template <typename T, size_t FirstSegment, typename Allocator>
+    requires std::is_same_v<T, typename Allocator::value_type>
+void SegmentedArray<T, FirstSegment, Allocator>::pop_back() {
+    destroy_from(size_ - 1);
+}
+
+template <typename T, size_t FirstSegment, typename Allocator>
+    requires std::is_same_v<T, typename Allocator::value_type>
+void SegmentedArray<T, FirstSegment, Allocator>::swap(SegmentedArray& other) noexcept {
+    std::swap(alloc_, other.alloc_);
+    std::swap(segments_, other.segments_);
+    std::swap(segment_count_, other.segment_count_);
+    std::swap(size_, other.size_);
+}
+
+// ----------------------------------------------------------------------------
+
+template <typename T, size_t FirstSegment, typename Allocator>
+    requires std::is_same_v<T, typename Allocator::value_type>
+void SegmentedArray<T, FirstSegment, Allocator>::add_segment() {
+    if (segment_count_ == index_t::MAX_SEGMENTS) {
+        throw std::length_error("SegmentedArray is out of segments");
+    }
+
+    segments_[segment_count_] = traits_t::allocate(alloc_, index_t::segment_size(segment_count_));
+    ++segment_count_;
+}
+
+template <typename T, size_t FirstSegment, typename Allocator>
+    requires std::is_same_v<T, typename Allocator::value_type>
+void SegmentedArray<T, FirstSegment, Allocator>::destroy_from(size_type new_size) {
+    if constexpr (!trivially_destructible<T>) {
+        for (size_type idx = new_size; idx < size_; ++idx) {
+            traits_t::destroy(alloc_, &operator[](idx));
+        }
+    }
+    size_ = new_size;
+}
+
+template <typename T, size_t FirstSegment, typename Allocator>
+    requires std::is_same_v<T, typename Allocator::value_type>
+void SegmentedArray<T, FirstSegment, Allocator>::free_segments(size_type count) {
+    while (segment_count_ > count) {
+        --segment_count_;
+        traits_t::deallocate(alloc_, segments_[segment_count_], index_t::segment_size(segment_count_));
+        segments_[segment_count_] = nullptr;
+    }
+}
+
+template <typename T, size_t FirstSegment, typename Allocator>
+    requires std::is_same_v<T, typename Allocator::value_type>
+void SegmentedArray<T, FirstSegment, Allocator>::check_range(size_type idx) const {
+    if (idx >= size_) {
+        throw std::out_of_range("SegmentedArray::check_range failed");
+    }
+}
+
+} // nostd
@@ -0,0 +1,595 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <nostd/array/growth_policy.h>
+#include <nostd/concepts/concepts.h>
+#include <nostd/storage/aligned_storage.h>
+#include <nostd/util.h>
+
+namespace nostd {
+
+// Relocation of the columns must not throw, they move one after another
+template <typename T>
+    concept soa_field =
+        std::is_object_v<T> &&
+        std::is_nothrow_move_constructible_v<T> &&
+        std::is_nothrow_destructible_v<T>;
+
+/*
+ * Structure of arrays: row i is (column<0>()[i], column<1>()[i], ...).
+ * Passes touching a few fields stream only their columns instead of
+ * whole rows, and every column is a contiguous span for simd:: kernels.
+ *
+ * All columns share one allocation, each at an offset aligned to
+ * COLUMN_ALIGNMENT, so capacity is the same for all of them and growth
+ * relocates them together. Rows are accessed through proxies, tuples of
+ * references: auto [x, y] = soa[i] binds to the fields.
+ */
+template <soa_field... Fields>
+struct SoaArray {
+    static_assert(sizeof...(Fields) > 0, "SoaArray needs at least one field");
+
+    static constexpr size_t COLUMNS = util::packSize<Fields...>;
+    // Cache line, and aligned AVX-512 loads from the start of every column
+    static constexpr size_t COLUMN_ALIGNMENT = std::max({size_t{64}, alignof(Fields)...});
+    static constexpr size_t ROW_SIZE = (sizeof(Fields) + ...);
+
+    template <size_t I>
+    using field_type = std::tuple_element_t<I, std::tuple<Fields...>>;
+
+private:
+    template <bool Const>
+    class RowIterator {
+    public:
+        // Proxy references: random access traversal, input iterator for legacy algorithms
+        using iterator_concept = std::random_access_iterator_tag;
+        using iterator_category = std::input_iterator_tag;
+        using value_type = std::tuple<Fields...>;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::conditional_t<Const, std::tuple<const Fields&...>, std::tuple<Fields&...>>;
+        using array_pointer = std::conditional_t<Const, const SoaArray*, SoaArray*>;
+
+        RowIterator() noexcept = default;
+
+        template <bool C = Const> requires C
+        RowIterator(const RowIterator<false>& other) noexcept // NOLINT
+            : array_(other.array_), idx_(other.idx_) {
+        }
+
+        reference operator*() const {
+            return (*array_)[idx_];
+        }
+
+        reference operator[](difference_type diff) const {
+            return (*array_)[idx_ + diff];
+        }
+
+        RowIterator& operator++() {
+            ++idx_;
+            return *this;
+        }
+
+        RowIterator operator++(int) {
+            RowIterator it = *this;
+            ++idx_;
+            return it;
+        }
+
+        RowIterator& operator--() {
+            --idx_;
+            return *this;
+        }
+
+        RowIterator operator--(int) {
+            RowIterator it = *this;
+            --idx_;
+            return it;
+        }
+
+        RowIterator& operator+=(difference_type diff) {
+            idx_ += diff;
+            return *this;
+        }
+
+        RowIterator& operator-=(difference_type diff) {
+            idx_ -= diff;
+            return *this;
+        }
+
+        friend RowIterator operator+(RowIterator it, difference_type diff) {
+            return it += diff;
+        }
+
+        friend RowIterator operator+(difference_type diff, RowIterator it) {
+            return it += diff;
+        }
+
+        friend RowIterator operator-(RowIterator it, difference_type diff) {
+            return it -= diff;
+        }
+
+        friend difference_type operator-(const RowIterator& lhs, const RowIterator& rhs) {
+            return static_cast<difference_type>(lhs.idx_ - rhs.idx_);
+        }
+
+        friend bool operator==(const RowIterator& lhs, const RowIterator& rhs) {
+            return lhs.idx_ == rhs.idx_;
+        }
+
+        friend auto operator<=>(const RowIterator& lhs, const RowIterator& rhs) {
+            return lhs.idx_ <=> rhs.idx_;
+        }
+
+    private:
+        friend SoaArray;
+        template <bool> friend class RowIterator;
+
+        RowIterator(array_pointer array, size_t idx) noexcept
+            : array_(array), idx_(idx) {
+        }
+
+        array_pointer array_{nullptr};
+        size_t idx_{};
+    };
+
+    using storage_t = storage::AlignedStorageImpl<std::byte, COLUMN_ALIGNMENT>;
+    using columns_t = std::tuple<Fields*...>;
+    using indices_t = std::index_sequence_for<Fields...>;
+
+public:
+    using value_type = std::tuple<Fields...>;
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = std::tuple<Fields&...>;
+    using const_reference = std::tuple<const Fields&...>;
+
+    using iterator = RowIterator<false>;
+    using const_iterator = RowIterator<true>;
+
+    // Creating
+    SoaArray() noexcept = default;
+
+    // Exception guarantees destruction of created elements
+    explicit SoaArray(size_type size);  // value-initialized rows
+
+    SoaArray(const SoaArray& other);
+    SoaArray& operator=(const SoaArray& other);
+
+    SoaArray(SoaArray&& other) noexcept;
+    SoaArray& operator=(SoaArray&& other) noexcept;
+
+    ~SoaArray();
+
+    // Access
+    [[nodiscard]] reference at(size_type idx);
+    [[nodiscard]] const_reference at(size_type idx) const;
+
+    // UNSAFE
+    [[nodiscard]] reference operator[](size_type idx);
+    [[nodiscard]] const_reference operator[](size_type idx) const;
+
+    // UNSAFE
+    [[nodiscard]] reference front();
+    [[nodiscard]] const_reference front() const;
+
+    // UNSAFE
+    [[nodiscard]] reference back();
+    [[nodiscard]] const_reference back() const;
+
+    // The size() fields of column I, aligned to COLUMN_ALIGNMENT
+    template <size_t I>
+    [[nodiscard]] std::span<field_type<I>> column() noexcept;
+    template <size_t I>
+    [[nodiscard]] std::span<const field_type<I>> column() const noexcept;
+
+    // Iterators
+    iterator begin() noexcept;
+    const_iterator begin() const noexcept;
+
+    iterator end() noexcept;
+    const_iterator end() const noexcept;
+
+    // Capacity
+    [[nodiscard]] bool empty() const noexcept;
+    [[nodiscard]] size_type size() const noexcept;
+    [[nodiscard]] size_type capacity() const noexcept;
+    [[nodiscard]] static constexpr size_type max_size() noexcept;
+    void reserve(size_type new_cap);
+    void shrink_to_fit();
+
+    // Modifiers
+    void clear();
+    // Rows past size are value-initialized
+    void resize(size_type new_size);
+    void push_back(const value_type& row);
+    void push_back(value_type&& row);
+    void pop_back();
+    void swap(SoaArray& other) noexcept;
+
+    // One argument per field, or none for a value-initialized row
+    template <typename... Args>
+        requires (sizeof...(Args) == 0 || sizeof...(Args) == COLUMNS)
+    reference emplace_back(Args&&... args) {
+        if (size_ == capacity_) {
+            emplace_back_relocate(std::forward<Args>(args)...);
+        } else {
+            construct_row(columns_, size_, indices_t{}, std::forward<Args>(args)...);
+        }
+        return (*this)[size_++];
+    }
+
+private:
+    template <typename... Args>
+    void emplace_back_relocate(Args&&... args) {
+        SoaArray new_array;
+        new_array.allocate(calc_new_cap());
+
+        // Constructed first: args may refer to a row of this array
+        construct_row(new_array.columns_, size_, indices_t{}, std::forward<Args>(args)...);
+        relocate_to(new_array);
+        swap(new_array);
+    }
+
+    // Every field or none is constructed
+    template <size_t... I, typename... Args>
+    static void construct_row(const columns_t& columns, size_type idx, std::index_sequence<I...>, Args&&... args) {
+        size_t built = 0;
+        try {
+            if constexpr (sizeof...(Args) == 0) {
+                ((std::construct_at(std::get<I>(columns) + idx), ++built), ...);
+            } else {
+                ((std::construct_at(std::get<I>(columns) + idx, std::forward<Args>(args)), ++built), ...);
+            }
+        }
+        catch (...) {
+            ((I < built ? std::destroy_at(std::get<I>(columns) + idx) : void()), ...);
+            throw;
+        }
+    }
+
+    template <size_t... I>
+    static void destroy_rows(const columns_t& columns, size_type first, size_type last, std::index_sequence<I...>) {
+        (std::destroy(std::get<I>(columns) + first, std::get<I>(columns) + last), ...);
+    }
+
+    template <size_t... I>
+    void copy_columns(const SoaArray& other, std::index_sequence<I...>) {
+        size_t built = 0;
+        try {
+            ((std::uninitialized_copy_n(std::get<I>(other.columns_), other.size_, std::get<I>(columns_)), ++built), ...);
+        }
+        catch (...) {
+            ((I < built ? void(std::destroy_n(std::get<I>(columns_), other.size_)) : void()), ...);
+            throw;
+        }
+        size_ = other.size_;
+    }
+
+    template <size_t... I>
+    void relocate_columns(SoaArray& new_array, std::index_sequence<I...>) noexcept {
+        (relocate_column(std::get<I>(columns_), std::get<I>(new_array.columns_)), ...);
+    }
+
+    template <typename T>
+    void relocate_column(T* src, T* dst) noexcept {
+        if constexpr (trivially_relocatable<T>) {
+            if (size_ != 0) {
+                std::memcpy(static_cast<void*>(dst), src, size_ * sizeof(T));
+            }
+        } else {
+            for (size_type idx = 0; idx < size_; ++idx) {
+                std::construct_at(dst + idx, std::move(src[idx]));
+                std::destroy_at(src + idx);
+            }
+        }
+    }
+
+    // Column offsets in a block of cap rows, the last one is the block size
+    [[nodiscard]] static constexpr std::array<size_type, COLUMNS + 1> layout(size_type cap) noexcept;
+
+    // Allocates the block of an empty array
+    void allocate(size_type cap);
+    // Moves the rows to the allocated, empty new_array; the rows of this one are gone
+    void relocate_to(SoaArray& new_array) noexcept;
+    void reallocate(size_type new_cap);
+
+    [[nodiscard]] size_type calc_new_cap() const;
+    void check_range(size_type idx) const;
+
+    storage_t storage_;
+    columns_t columns_{};
+    size_type size_{};
+    size_type capacity_{};
+};
+
+// ========================== Creating ========================================
+// ----------------------------------------------------------------------------
+
+template <soa_field... Fields>
+SoaArray<Fields...>::SoaArray(size_type size)
+    : SoaArray() {
+    resize(size);
+}
+
+template <soa_field... Fields>
+SoaArray<Fields...>::SoaArray(const SoaArray& other)
+    : SoaArray() {
+    if (other.empty()) {
+        return;
+    }
+
+    allocate(other.size_);
+    copy_columns(other, indices_t{});
+}
+
+template <soa_field... Fields>
+SoaArray<Fields...>& SoaArray<Fields...>::operator=(const SoaArray& other) {
+    if (this != &other) {
+        SoaArray copy(other);
+        swap(copy);
+    }
+    return *this;
+}
+
+template <soa_field... Fields>
+SoaArray<Fields...>::SoaArray(SoaArray&& other) noexcept {
+    swap(other);
+}
+
+template <soa_field... Fields>
+SoaArray<Fields...>& SoaArray<Fields...>::operator=(SoaArray&& other) noexcept {
+    if (this != &other) {
+        swap(other);
+    }
+    return *this;
+}
+
+template <soa_field... Fields>
+SoaArray<Fields...>::~SoaArray() {
+    clear();
+    storage_.deallocate();
+}
+
+// ========================== Access ==========================================
+// ----------------------------------------------------------------------------
+
+template <soa_field... Fields>
+typename SoaArray<Fields...>::reference SoaArray<Fields...>::at(size_type idx) {
+    check_range(idx);
+    return (*this)[idx];
+}
+
+template <soa_field... Fields>
+typename SoaArray<Fields...>::const_reference SoaArray<Fields...>::at(size_type idx) const {
+    check_range(idx);
+    return (*this)[idx];
+}
+
+template <soa_field... Fields>
+typename SoaArray<Fields...>::reference SoaArray<Fields...>::operator[](size_type idx) {
+    return std::apply([idx](Fields*... columns) { return reference(columns[idx]...); }, columns_);
+}
+
+template <soa_field... Fields>
+typename SoaArray<Fields...>::const_reference SoaArray<Fields...>::operator[](size_type idx) const {
+    return std::apply([idx](Fields*... columns) { return const_reference(columns[idx]...); }, columns_);
+}
+
+template <soa_field... Fields>
+typename SoaArray<Fields...>::reference SoaArray<Fields...>::front() {
+    return (*this)[0];
+}
+
+template <soa_field... Fields>
+typename SoaArray<Fields...>::const_reference SoaArray<Fields...>::front() const {
+    return (*this)[0];
+}
+
+template <soa_field... Fields>
+typename SoaArray<Fields...>::reference SoaArray<Fields...>::back() {
+    return (*this)[size_ - 1];
+}
+
+template <soa_field... Fields>
+typename SoaArray<Fields...>::const_reference SoaArray<Fields...>::back() const {
+    return (*this)[size_ - 1];
+}
+
+template <soa_field... Fields>
+template <size_t I>
+std::span<typename SoaArray<Fields...>::template field_type<I>> SoaArray<Fields...>::column() noexcept {
+    return {std::get<I>(columns_), size_};
+}
+
+template <soa_field... Fields>
+template <size_t I>
+std::span<const typename SoaArray<Fields...>::template field_type<I>> SoaArray<Fields...>::column() const noexcept {
+    return {std::get<I>(columns_), size_};
+}
+
+// ========================== Iterators =======================================
+// ----------------------------------------------------------------------------
+
+template <soa_field... Fields>
+typename SoaArray<Fields...>::iterator SoaArray<Fields...>::begin() noexcept {
+    return {this, 0};
+}
+
+template <soa_field... Fields>
+typename SoaArray<Fields...>::const_iterator SoaArray<Fields...>::begin() const noexcept {
+    return {this, 0};
+}
+
+template <soa_field... Fields>
+typename SoaArray<Fields...>::iterator SoaArray<Fields...>::end() noexcept {
+    return {this, size_};
+}
+
+template <soa_field... Fields>
+typename SoaArray<Fields...>::const_iterator SoaArray<Fields...>::end() const noexcept {
+    return {this, size_};
+}
+
+// ========================== Capacity ========================================
+// ----------------------------------------------------------------------------
+
+template <soa_field... Fields>
+bool SoaArray<Fields...>::empty() const noexcept {
+    return size_ == 0;
+}
+
+template <soa_field... Fields>
+typename SoaArray<Fields...>::size_type SoaArray<Fields...>::size() const noexcept {
+    return size_;
+}
+
+template <soa_field... Fields>
+typename SoaArray<Fields...>::size_type SoaArray<Fields...>::capacity() const noexcept {
+    return capacity_;
+}
+
+template <soa_field... Fields>
+constexpr typename SoaArray<Fields...>::size_type SoaArray<Fields...>::max_size() noexcept {
+    // Leaves room for the alignment gaps between the columns
+    return (SIZE_MAX / 2 - COLUMNS * COLUMN_ALIGNMENT) / ROW_SIZE;
+}
+
+template <soa_field... Fields>
+void SoaArray<Fields...>::reserve(size_type new_cap) {
+    if (new_cap > capacity_) {
+        reallocate(new_cap);
+    }
+}
+
+template <soa_field... Fields>
+void SoaArray<Fields...>::shrink_to_fit() {
+    if (size_ < capacity_) {
+        reallocate(size_);
+    }
+}
+
+// ========================== Modifiers =======================================
+// ----------------------------------------------------------------------------
+
+template <soa_field... Fields>
+void SoaArray<Fields...>::clear() {
+    destroy_rows(columns_, 0, size_, indices_t{});
+    size_ = 0;
+}
+
+template <soa_field... Fields>
+void SoaArray<Fields...>::resize(size_type new_size) {
+    if (new_size <= size_) {
+        destroy_rows(columns_, new_size, size_, indices_t{});
+        size_ = new_size;
+        return;
+    }
+
+    reserve(new_size);
+    while (size_ < new_size) {
+        construct_row(columns_, size_, indices_t{});
+        ++size_;
+    }
+}
+
+template <soa_field... Fields>
+void SoaArray<Fields...>::push_back(const value_type& row) {
+    std::apply([this](const Fields&... fields) { emplace_back(fields...); }, row);
+}
+
+template <soa_field... Fields>
+void SoaArray<Fields...>::push_back(value_type&& row) {
+    std::apply([this](Fields&... fields) { emplace_back(std::move(fields)...); }, row);
+}
+
+template <soa_field... Fields>
+void SoaArray<Fields...>::pop_back() {
+    destroy_rows(columns_, size_ - 1, size_, indices_t{});
+    --size_;
+}
+
+template <soa_field... Fields>
+void SoaArray<Fields...>::swap(SoaArray& other) noexcept {
+    storage_.swap(other.storage_);
+    std::swap(columns_, other.columns_);
+    std::swap(size_, other.size_);
+    std::swap(capacity_, other.capacity_);
+}
+
+// ----------------------------------------------------------------------------
+
+template <soa_field... Fields>
+constexpr std::array<typename SoaArray<Fields...>::size_type, SoaArray<Fields...>::COLUMNS + 1>
+SoaArray<Fields...>::layout(size_type cap) noexcept {
+    constexpr std::array<size_type, COLUMNS> SIZES{sizeof(Fields)...};
+
+    std::array<size_type, COLUMNS + 1> offsets{};
+    size_type offset = 0;
+    for (size_type column = 0; column < COLUMNS; ++column) {
+        offsets[column] = offset;
+        offset += cap * SIZES[column];
+        offset = (offset + COLUMN_ALIGNMENT - 1) / COLUMN_ALIGNMENT * COLUMN_ALIGNMENT;
+    }
+    offsets[COLUMNS] = offset;
+    return offsets;
+}
+
+template <soa_field... Fields>
+void SoaArray<Fields...>::allocate(size_type cap) {
+    if (cap > max_size()) {
+        throw std::length_error("SoaArray: capacity exceeds max_size");
+    }
+    if (cap == 0) {
+        return;
+    }
+
+    const auto offsets = layout(cap);
+    storage_.allocate(offsets[COLUMNS]);
+    std::byte* block = &storage_[0];
+    columns_ = [&]<size_t... I>(std::index_sequence<I...>) {
+        return columns_t(reinterpret_cast<Fields*>(block + offsets[I])...);
+    }(indices_t{});
+    capacity_ = cap;
+}
+
+template <soa_field... Fields>
+void SoaArray<Fields...>::relocate_to(SoaArray& new_array) noexcept {
+    relocate_columns(new_array, indices_t{});
+    new_array.size_ += size_;
+    size_ = 0;
+}
+
+template <soa_field... Fields>
+void SoaArray<Fields...>::reallocate(size_type new_cap) {
+    SoaArray new_array;
+    new_array.allocate(new_cap);
+    relocate_to(new_array);
+    swap(new_array);
+}
+
+template <soa_field... Fields>
+typename SoaArray<Fields...>::size_type SoaArray<Fields...>::calc_new_cap() const {
+    return growth::Doubling::next_capacity(capacity_, ROW_SIZE);
+}
+
+template <soa_field... Fields>
+void SoaArray<Fields...>::check_range(size_type idx) const {
+    if (idx >= size_) {
+        throw std::out_of_range("SoaArray::check_range failed");
+    }
+}
+
+} // nostd
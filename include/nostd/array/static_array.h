@@ -0,0 +1,400 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include <nostd/storage/local_storage.h>
+
+namespace nostd {
+
+namespace overflow {
+
+/*
+ * Overflow policy requirements:
+
+ * static void on_overflow();
+   called when an element does not fit, if it returns the
+   insertion is dropped and reports false
+ */
+
+struct Throw {
+    [[noreturn]] static void on_overflow() {
+        throw std::length_error("StaticArray capacity exceeded");
+    }
+};
+
+struct Abort {
+    [[noreturn]] static void on_overflow() noexcept {
+        std::abort();
+    }
+};
+
+struct ReturnFalse {
+    static constexpr void on_overflow() noexcept {
+    }
+};
+
+} // nostd::overflow
+
+// ============================================================================
+
+/*
+ * Array with fixed capacity N kept inside the object, never allocates.
+ * Move and swap are element-wise, O(n).
+ */
+template <typename T, size_t N, typename Overflow = overflow::Throw>
+struct StaticArray {
+    using value_type = T;
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using pointer = value_type*;
+    using const_pointer = const value_type*;
+
+    using iterator = pointer;
+    using const_iterator = const_pointer;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    // Creating
+    constexpr StaticArray() noexcept = default;
+
+    // Elements past N go to the overflow policy, ReturnFalse drops them
+    constexpr explicit StaticArray(size_type size);
+    constexpr StaticArray(size_type size, const value_type& val);
+    constexpr StaticArray(std::initializer_list<value_type> list);
+
+    constexpr StaticArray(const StaticArray& other);
+    constexpr StaticArray& operator=(const StaticArray& other);
+
+    // Moved-from array is left empty
+    constexpr StaticArray(StaticArray&& other) noexcept(std::is_nothrow_move_constructible_v<T>);
+    constexpr StaticArray& operator=(StaticArray&& other) noexcept(std::is_nothrow_move_constructible_v<T>);
+
+    constexpr ~StaticArray();
+
+    // Access
+    [[nodiscard]] constexpr reference at(size_type idx);
+    [[nodiscard]] constexpr const_reference at(size_type idx) const;
+
+    // UNSAFE
+    [[nodiscard]] constexpr reference operator[](size_type idx);
+    [[nodiscard]] constexpr const_reference operator[](size_type idx) const;
+
+    // UNSAFE
+    [[nodiscard]] constexpr reference front();
+    [[nodiscard]] constexpr const_reference front() const;
+
+    // UNSAFE
+    [[nodiscard]] constexpr reference back();
+    [[nodiscard]] constexpr const_reference back() const;
+
+    // Iterators
+    constexpr iterator begin() noexcept;
+    constexpr const_iterator begin() const noexcept;
+
+    constexpr iterator end() noexcept;
+    constexpr const_iterator end() const noexcept;
+
+    constexpr reverse_iterator rbegin() noexcept;
+    constexpr const_reverse_iterator rbegin() const noexcept;
+
+    constexpr reverse_iterator rend() noexcept;
+    constexpr const_reverse_iterator rend() const noexcept;
+
+    // Capacity
+    [[nodiscard]] constexpr bool empty() const noexcept;
+    [[nodiscard]] constexpr bool full() const noexcept;
+    [[nodiscard]] constexpr size_type size() const noexcept;
+    [[nodiscard]] static constexpr size_type capacity() noexcept;
+    constexpr pointer data() noexcept;
+    constexpr const_pointer data() const noexcept;
+
+    // Modifiers, false if the element did not fit
+    constexpr void clear();
+    constexpr bool push_back(const value_type& value);
+    constexpr bool push_back(value_type&& value);
+    constexpr void pop_back();
+    // A throwing move leaves both sizes, the swapped prefix may stay swapped
+    constexpr void swap(StaticArray& other);
+
+    template<typename... Args>
+    constexpr bool emplace_back(Args &&... args) {
+        if (full()) {
+            Overflow::on_overflow();
+            return false;
+        }
+
+        storage_.construct(size_, std::forward<Args>(args)...);
+        ++size_;
+        return true;
+    }
+
+private:
+    constexpr void check_range(size_type idx) const;
+
+    storage::LocalStorageImpl<T, N> storage_;
+    size_type size_{};
+};
+
+// ========================== Creating ========================================
+// ----------------------------------------------------------------------------
+
+template <typename T, size_t N, typename Overflow>
+constexpr StaticArray<T, N, Overflow>::StaticArray(size_type size)
+    : StaticArray(size, T()) {
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr StaticArray<T, N, Overflow>::StaticArray(size_type size, const value_type& val) {
+    try {
+        for (size_type idx = 0; idx < size && emplace_back(val); ++idx) {
+        }
+    }
+    catch (...) {
+        clear();
+        throw;
+    }
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr StaticArray<T, N, Overflow>::StaticArray(std::initializer_list<value_type> list) {
+    try {
+        for (auto it = list.begin(); it != list.end() && emplace_back(*it); ++it) {
+        }
+    }
+    catch (...) {
+        clear();
+        throw;
+    }
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr StaticArray<T, N, Overflow>::StaticArray(const StaticArray& other) {
+    try {
+        for (; size_ < other.size(); ++size_) {
+            storage_.construct(size_, other[size_]);
+        }
+    }
+    catch (...) {
+        clear();
+        throw;
+    }
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr StaticArray<T, N, Overflow>& StaticArray<T, N, Overflow>::operator=(const StaticArray& other) {
+    if (this == &other) {
+        return *this;
+    }
+
+    StaticArray tmp(other);
+    swap(tmp);
+
+    return *this;
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr StaticArray<T, N, Overflow>::StaticArray(StaticArray&& other)
+    noexcept(std::is_nothrow_move_constructible_v<T>) {
+    try {
+        for (; size_ < other.size(); ++size_) {
+            storage_.construct(size_, std::move(other[size_]));
+        }
+    }
+    catch (...) {
+        clear();
+        throw;
+    }
+    other.clear();
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr StaticArray<T, N, Overflow>& StaticArray<T, N, Overflow>::operator=(StaticArray&& other)
+    noexcept(std::is_nothrow_move_constructible_v<T>) {
+    if (this == &other) {
+        return *this;
+    }
+
+    clear();
+    for (; size_ < other.size(); ++size_) {
+        storage_.construct(size_, std::move(other[size_]));
+    }
+    other.clear();
+
+    return *this;
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr StaticArray<T, N, Overflow>::~StaticArray() {
+    clear();
+}
+
+// ========================== Access =======================================
+// ----------------------------------------------------------------------------
+
+template <typename T, size_t N, typename Overflow>
+constexpr typename StaticArray<T, N, Overflow>::reference StaticArray<T, N, Overflow>::at(size_type idx) {
+    check_range(idx);
+    return operator[](idx);
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr typename StaticArray<T, N, Overflow>::const_reference StaticArray<T, N, Overflow>::at(size_type idx) const {
+    check_range(idx);
+    return operator[](idx);
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr typename StaticArray<T, N, Overflow>::reference StaticArray<T, N, Overflow>::operator[](size_type idx) {
+    return storage_[idx];
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr typename StaticArray<T, N, Overflow>::const_reference StaticArray<T, N, Overflow>::operator[](size_type idx) const {
+    return storage_[idx];
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr typename StaticArray<T, N, Overflow>::reference StaticArray<T, N, Overflow>::front() {
+    return operator[](0);
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr typename StaticArray<T, N, Overflow>::const_reference StaticArray<T, N, Overflow>::front() const {
+    return operator[](0);
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr typename StaticArray<T, N, Overflow>::reference StaticArray<T, N, Overflow>::back() {
+    return operator[](size_ - 1);
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr typename StaticArray<T, N, Overflow>::const_reference StaticArray<T, N, Overflow>::back() const {
+    return operator[](size_ - 1);
+}
+
+// ========================== Iterators =======================================
+// ----------------------------------------------------------------------------
+
+template <typename T, size_t N, typename Overflow>
+constexpr typename StaticArray<T, N, Overflow>::iterator StaticArray<T, N, Overflow>::begin() noexcept {
+    return data();
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr typename StaticArray<T, N, Overflow>::const_iterator StaticArray<T, N, Overflow>::begin() const noexcept {
+    return data();
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr typename StaticArray<T, N, Overflow>::iterator StaticArray<T, N, Overflow>::end() noexcept {
+    return data() + size_;
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr typename StaticArray<T, N, Overflow>::const_iterator StaticArray<T, N, Overflow>::end() const noexcept {
+    return data() + size_;
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr typename StaticArray<T, N, Overflow>::reverse_iterator StaticArray<T, N, Overflow>::rbegin() noexcept {
+    return reverse_iterator(end());
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr typename StaticArray<T, N, Overflow>::const_reverse_iterator StaticArray<T, N, Overflow>::rbegin() const noexcept {
+    return const_reverse_iterator(end());
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr typename StaticArray<T, N, Overflow>::reverse_iterator StaticArray<T, N, Overflow>::rend() noexcept {
+    return reverse_iterator(begin());
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr typename StaticArray<T, N, Overflow>::const_reverse_iterator StaticArray<T, N, Overflow>::rend() const noexcept {
+    return const_reverse_iterator(begin());
+}
+
+// ========================== Capacity ========================================
+// ----------------------------------------------------------------------------
+
+template <typename T, size_t N, typename Overflow>
+constexpr bool StaticArray<T, N, Overflow>::empty() const noexcept {
+    return size_ == 0;
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr bool StaticArray<T, N, Overflow>::full() const noexcept {
+    return size_ == N;
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr typename StaticArray<T, N, Overflow>::size_type StaticArray<T, N, Overflow>::size() const noexcept {
+    return size_;
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr typename StaticArray<T, N, Overflow>::size_type StaticArray<T, N, Overflow>::capacity() noexcept {
+    return N;
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr typename StaticArray<T, N, Overflow>::pointer StaticArray<T, N, Overflow>::data() noexcept {
+    return &storage_[0];
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr typename StaticArray<T, N, Overflow>::const_pointer StaticArray<T, N, Overflow>::data() const noexcept {
+    return &storage_[0];
+}
+
+// ========================== Modifiers =======================================
+// ----------------------------------------------------------------------------
+
+template <typename T, size_t N, typename Overflow>
+constexpr void StaticArray<T, N, Overflow>::clear() {
+    while (!empty()) {
+        pop_back();
+    }
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr bool StaticArray<T, N, Overflow>::push_back(const value_type& value) {
+    return emplace_back(value);
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr bool StaticArray<T, N, Overflow>::push_back(value_type&& value) {
+    return emplace_back(std::move(value));
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr void StaticArray<T, N, Overflow>::pop_back() {
+    storage_.destruct(--size_);
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr void StaticArray<T, N, Overflow>::swap(StaticArray& other) {
+    storage_.swap(other.storage_, size_, other.size_);
+    std::swap(size_, other.size_);
+}
+
+// ----------------------------------------------------------------------------
+
+template <typename T, size_t N, typename Overflow>
+constexpr void StaticArray<T, N, Overflow>::check_range(size_type idx) const {
+    if (idx >= size()) {
+        throw std::out_of_range("StaticArray::check_range failed");
+    }
+}
+
+} // nostd
@@ -0,0 +1,648 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+#include <nostd/array/array.h>
+#include <nostd/simd/simd.h>
+#include <nostd/util.h>
+
+namespace nostd::bits {
+
+/*
+ * Compressed set of 64-bit positions, in the layout of Roaring
+ * (Lemire et al.: "Consistently faster and smaller compressed bitmaps
+ * with Roaring").
+ *
+ * Positions are split in chunks of 2^16 by their high bits, a chunk with
+ * set positions keeps their low 16 bits in one of three containers:
+ * a sorted array (up to ARRAY_MAX values), a bitset of 1024 words or
+ * sorted runs. Chunks come from Array<bool> in their smallest container.
+ *
+ * & and | merge the chunk keys and pick the kernel per container pair:
+ * bitsets go through simd::bit_kernels(), arrays are merged or probed,
+ * runs are intersected and merged as intervals. Results are arrays or
+ * bitsets by cardinality, optimize() brings runs back where smaller.
+ */
+class CompressedBitmap {
+public:
+    using value_type = uint64_t;
+    using size_type = size_t;
+
+    static constexpr size_type CHUNK_BITS = size_type{1} << 16;
+    static constexpr size_type ARRAY_MAX = 4096;
+
+    CompressedBitmap() noexcept = default;
+    template <template <typename> typename Storage, typename Growth>
+    explicit CompressedBitmap(const Array<bool, Storage, Growth>& bits);
+
+    // Bits [0, size) of the set, positions past it are dropped
+    [[nodiscard]] Array<bool> to_bits(size_type size) const;
+
+    // Modifiers
+    void add(value_type value);
+    void clear() noexcept;
+    // Moves every chunk to its smallest container, runs included
+    void optimize();
+
+    // Queries
+    [[nodiscard]] bool contains(value_type value) const;
+    [[nodiscard]] size_type cardinality() const noexcept;
+    [[nodiscard]] bool empty() const noexcept;
+    // Bytes held by the set and its containers
+    [[nodiscard]] size_type memory_bytes() const noexcept;
+
+    // Calls fn(position) for the set positions, in increasing order
+    template <typename F>
+    void for_each(F&& fn) const;
+
+    // Set operations
+    CompressedBitmap& operator&=(const CompressedBitmap& other);
+    CompressedBitmap& operator|=(const CompressedBitmap& other);
+    friend CompressedBitmap operator&(const CompressedBitmap& lhs, const CompressedBitmap& rhs);
+    friend CompressedBitmap operator|(const CompressedBitmap& lhs, const CompressedBitmap& rhs);
+
+private:
+    static constexpr size_type CHUNK_WORDS = CHUNK_BITS / 64;
+
+    enum class Kind : uint8_t {
+        Array,
+        Bitset,
+        Run,
+    };
+
+    struct Container {
+        Kind kind = Kind::Array;
+        uint32_t cardinality = 0;
+        nostd::Array<uint16_t> values;  // Array: sorted values, Run: first, last of each run
+        nostd::Array<uint64_t> words;   // Bitset: CHUNK_WORDS words
+    };
+
+    using words_t = std::array<uint64_t, CHUNK_WORDS>;
+
+    // Containers out of a chunk of words
+    static Container make_array(const uint64_t* words, size_type cardinality);
+    static Container make_bitset(const uint64_t* words, size_type cardinality);
+    static Container make_runs(const uint64_t* words, size_type runs, size_type cardinality);
+    // The smallest one, runs only if allowed
+    static Container from_words(const uint64_t* words, bool runs);
+    // A bitset of no more than ARRAY_MAX values becomes an array
+    static void settle(Container& container);
+
+    // Words of the container, expanded into buffer unless it is a bitset
+    static const uint64_t* words_of(const Container& container, words_t& buffer);
+    static void or_into(const Container& container, uint64_t* words);
+    static bool container_contains(const Container& container, uint16_t low);
+    static size_type runs_of(const uint64_t* words);
+
+    static Container container_and(const Container& lhs, const Container& rhs);
+    static Container container_or(const Container& lhs, const Container& rhs);
+    static Container array_and(const Container& lhs, const Container& rhs);
+    static Container array_or(const Container& lhs, const Container& rhs);
+    static Container array_filter(const Container& array, const Container& other);
+    static Container run_and(const Container& lhs, const Container& rhs);
+    static Container run_or(const Container& lhs, const Container& rhs);
+
+    // Index of the chunk, inserted empty if missing
+    size_type chunk(uint64_t key);
+
+    Array<uint64_t> keys_;  // sorted chunk keys, position >> 16
+    Array<Container> containers_;
+};
+
+// ========================== Creating ========================================
+// ----------------------------------------------------------------------------
+
+template <template <typename> typename Storage, typename Growth>
+CompressedBitmap::CompressedBitmap(const Array<bool, Storage, Growth>& bits) {
+    const uint64_t* words = bits.data();
+    const size_type word_count = util::CeilDiv(bits.size(), size_type{64});
+    const auto& kernels = simd::bit_kernels();
+
+    words_t buffer;
+    for (size_type first = 0; first < word_count; first += CHUNK_WORDS) {
+        const uint64_t* chunk = words + first;
+        if (word_count - first < CHUNK_WORDS) {
+            // The last chunk is partial, zero padded
+            buffer.fill(0);
+            std::memcpy(buffer.data(), chunk, (word_count - first) * sizeof(uint64_t));
+            chunk = buffer.data();
+        }
+        if (kernels.find_nonzero(chunk, CHUNK_WORDS) == CHUNK_WORDS) {
+            continue;
+        }
+
+        keys_.push_back(first / CHUNK_WORDS);
+        containers_.push_back(from_words(chunk, true));
+    }
+    keys_.shrink_to_fit();
+    containers_.shrink_to_fit();
+}
+
+inline Array<bool> CompressedBitmap::to_bits(size_type size) const {
+    Array<bool> bits(size, false);
+    const size_type word_count = util::CeilDiv(size, size_type{64});
+
+    words_t buffer;
+    for (size_type idx = 0; idx < keys_.size() && keys_[idx] * CHUNK_WORDS < word_count; ++idx) {
+        const size_type first = keys_[idx] * CHUNK_WORDS;
+        const uint64_t* words = words_of(containers_[idx], buffer);
+        std::memcpy(bits.data() + first, words, std::min(CHUNK_WORDS, word_count - first) * sizeof(uint64_t));
+    }
+    if (size % 64 != 0) {
+        // Bits past size() stay zero
+        bits.data()[word_count - 1] &= (uint64_t{1} << (size % 64)) - 1;
+    }
+    return bits;
+}
+
+// ========================== Modifiers =======================================
+// ----------------------------------------------------------------------------
+
+inline void CompressedBitmap::add(value_type value) {
+    Container& container = containers_[chunk(value >> 16)];
+    const auto low = static_cast<uint16_t>(value);
+
+    switch (container.kind) {
+        case Kind::Array: {
+            auto& values = container.values;
+            const auto pos = std::lower_bound(values.begin(), values.end(), low) - values.begin();
+            if (pos != static_cast<std::ptrdiff_t>(values.size()) && values[pos] == low) {
+                return;
+            }
+            values.push_back(low);
+            std::rotate(values.begin() + pos, values.end() - 1, values.end());
+            if (++container.cardinality > ARRAY_MAX) {
+                words_t words{};
+                or_into(container, words.data());
+                container = make_bitset(words.data(), container.cardinality);
+            }
+            break;
+        }
+        case Kind::Bitset: {
+            uint64_t& word = container.words[low / 64];
+            const uint64_t bit = uint64_t{1} << (low % 64);
+            container.cardinality += (word & bit) == 0 ? 1 : 0;
+            word |= bit;
+            break;
+        }
+        case Kind::Run: {
+            if (container_contains(container, low)) {
+                return;
+            }
+            ++container.cardinality;
+
+            // Runs are first, last pairs: next is the first run past low
+            auto& runs = container.values;
+            size_type next = 0;
+            while (next < runs.size() / 2 && runs[2 * next] < low) {
+                ++next;
+            }
+            const bool extends_prev = next > 0 && runs[2 * next - 1] + 1 == low;
+            const bool extends_next = next < runs.size() / 2 && runs[2 * next] == low + 1;
+            if (extends_prev && extends_next) {
+                // low joins two runs
+                runs[2 * next - 1] = runs[2 * next + 1];
+                std::rotate(runs.begin() + 2 * next, runs.begin() + 2 * next + 2, runs.end());
+                runs.pop_back();
+                runs.pop_back();
+            } else if (extends_prev) {
+                runs[2 * next - 1] = low;
+            } else if (extends_next) {
+                runs[2 * next] = low;
+            } else {
+                runs.push_back(low);
+                runs.push_back(low);
+                std::rotate(runs.begin() + 2 * next, runs.end() - 2, runs.end());
+            }
+            break;
+        }
+    }
+}
+
+inline void CompressedBitmap::clear() noexcept {
+    keys_.clear();
+    containers_.clear();
+}
+
+inline void CompressedBitmap::optimize() {
+    words_t buffer;
+    for (auto& container: containers_) {
+        container = from_words(words_of(container, buffer), true);
+    }
+}
+
+// ========================== Queries =========================================
+// ----------------------------------------------------------------------------
+
+inline bool CompressedBitmap::contains(value_type value) const {
+    const auto key = std::lower_bound(keys_.begin(), keys_.end(), value >> 16);
+    if (key == keys_.end() || *key != value >> 16) {
+        return false;
+    }
+    return container_contains(containers_[key - keys_.begin()], static_cast<uint16_t>(value));
+}
+
+inline CompressedBitmap::size_type CompressedBitmap::cardinality() const noexcept {
+    size_type result = 0;
+    for (const auto& container: containers_) {
+        result += container.cardinality;
+    }
+    return result;
+}
+
+inline bool CompressedBitmap::empty() const noexcept {
+    return keys_.empty();
+}
+
+inline CompressedBitmap::size_type CompressedBitmap::memory_bytes() const noexcept {
+    size_type result = sizeof(*this) + keys_.capacity() * sizeof(uint64_t) + containers_.capacity() * sizeof(Container);
+    for (const auto& container: containers_) {
+        result += container.values.capacity() * sizeof(uint16_t) + container.words.capacity() * sizeof(uint64_t);
+    }
+    return result;
+}
+
+template <typename F>
+void CompressedBitmap::for_each(F&& fn) const {
+    for (size_type idx = 0; idx < keys_.size(); ++idx) {
+        const value_type base = keys_[idx] << 16;
+        const Container& container = containers_[idx];
+
+        switch (container.kind) {
+            case Kind::Array:
+                for (uint16_t low: container.values) {
+                    fn(base + low);
+                }
+                break;
+            case Kind::Bitset:
+                for (size_type word = 0; word < CHUNK_WORDS; ++word) {
+                    for (uint64_t bits = container.words[word]; bits != 0; bits &= bits - 1) {
+                        fn(base + word * 64 + std::countr_zero(bits));
+                    }
+                }
+                break;
+            case Kind::Run:
+                for (size_type run = 0; run < container.values.size(); run += 2) {
+                    for (value_type low = container.values[run]; low <= container.values[run + 1]; ++low) {
+                        fn(base + low);
+                    }
+                }
+                break;
+        }
+    }
+}
+
+// ========================== Set operations ==================================
+// ----------------------------------------------------------------------------
+
+inline CompressedBitmap& CompressedBitmap::operator&=(const CompressedBitmap& other) {
+    *this = *this & other;
+    return *this;
+}
+
+inline CompressedBitmap& CompressedBitmap::operator|=(const CompressedBitmap& other) {
+    *this = *this | other;
+    return *this;
+}
+
+inline CompressedBitmap operator&(const CompressedBitmap& lhs, const CompressedBitmap& rhs) {
+    CompressedBitmap result;
+    size_t left = 0;
+    size_t right = 0;
+    while (left < lhs.keys_.size() && right < rhs.keys_.size()) {
+        if (lhs.keys_[left] < rhs.keys_[right]) {
+            ++left;
+        } else if (rhs.keys_[right] < lhs.keys_[left]) {
+            ++right;
+        } else {
+            auto container = CompressedBitmap::container_and(lhs.containers_[left], rhs.containers_[right]);
+            if (container.cardinality != 0) {
+                result.keys_.push_back(lhs.keys_[left]);
+                result.containers_.push_back(std::move(container));
+            }
+            ++left;
+            ++right;
+        }
+    }
+    return result;
+}
+
+inline CompressedBitmap operator|(const CompressedBitmap& lhs, const CompressedBitmap& rhs) {
+    CompressedBitmap result;
+    result.keys_.reserve(lhs.keys_.size() + rhs.keys_.size());
+    size_t left = 0;
+    size_t right = 0;
+    while (left < lhs.keys_.size() || right < rhs.keys_.size()) {
+        if (right == rhs.keys_.size() || (left < lhs.keys_.size() && lhs.keys_[left] < rhs.keys_[right])) {
+            result.keys_.push_back(lhs.keys_[left]);
+            result.containers_.push_back(lhs.containers_[left++]);
+        } else if (left == lhs.keys_.size() || rhs.keys_[right] < lhs.keys_[left]) {
+            result.keys_.push_back(rhs.keys_[right]);
+            result.containers_.push_back(rhs.containers_[right++]);
+        } else {
+            result.keys_.push_back(lhs.keys_[left]);
+            result.containers_.push_back(CompressedBitmap::container_or(lhs.containers_[left++], rhs.containers_[right++]));
+        }
+    }
+    return result;
+}
+
+// ========================== Containers ======================================
+// ----------------------------------------------------------------------------
+
+inline CompressedBitmap::Container CompressedBitmap::make_array(const uint64_t* words, size_type cardinality) {
+    Container result{Kind::Array, static_cast<uint32_t>(cardinality), {}, {}};
+    result.values.reserve(cardinality);
+    for (size_type word = 0; word < CHUNK_WORDS; ++word) {
+        for (uint64_t bits = words[word]; bits != 0; bits &= bits - 1) {
+            result.values.push_back(static_cast<uint16_t>(word * 64 + std::countr_zero(bits)));
+        }
+    }
+    return result;
+}
+
+inline CompressedBitmap::Container CompressedBitmap::make_bitset(const uint64_t* words, size_type cardinality) {
+    Container result{Kind::Bitset, static_cast<uint32_t>(cardinality), {}, nostd::Array<uint64_t>(CHUNK_WORDS)};
+    std::memcpy(result.words.data(), words, CHUNK_WORDS * sizeof(uint64_t));
+    return result;
+}
+
+inline CompressedBitmap::Container CompressedBitmap::make_runs(const uint64_t* words, size_type runs, size_type cardinality) {
+    Container result{Kind::Run, static_cast<uint32_t>(cardinality), {}, {}};
+    result.values.reserve(2 * runs);
+
+    size_type word = 0;
+    uint64_t bits = words[0];
+    while (true) {
+        // The next set bit starts a run
+        while (bits == 0 && ++word < CHUNK_WORDS) {
+            bits = words[word];
+        }
+        if (word == CHUNK_WORDS) {
+            break;
+        }
+        const size_type first = word * 64 + std::countr_zero(bits);
+
+        // The next clear bit ends it
+        bits = ~words[word] & (~uint64_t{0} << (first % 64));
+        while (bits == 0 && ++word < CHUNK_WORDS) {
+            bits = ~words[word];
+        }
+        const size_type end = word == CHUNK_WORDS ? CHUNK_BITS : word * 64 + std::countr_zero(bits);
+        result.values.push_back(static_cast<uint16_t>(first));
+        result.values.push_back(static_cast<uint16_t>(end - 1));
+        if (word == CHUNK_WORDS) {
+            break;
+        }
+        bits = words[word] & (~uint64_t{0} << (end % 64));
+    }
+    return result;
+}
+
+inline CompressedBitmap::Container CompressedBitmap::from_words(const uint64_t* words, bool runs) {
+    const size_type cardinality = simd::bit_kernels().popcount(words, CHUNK_WORDS);
+    const size_type bytes = cardinality <= ARRAY_MAX ? cardinality * sizeof(uint16_t) : CHUNK_WORDS * sizeof(uint64_t);
+    if (runs) {
+        const size_type run_count = runs_of(words);
+        if (run_count * 2 * sizeof(uint16_t) < bytes) {
+            return make_runs(words, run_count, cardinality);
+        }
+    }
+    return cardinality <= ARRAY_MAX ? make_array(words, cardinality) : make_bitset(words, cardinality);
+}
+
+inline void CompressedBitmap::settle(Container& container) {
+    if (container.kind == Kind::Bitset && container.cardinality <= ARRAY_MAX) {
+        container = make_array(container.words.data(), container.cardinality);
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+inline const uint64_t* CompressedBitmap::words_of(const Container& container, words_t& buffer) {
+    if (container.kind == Kind::Bitset) {
+        return container.words.data();
+    }
+    buffer.fill(0);
+    or_into(container, buffer.data());
+    return buffer.data();
+}
+
+inline void CompressedBitmap::or_into(const Container& container, uint64_t* words) {
+    switch (container.kind) {
+        case Kind::Array:
+            for (uint16_t low: container.values) {
+                words[low / 64] |= uint64_t{1} << (low % 64);
+            }
+            break;
+        case Kind::Bitset:
+            simd::bit_kernels().bit_or(words, container.words.data(), CHUNK_WORDS);
+            break;
+        case Kind::Run:
+            for (size_type run = 0; run < container.values.size(); run += 2) {
+                const size_type first = container.values[run];
+                const size_type last = container.values[run + 1];
+                const uint64_t head = ~uint64_t{0} << (first % 64);
+                const uint64_t tail = ~uint64_t{0} >> (63 - last % 64);
+                if (first / 64 == last / 64) {
+                    words[first / 64] |= head & tail;
+                    continue;
+                }
+                words[first / 64] |= head;
+                for (size_type word = first / 64 + 1; word < last / 64; ++word) {
+                    words[word] = ~uint64_t{0};
+                }
+                words[last / 64] |= tail;
+            }
+            break;
+    }
+}
+
+inline bool CompressedBitmap::container_contains(const Container& container, uint16_t low) {
+    switch (container.kind) {
+        case Kind::Array:
+            return std::binary_search(container.values.begin(), container.values.end(), low);
+        case Kind::Bitset:
+            return (container.words[low / 64] >> (low % 64)) & 1;
+        case Kind::Run: {
+            // The last run starting at or before low
+            size_type lo = 0;
+            size_type hi = container.values.size() / 2;
+            while (lo < hi) {
+                const size_type mid = lo + (hi - lo) / 2;
+                if (container.values[2 * mid] <= low) {
+                    lo = mid + 1;
+                } else {
+                    hi = mid;
+                }
+            }
+            return lo > 0 && low <= container.values[2 * lo - 1];
+        }
+    }
+    return false;
+}
+
+inline CompressedBitmap::size_type CompressedBitmap::runs_of(const uint64_t* words) {
+    // A run starts at a set bit whose lower neighbour is clear
+    size_type runs = 0;
+    uint64_t carry = 0;
+    for (size_type word = 0; word < CHUNK_WORDS; ++word) {
+        runs += std::popcount(words[word] & ~((words[word] << 1) | carry));
+        carry = words[word] >> 63;
+    }
+    return runs;
+}
+
+// ----------------------------------------------------------------------------
+
+inline CompressedBitmap::Container CompressedBitmap::container_and(const Container& lhs, const Container& rhs) {
+    if (lhs.kind == Kind::Run && rhs.kind == Kind::Run) {
+        return run_and(lhs, rhs);
+    }
+    if (lhs.kind == Kind::Array && rhs.kind == Kind::Array) {
+        return array_and(lhs, rhs);
+    }
+    if (lhs.kind == Kind::Array) {
+        return array_filter(lhs, rhs);
+    }
+    if (rhs.kind == Kind::Array) {
+        return array_filter(rhs, lhs);
+    }
+
+    // Bitsets and runs, word by word
+    const auto& kernels = simd::bit_kernels();
+    words_t buffer;
+    Container result = lhs.kind == Kind::Bitset ? lhs : make_bitset(words_of(lhs, buffer), 0);
+    kernels.bit_and(result.words.data(), words_of(rhs, buffer), CHUNK_WORDS);
+    result.cardinality = static_cast<uint32_t>(kernels.popcount(result.words.data(), CHUNK_WORDS));
+    settle(result);
+    return result;
+}
+
+inline CompressedBitmap::Container CompressedBitmap::container_or(const Container& lhs, const Container& rhs) {
+    if (lhs.kind == Kind::Run && rhs.kind == Kind::Run) {
+        return run_or(lhs, rhs);
+    }
+    if (lhs.kind == Kind::Array && rhs.kind == Kind::Array) {
+        return array_or(lhs, rhs);
+    }
+
+    // Into a bitset, starting from one of the operands if it is one
+    const Container& other = lhs.kind == Kind::Bitset ? rhs : lhs;
+    Container result;
+    if (lhs.kind == Kind::Bitset || rhs.kind == Kind::Bitset) {
+        result = lhs.kind == Kind::Bitset ? lhs : rhs;
+    } else {
+        result = Container{Kind::Bitset, 0, {}, nostd::Array<uint64_t>(CHUNK_WORDS)};
+        or_into(rhs, result.words.data());
+    }
+    or_into(other, result.words.data());
+    result.cardinality = static_cast<uint32_t>(simd::bit_kernels().popcount(result.words.data(), CHUNK_WORDS));
+    settle(result);
+    return result;
+}
+
+inline CompressedBitmap::Container CompressedBitmap::array_and(const Container& lhs, const Container& rhs) {
+    Container result;
+    result.values.reserve(std::min(lhs.values.size(), rhs.values.size()));
+    std::set_intersection(lhs.values.begin(), lhs.values.end(), rhs.values.begin(), rhs.values.end(),
+                          std::back_inserter(result.values));
+    result.cardinality = static_cast<uint32_t>(result.values.size());
+    return result;
+}
+
+inline CompressedBitmap::Container CompressedBitmap::array_or(const Container& lhs, const Container& rhs) {
+    Container result;
+    result.values.reserve(lhs.values.size() + rhs.values.size());
+    std::set_union(lhs.values.begin(), lhs.values.end(), rhs.values.begin(), rhs.values.end(),
+                   std::back_inserter(result.values));
+    result.cardinality = static_cast<uint32_t>(result.values.size());
+    if (result.cardinality > ARRAY_MAX) {
+        words_t words{};
+        or_into(result, words.data());
+        result = make_bitset(words.data(), result.cardinality);
+    }
+    return result;
+}
+
+inline CompressedBitmap::Container CompressedBitmap::array_filter(const Container& array, const Container& other) {
+    Container result;
+    result.values.reserve(array.values.size());
+    for (uint16_t low: array.values) {
+        if (container_contains(other, low)) {
+            result.values.push_back(low);
+        }
+    }
+    result.cardinality = static_cast<uint32_t>(result.values.size());
+    return result;
+}
+
+inline CompressedBitmap::Container CompressedBitmap::run_and(const Container& lhs, const Container& rhs) {
+    Container result{Kind::Run, 0, {}, {}};
+    size_type left = 0;
+    size_type right = 0;
+    while (left < lhs.values.size() && right < rhs.values.size()) {
+        const uint16_t first = std::max(lhs.values[left], rhs.values[right]);
+        const uint16_t last = std::min(lhs.values[left + 1], rhs.values[right + 1]);
+        if (first <= last) {
+            result.values.push_back(first);
+            result.values.push_back(last);
+            result.cardinality += last - first + 1;
+        }
+        // The run ending first has no more overlaps
+        if (lhs.values[left + 1] < rhs.values[right + 1]) {
+            left += 2;
+        } else {
+            right += 2;
+        }
+    }
+    return result;
+}
+
+inline CompressedBitmap::Container CompressedBitmap::run_or(const Container& lhs, const Container& rhs) {
+    Container result{Kind::Run, 0, {}, {}};
+    size_type left = 0;
+    size_type right = 0;
+    while (left < lhs.values.size() || right < rhs.values.size()) {
+        // The run starting first, merged into the last one if they touch
+        const bool take_left = right == rhs.values.size() ||
+                               (left < lhs.values.size() && lhs.values[left] < rhs.values[right]);
+        const auto& runs = take_left ? lhs.values : rhs.values;
+        size_type& pos = take_left ? left : right;
+        const uint16_t first = runs[pos];
+        const uint16_t last = runs[pos + 1];
+        pos += 2;
+
+        if (!result.values.empty() && first <= size_type{result.values.back()} + 1) {
+            result.values.back() = std::max(result.values.back(), last);
+        } else {
+            result.values.push_back(first);
+            result.values.push_back(last);
+        }
+    }
+    for (size_type run = 0; run < result.values.size(); run += 2) {
+        result.cardinality += result.values[run + 1] - result.values[run] + 1;
+    }
+    return result;
+}
+
+// ----------------------------------------------------------------------------
+
+inline CompressedBitmap::size_type CompressedBitmap::chunk(uint64_t key) {
+    const size_type pos = std::lower_bound(keys_.begin(), keys_.end(), key) - keys_.begin();
+    if (pos == keys_.size() || keys_[pos] != key) {
+        keys_.push_back(key);
+        containers_.push_back(Container{});
+        std::rotate(keys_.begin() + pos, keys_.end() - 1, keys_.end());
+        std::rotate(containers_.begin() + pos, containers_.end() - 1, containers_.end());
+    }
+    return pos;
+}
+
+} // nostd::bits
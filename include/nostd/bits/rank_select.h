@@ -0,0 +1,276 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+#include <nostd/array/array.h>
+#include <nostd/util.h>
+
+namespace nostd::bits {
+
+// Packed bits in 64-bit words, bit i in word i / 64, zero past size(): Array<bool>
+template <typename B>
+    concept word_bit_array = requires(const B& bits) {
+        { bits.data() } -> std::convertible_to<const uint64_t*>;
+        { bits.size() } -> std::convertible_to<size_t>;
+    };
+
+/*
+ * Rank/select index over a bit array, in the layout of Poppy
+ * (Zhou, Andersen, Kaminsky: "Space-Efficient, High-Performance Rank
+ * & Select Structures on Uncompressed Bit Sequences").
+ *
+ * Every 2048-bit block has one 64-bit entry: the count of ones before
+ * the block (32 bits, relative to its 2^32-bit upper block) and the
+ * counts of its first three 512-bit basic blocks (10 bits each), 3.125%
+ * of the bits. rank1 reads one entry and popcounts at most 8 words.
+ * select1 starts from the block of every SAMPLE-th one and searches the
+ * entries up to the next sample. Samples are 32-bit block numbers, which
+ * caps the array at 2^43 bits.
+ *
+ * The index keeps a pointer to the array, which must outlive it.
+ * Queries see the bits as of the last build: update() indexes bits
+ * appended since in O(new bits), after changes in place call rebuild().
+ */
+template <word_bit_array Bits = Array<bool>>
+class RankSelect {
+public:
+    using size_type = size_t;
+
+    static constexpr size_type BASIC_BITS = 512;
+    static constexpr size_type BLOCK_BITS = 2048;
+    static constexpr size_type UPPER_BITS = size_type{1} << 32;
+    static constexpr size_type SAMPLE = 8192;
+
+    explicit RankSelect(const Bits& bits);
+
+    // Indexes the bits appended since the last build
+    void update();
+    void rebuild();
+
+    // Ones in [0, idx), idx <= size()
+    [[nodiscard]] size_type rank1(size_type idx) const;
+    [[nodiscard]] size_type rank0(size_type idx) const;
+    // Position of the one with rank k (counting from 0), size() if k >= ones()
+    [[nodiscard]] size_type select1(size_type k) const;
+
+    // Indexed bits and their ones
+    [[nodiscard]] size_type size() const noexcept;
+    [[nodiscard]] size_type ones() const noexcept;
+    // Bytes of the index
+    [[nodiscard]] size_type index_bytes() const noexcept;
+
+private:
+    static constexpr size_type WORD_BITS = 64;
+    static constexpr size_type BLOCK_WORDS = BLOCK_BITS / WORD_BITS;
+    static constexpr size_type BASIC_WORDS = BASIC_BITS / WORD_BITS;
+    static constexpr size_type BLOCKS_PER_UPPER = UPPER_BITS / BLOCK_BITS;
+    static constexpr uint64_t RANK_MASK = 0xffffffff;
+    static constexpr uint64_t COUNT_MASK = 0x3ff;
+
+    // Indexes from block first on, the entries before it stay
+    void index_from(size_type first);
+
+    // Ones before the block
+    [[nodiscard]] size_type block_rank(size_type block) const;
+    // Ones in the first `count` basic blocks of the block entry
+    [[nodiscard]] static size_type basic_rank(uint64_t entry, size_type count);
+    [[nodiscard]] static size_type select_in_word(uint64_t word, size_type k);
+
+    const Bits* bits_;
+    Array<uint64_t> blocks_;   // one entry per block
+    Array<uint64_t> upper_;    // ones before each upper block
+    Array<uint32_t> samples_;  // block of the ones with rank 0, SAMPLE, 2 * SAMPLE...
+    size_type size_ = 0;
+    size_type ones_ = 0;
+};
+
+// ========================== Building ========================================
+// ----------------------------------------------------------------------------
+
+template <word_bit_array Bits>
+RankSelect<Bits>::RankSelect(const Bits& bits)
+    : bits_(&bits) {
+    rebuild();
+}
+
+template <word_bit_array Bits>
+void RankSelect<Bits>::update() {
+    // The last block may have been partial, it is indexed again
+    index_from(size_ / BLOCK_BITS);
+}
+
+template <word_bit_array Bits>
+void RankSelect<Bits>::rebuild() {
+    index_from(0);
+}
+
+template <word_bit_array Bits>
+void RankSelect<Bits>::index_from(size_type first) {
+    size_type ones = first < blocks_.size() ? block_rank(first) : ones_;
+    while (blocks_.size() > first) {
+        blocks_.pop_back();
+    }
+    while (upper_.size() > util::CeilDiv(first, BLOCKS_PER_UPPER)) {
+        upper_.pop_back();
+    }
+    while (!samples_.empty() && samples_.back() >= first) {
+        samples_.pop_back();
+    }
+
+    const uint64_t* words = bits_->data();
+    const size_type size = bits_->size();
+    const size_type word_count = util::CeilDiv(size, WORD_BITS);
+    const size_type block_count = util::CeilDiv(size, BLOCK_BITS);
+    blocks_.reserve(block_count);
+
+    for (size_type block = first; block < block_count; ++block) {
+        if (block % BLOCKS_PER_UPPER == 0) {
+            upper_.push_back(ones);
+        }
+
+        uint64_t entry = ones - upper_[block / BLOCKS_PER_UPPER];
+        size_type block_ones = 0;
+        for (size_type basic = 0; basic < BLOCK_WORDS / BASIC_WORDS; ++basic) {
+            const size_type begin = block * BLOCK_WORDS + basic * BASIC_WORDS;
+            size_type count = 0;
+            for (size_type word = begin; word < begin + BASIC_WORDS && word < word_count; ++word) {
+                count += std::popcount(words[word]);
+            }
+            if (basic < 3) {
+                entry |= uint64_t{count} << (32 + 10 * basic);
+            }
+            block_ones += count;
+        }
+        blocks_.push_back(entry);
+
+        // Ones with ranks ones..ones + block_ones - 1 are in this block
+        while (samples_.size() * SAMPLE < ones + block_ones) {
+            samples_.push_back(static_cast<uint32_t>(block));
+        }
+        ones += block_ones;
+    }
+
+    size_ = size;
+    ones_ = ones;
+}
+
+// ========================== Queries =========================================
+// ----------------------------------------------------------------------------
+
+template <word_bit_array Bits>
+typename RankSelect<Bits>::size_type RankSelect<Bits>::rank1(size_type idx) const {
+    if (idx >= size_) {
+        return ones_;
+    }
+
+    const size_type block = idx / BLOCK_BITS;
+    const size_type basic = idx % BLOCK_BITS / BASIC_BITS;
+    size_type rank = block_rank(block) + basic_rank(blocks_[block], basic);
+
+    const uint64_t* words = bits_->data();
+    const size_type last = idx / WORD_BITS;
+    for (size_type word = block * BLOCK_WORDS + basic * BASIC_WORDS; word < last; ++word) {
+        rank += std::popcount(words[word]);
+    }
+    if (idx % WORD_BITS != 0) {
+        rank += std::popcount(words[last] & ((uint64_t{1} << (idx % WORD_BITS)) - 1));
+    }
+    return rank;
+}
+
+template <word_bit_array Bits>
+typename RankSelect<Bits>::size_type RankSelect<Bits>::rank0(size_type idx) const {
+    return std::min(idx, size_) - rank1(idx);
+}
+
+template <word_bit_array Bits>
+typename RankSelect<Bits>::size_type RankSelect<Bits>::select1(size_type k) const {
+    if (k >= ones_) {
+        return size_;
+    }
+
+    // The last block in the sampled range with no more than k ones before it
+    size_type lo = samples_[k / SAMPLE];
+    size_type hi = k / SAMPLE + 1 < samples_.size() ? samples_[k / SAMPLE + 1] : blocks_.size() - 1;
+    while (lo < hi) {
+        const size_type mid = lo + (hi - lo + 1) / 2;
+        if (block_rank(mid) <= k) {
+            lo = mid;
+        } else {
+            hi = mid - 1;
+        }
+    }
+
+    size_type rest = k - block_rank(lo);
+    const uint64_t entry = blocks_[lo];
+    size_type basic = 0;
+    for (; basic < 3; ++basic) {
+        const size_type count = (entry >> (32 + 10 * basic)) & COUNT_MASK;
+        if (rest < count) {
+            break;
+        }
+        rest -= count;
+    }
+
+    const uint64_t* words = bits_->data();
+    size_type word = lo * BLOCK_WORDS + basic * BASIC_WORDS;
+    for (size_type count = std::popcount(words[word]); rest >= count; count = std::popcount(words[word])) {
+        rest -= count;
+        ++word;
+    }
+    return word * WORD_BITS + select_in_word(words[word], rest);
+}
+
+template <word_bit_array Bits>
+typename RankSelect<Bits>::size_type RankSelect<Bits>::size() const noexcept {
+    return size_;
+}
+
+template <word_bit_array Bits>
+typename RankSelect<Bits>::size_type RankSelect<Bits>::ones() const noexcept {
+    return ones_;
+}
+
+template <word_bit_array Bits>
+typename RankSelect<Bits>::size_type RankSelect<Bits>::index_bytes() const noexcept {
+    return (blocks_.capacity() + upper_.capacity()) * sizeof(uint64_t) + samples_.capacity() * sizeof(uint32_t);
+}
+
+// ----------------------------------------------------------------------------
+
+template <word_bit_array Bits>
+typename RankSelect<Bits>::size_type RankSelect<Bits>::block_rank(size_type block) const {
+    return upper_[block / BLOCKS_PER_UPPER] + (blocks_[block] & RANK_MASK);
+}
+
+template <word_bit_array Bits>
+typename RankSelect<Bits>::size_type RankSelect<Bits>::basic_rank(uint64_t entry, size_type count) {
+    size_type rank = 0;
+    for (size_type basic = 0; basic < count; ++basic) {
+        rank += (entry >> (32 + 10 * basic)) & COUNT_MASK;
+    }
+    return rank;
+}
+
+template <word_bit_array Bits>
+typename RankSelect<Bits>::size_type RankSelect<Bits>::select_in_word(uint64_t word, size_type k) {
+#if defined(__BMI2__)
+    // Deposits a single bit at the k-th set bit of word
+    return std::countr_zero(_pdep_u64(uint64_t{1} << k, word));
+#else
+    for (; k != 0; --k) {
+        word &= word - 1;
+    }
+    return std::countr_zero(word);
+#endif
+}
+
+} // nostd::bits
@@ -17,4 +17,37 @@ template <typename T>
         copy_constructible<T> &&
         !move_constructible<T>;
 
+template <typename T>
+    concept trivially_copyable =
+        std::is_trivially_copyable_v<T>;
+
+template <typename T>
+    concept trivially_destructible =
+        std::is_trivially_destructible_v<T>;
+
+// Objects come to life with their storage, no constructor needed
+template <typename T>
+    concept implicit_lifetime =
+        std::is_trivially_default_constructible_v<T> &&
+        std::is_trivially_destructible_v<T>;
+
+/*
+ * Relocation = move to a new address + destruction of the source.
+ * Trivially relocatable types can be relocated by plain memcpy,
+ * the source is released without running the destructor.
+ * Specialize for types that keep no pointers into themselves.
+ */
+template <typename T>
+struct is_trivially_relocatable
+    : std::bool_constant<std::is_trivially_copyable_v<T>> {
+};
+
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+template <typename T>
+    concept trivially_relocatable =
+        move_constructible<T> &&
+        is_trivially_relocatable_v<T>;
+
 } // nostd
\ No newline at end of file
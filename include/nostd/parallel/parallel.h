@@ -0,0 +1,271 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <thread>
+#include <utility>
+
+#include <nostd/array/array.h>
+#include <nostd/util.h>
+
+namespace nostd::parallel {
+
+inline constexpr size_t CACHE_LINE_SIZE = 64;
+
+inline size_t default_threads() noexcept {
+    const unsigned threads = std::thread::hardware_concurrency();
+    return threads == 0 ? 1 : threads;
+}
+
+// ============================================================================
+
+namespace detail {
+
+template <typename T>
+struct alignas(CACHE_LINE_SIZE) Padded {
+    std::optional<T> value;
+};
+
+/*
+ * Splits [0, count) of a buffer into at most `threads` chunks.
+ * Inner bounds are moved up to a cache line start, so workers do not
+ * write to one line unless sizeof(T) does not divide the line.
+ */
+struct Chunks {
+    Chunks(const void* base, size_t count, size_t value_size, size_t threads)
+        : base_(reinterpret_cast<uintptr_t>(base)), count_(count), value_size_(value_size) {
+        size_ = std::max<size_t>(1, std::min(threads, util::CeilDiv(count * value_size, CACHE_LINE_SIZE)));
+    }
+
+    [[nodiscard]] size_t size() const {
+        return size_;
+    }
+
+    [[nodiscard]] size_t begin(size_t chunk) const {
+        if (chunk == 0) {
+            return 0;
+        }
+        if (chunk >= size_) {
+            return count_;
+        }
+
+        const uintptr_t ideal = base_ + count_ * chunk / size_ * value_size_;
+        const uintptr_t line = util::CeilDiv(ideal, uintptr_t{CACHE_LINE_SIZE}) * CACHE_LINE_SIZE;
+        return std::min(count_, util::CeilDiv(static_cast<size_t>(line - base_), value_size_));
+    }
+
+    [[nodiscard]] size_t end(size_t chunk) const {
+        return begin(chunk + 1);
+    }
+
+private:
+    uintptr_t base_;
+    size_t count_;
+    size_t value_size_;
+    size_t size_;
+};
+
+// Runs fn(task) for every task in [0, count), the first one on this thread
+template <typename F>
+void run_tasks(size_t count, F&& fn) {
+    Array<std::exception_ptr> errors(count);
+
+    auto task = [&](size_t idx) {
+        try {
+            fn(idx);
+        }
+        catch (...) {
+            errors[idx] = std::current_exception();
+        }
+    };
+
+    {
+        Array<std::jthread> workers;
+        workers.reserve(count - 1);
+        for (size_t idx = 1; idx < count; ++idx) {
+            workers.emplace_back(task, idx);
+        }
+        task(0);
+    }
+
+    for (auto& error: errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+// Runs fn(chunk, begin, end) for every chunk, the first one on this thread
+template <typename F>
+void run(const Chunks& chunks, F&& fn) {
+    run_tasks(chunks.size(), [&](size_t chunk) {
+        fn(chunk, chunks.begin(chunk), chunks.end(chunk));
+    });
+}
+
+template <typename R>
+auto* range_data(R& range) {
+    return std::ranges::data(range);
+}
+
+} // nostd::parallel::detail
+
+// ============================================================================
+
+/*
+ * Algorithms take Array or any other contiguous range, work is
+ * split into `threads` cache-line aligned chunks.
+ * Exceptions of workers are rethrown on the calling thread.
+ */
+
+template <std::ranges::contiguous_range R, typename F>
+void for_each(R&& range, F f, size_t threads = default_threads()) {
+    auto* data = detail::range_data(range);
+    const auto count = static_cast<size_t>(std::ranges::size(range));
+
+    detail::run(detail::Chunks(data, count, sizeof(*data), threads), [&](size_t, size_t begin, size_t end) {
+        for (size_t idx = begin; idx < end; ++idx) {
+            f(data[idx]);
+        }
+    });
+}
+
+// out must be at least as long as in, they may be the same range
+template <std::ranges::contiguous_range In, std::ranges::contiguous_range Out, typename F>
+void transform(In&& in, Out&& out, F f, size_t threads = default_threads()) {
+    const auto* src = detail::range_data(in);
+    auto* dst = detail::range_data(out);
+    const auto count = static_cast<size_t>(std::ranges::size(in));
+
+    // Chunks follow the output, it is the one being written
+    detail::run(detail::Chunks(dst, count, sizeof(*dst), threads), [&](size_t, size_t begin, size_t end) {
+        for (size_t idx = begin; idx < end; ++idx) {
+            dst[idx] = f(src[idx]);
+        }
+    });
+}
+
+template <std::ranges::contiguous_range R, typename T>
+void fill(R&& range, const T& value, size_t threads = default_threads()) {
+    auto* data = detail::range_data(range);
+    const auto count = static_cast<size_t>(std::ranges::size(range));
+
+    detail::run(detail::Chunks(data, count, sizeof(*data), threads), [&](size_t, size_t begin, size_t end) {
+        std::fill(data + begin, data + end, value);
+    });
+}
+
+// op must be associative, chunk results are combined in order
+template <std::ranges::contiguous_range R, typename T, typename Op = std::plus<>>
+T reduce(R&& range, T init, Op op = {}, size_t threads = default_threads()) {
+    const auto* data = detail::range_data(range);
+    const auto count = static_cast<size_t>(std::ranges::size(range));
+
+    detail::Chunks chunks(data, count, sizeof(*data), threads);
+    Array<detail::Padded<T>> partial(chunks.size());
+
+    detail::run(chunks, [&](size_t chunk, size_t begin, size_t end) {
+        if (begin == end) {
+            return;
+        }
+
+        T acc = data[begin];
+        for (size_t idx = begin + 1; idx < end; ++idx) {
+            acc = op(std::move(acc), data[idx]);
+        }
+        partial[chunk].value = std::move(acc);
+    });
+
+    for (auto& part: partial) {
+        if (part.value) {
+            init = op(std::move(init), std::move(*part.value));
+        }
+    }
+    return init;
+}
+
+namespace detail {
+
+/*
+ * Two passes: chunks are reduced in parallel, chunk offsets are
+ * scanned on this thread, then every chunk is scanned from its offset.
+ */
+template <typename In, typename Out, typename T, typename Op>
+void scan(In&& in, Out&& out, std::optional<T> init, Op& op, bool inclusive, size_t threads) {
+    const auto* src = range_data(in);
+    auto* dst = range_data(out);
+    const auto count = static_cast<size_t>(std::ranges::size(in));
+
+    Chunks chunks(dst, count, sizeof(*dst), threads);
+    Array<Padded<T>> carry(chunks.size());
+
+    if (chunks.size() > 1) {
+        run(chunks, [&](size_t chunk, size_t begin, size_t end) {
+            if (begin == end || chunk + 1 == chunks.size()) {
+                return;
+            }
+
+            T acc = src[begin];
+            for (size_t idx = begin + 1; idx < end; ++idx) {
+                acc = op(std::move(acc), src[idx]);
+            }
+            carry[chunk].value = std::move(acc);
+        });
+    }
+
+    // carry[k] = init op sum of chunks before k
+    std::optional<T> acc = std::move(init);
+    for (auto& part: carry) {
+        std::optional<T> sum = std::move(part.value);
+        part.value = acc;
+        if (sum) {
+            acc = acc ? op(std::move(*acc), std::move(*sum)) : std::move(*sum);
+        }
+    }
+
+    run(chunks, [&](size_t chunk, size_t begin, size_t end) {
+        if (begin == end) {
+            return;
+        }
+
+        size_t idx = begin;
+        T acc = carry[chunk].value ? *carry[chunk].value : T(src[idx++]);
+        if (inclusive) {
+            if (idx != begin) {
+                dst[begin] = acc;
+            }
+            for (; idx < end; ++idx) {
+                acc = op(std::move(acc), src[idx]);
+                dst[idx] = acc;
+            }
+        } else {
+            for (; idx < end; ++idx) {
+                T value = src[idx];
+                dst[idx] = acc;
+                acc = op(std::move(acc), std::move(value));
+            }
+        }
+    });
+}
+
+} // nostd::parallel::detail
+
+// out must be at least as long as in, they may be the same range
+template <std::ranges::contiguous_range In, std::ranges::contiguous_range Out, typename Op = std::plus<>>
+void inclusive_scan(In&& in, Out&& out, Op op = {}, size_t threads = default_threads()) {
+    using T = std::ranges::range_value_t<In>;
+    detail::scan(in, out, std::optional<T>(), op, true, threads);
+}
+
+template <std::ranges::contiguous_range In, std::ranges::contiguous_range Out, typename T, typename Op = std::plus<>>
+void exclusive_scan(In&& in, Out&& out, T init, Op op = {}, size_t threads = default_threads()) {
+    detail::scan(in, out, std::optional<T>(std::move(init)), op, false, threads);
+}
+
+} // nostd::parallel
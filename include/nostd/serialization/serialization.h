@@ -0,0 +1,211 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+
+#include <nostd/array/array.h>
+#include <nostd/concepts/concepts.h>
+#include <nostd/storage/storage.h>
+#include <nostd/util.h>
+
+namespace nostd {
+
+/*
+ * Binary format, native byte order:
+ *   Header (24 bytes), zero padding up to `alignment`, payload.
+ * The payload is the element bytes as they lie in memory, or the packed
+ * bits of Array<bool>, bit i in bit i % 8 of byte i / 8, unused bits cleared.
+ * A buffer with the payload aligned for T can be viewed without copying.
+ */
+namespace serialization {
+
+inline constexpr uint32_t MAGIC = 0x7261736e;  // "nsar" in little endian
+inline constexpr uint32_t SWAPPED_MAGIC = 0x6e736172;
+inline constexpr uint16_t VERSION = 1;
+
+enum class Kind : uint16_t {
+    Elements = 0,
+    Bits = 1,
+};
+
+struct Header {
+    uint32_t magic = MAGIC;
+    uint16_t version = VERSION;
+    Kind kind = Kind::Elements;
+    uint32_t element_size = 0;
+    uint32_t alignment = 0;
+    uint64_t count = 0;  // elements, or bits for Kind::Bits
+
+    [[nodiscard]] size_t payload_offset() const {
+        return util::CeilDiv(sizeof(Header), size_t{alignment}) * alignment;
+    }
+
+    [[nodiscard]] size_t payload_size() const {
+        return kind == Kind::Bits ? util::CeilDiv(count, uint64_t{8}) : count * element_size;
+    }
+};
+
+static_assert(sizeof(Header) == 24);
+
+// Receives the serialized bytes in order, possibly in several calls
+template <typename S>
+concept byte_sink = std::invocable<S&, std::span<const std::byte>>;
+
+namespace detail {
+
+inline void write_padded(std::span<const std::byte> header, size_t offset, auto& sink) {
+    static constexpr std::array<std::byte, 64> ZEROS{};
+
+    sink(header);
+    for (size_t done = header.size(); done < offset; done += ZEROS.size()) {
+        sink(std::span<const std::byte>(ZEROS).first(std::min(ZEROS.size(), offset - done)));
+    }
+}
+
+// Checks the header against what the caller expects, returns the payload
+inline std::span<const std::byte> check(std::span<const std::byte> bytes, Kind kind, size_t element_size,
+                                        size_t alignment, Header& header) {
+    if (bytes.size() < sizeof(Header)) {
+        throw std::invalid_argument("serialization: buffer is shorter than the header");
+    }
+    std::memcpy(&header, bytes.data(), sizeof(Header));
+
+    if (header.magic == SWAPPED_MAGIC) {
+        throw std::invalid_argument("serialization: written with a different byte order");
+    }
+    if (header.magic != MAGIC) {
+        throw std::invalid_argument("serialization: bad magic");
+    }
+    if (header.version != VERSION) {
+        throw std::invalid_argument("serialization: unsupported version");
+    }
+    if (header.kind != kind || header.element_size != element_size || header.alignment != alignment) {
+        throw std::invalid_argument("serialization: element type does not match");
+    }
+
+    const size_t offset = header.payload_offset();
+    if (bytes.size() < offset) {
+        throw std::invalid_argument("serialization: buffer is shorter than the header");
+    }
+    // Compared without multiplying count, it comes from the buffer
+    const size_t available = bytes.size() - offset;
+    if (kind == Kind::Bits ? util::CeilDiv(header.count, uint64_t{8}) > available
+                           : header.count > available / element_size) {
+        throw std::invalid_argument("serialization: buffer is shorter than the payload");
+    }
+    return bytes.subspan(offset, header.payload_size());
+}
+
+} // nostd::serialization::detail
+
+} // nostd::serialization
+
+// ============================================================================
+
+template <typename T, template <typename> typename Storage, typename Growth>
+    requires trivially_copyable<T> && (!std::same_as<T, bool>)
+size_t serialized_size(const Array<T, Storage, Growth>& array) {
+    return util::CeilDiv(sizeof(serialization::Header), alignof(T)) * alignof(T) + array.size() * sizeof(T);
+}
+
+template <template <typename> typename Storage, typename Growth>
+size_t serialized_size(const Array<bool, Storage, Growth>& array) {
+    return sizeof(serialization::Header) + util::CeilDiv(array.size(), size_t{8});
+}
+
+template <typename T, template <typename> typename Storage, typename Growth, serialization::byte_sink Sink>
+    requires trivially_copyable<T> && (!std::same_as<T, bool>)
+void serialize(const Array<T, Storage, Growth>& array, Sink&& sink) {
+    serialization::Header header;
+    header.element_size = sizeof(T);
+    header.alignment = alignof(T);
+    header.count = array.size();
+
+    serialization::detail::write_padded(std::as_bytes(std::span(&header, 1)), header.payload_offset(), sink);
+    if (!array.empty()) {
+        sink(std::as_bytes(std::span(array.data(), array.size())));
+    }
+}
+
+// Words are written as bytes, the bits past the size are zero already
+template <template <typename> typename Storage, typename Growth, serialization::byte_sink Sink>
+void serialize(const Array<bool, Storage, Growth>& array, Sink&& sink) {
+    static_assert(std::endian::native == std::endian::little, "bit payload is the byte order of little endian words");
+
+    serialization::Header header;
+    header.kind = serialization::Kind::Bits;
+    header.element_size = 1;
+    header.alignment = 1;
+    header.count = array.size();
+
+    sink(std::as_bytes(std::span(&header, 1)));
+    if (!array.empty()) {
+        const auto words = std::as_bytes(std::span(array.data(), util::CeilDiv(array.size(), size_t{64})));
+        sink(words.first(util::CeilDiv(array.size(), size_t{8})));
+    }
+}
+
+template <typename A>
+    requires requires(const A& array) { serialized_size(array); }
+void serialize(const A& array, std::ostream& out) {
+    serialize(array, [&out](std::span<const std::byte> bytes) {
+        out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    });
+}
+
+/*
+ * Non-owning view of the elements inside a serialized buffer, no copy.
+ * The payload must be aligned for T (it is if the buffer is aligned
+ * like T) and the buffer must outlive the view.
+ */
+template <typename T>
+    requires trivially_copyable<T> && implicit_lifetime<T> && (!std::same_as<T, bool>)
+std::span<const T> view_from_bytes(std::span<const std::byte> bytes) {
+    serialization::Header header;
+    const auto payload = serialization::detail::check(bytes, serialization::Kind::Elements, sizeof(T), alignof(T), header);
+    if (reinterpret_cast<uintptr_t>(payload.data()) % alignof(T) != 0) {
+        throw std::invalid_argument("serialization: payload is misaligned for the element type");
+    }
+
+    return {reinterpret_cast<const T*>(payload.data()), static_cast<size_t>(header.count)};
+}
+
+// Owning copy, a single memcpy into the new array
+template <typename T, template <typename> typename Storage = storage::DynamicStorage, typename Growth = growth::Doubling>
+    requires trivially_copyable<T> && implicit_lifetime<T> && (!std::same_as<T, bool>)
+Array<T, Storage, Growth> deserialize(std::span<const std::byte> bytes) {
+    serialization::Header header;
+    const auto payload = serialization::detail::check(bytes, serialization::Kind::Elements, sizeof(T), alignof(T), header);
+
+    Array<T, Storage, Growth> array(static_cast<size_t>(header.count), uninit);
+    if (!payload.empty()) {
+        std::memcpy(static_cast<void*>(array.data()), payload.data(), payload.size());
+    }
+    return array;
+}
+
+template <typename T, template <typename> typename Storage = storage::DynamicStorage, typename Growth = growth::Doubling>
+    requires std::same_as<T, bool>
+Array<bool, Storage, Growth> deserialize(std::span<const std::byte> bytes) {
+    serialization::Header header;
+    const auto payload = serialization::detail::check(bytes, serialization::Kind::Bits, 1, 1, header);
+
+    Array<bool, Storage, Growth> array(static_cast<size_t>(header.count));
+    if (!payload.empty()) {
+        std::memcpy(array.data(), payload.data(), payload.size());
+        // Stray bits past the count would break the zero tail of the array
+        if (const size_t tail = array.size() % 64; tail != 0) {
+            array.data()[array.size() / 64] &= (uint64_t{1} << tail) - 1;
+        }
+    }
+    return array;
+}
+
+} // nostd
@@ -0,0 +1,570 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace nostd::simd {
+
+// Element types the kernels are instantiated for
+template <typename T>
+concept vectorizable = std::is_arithmetic_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, long double> &&
+                       (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+
+// Kernels over raw buffers, min/max/minmax require size != 0
+template <typename T>
+struct Kernels {
+    T (*sum)(const T* data, size_t size);
+    T (*min)(const T* data, size_t size);
+    T (*max)(const T* data, size_t size);
+    std::pair<T, T> (*minmax)(const T* data, size_t size);
+    T (*dot)(const T* lhs, const T* rhs, size_t size);
+    size_t (*count)(const T* data, size_t size, T value);
+    size_t (*find)(const T* data, size_t size, T value);
+};
+
+// Kernels over words of packed bits, binary ones update dst in place
+struct BitKernels {
+    size_t (*popcount)(const uint64_t* words, size_t size);
+    void (*bit_and)(uint64_t* dst, const uint64_t* src, size_t size);
+    void (*bit_or)(uint64_t* dst, const uint64_t* src, size_t size);
+    void (*bit_xor)(uint64_t* dst, const uint64_t* src, size_t size);
+    void (*bit_not)(uint64_t* words, size_t size);
+    // Index of the first word with a set bit, or size
+    size_t (*find_nonzero)(const uint64_t* words, size_t size);
+};
+
+// ============================================================================
+
+namespace detail {
+
+template <size_t Size>
+struct uint_of;
+
+template <> struct uint_of<1> { using type = uint8_t; };
+template <> struct uint_of<2> { using type = uint16_t; };
+template <> struct uint_of<4> { using type = uint32_t; };
+template <> struct uint_of<8> { using type = uint64_t; };
+
+// Integers are added and multiplied as unsigned, so overflow wraps instead of being UB
+template <typename T>
+using accumulator_t = std::conditional_t<std::is_integral_v<T>, typename uint_of<sizeof(T)>::type, T>;
+
+template <typename T, size_t Width>
+struct vector {
+    typedef T type __attribute__((vector_size(Width)));
+    typedef T unaligned __attribute__((vector_size(Width), aligned(alignof(T)), may_alias));
+};
+
+template <typename T, size_t Width>
+using vector_t = typename vector<T, Width>::type;
+
+template <typename T, size_t Width>
+using unaligned_vector_t = typename vector<T, Width>::unaligned;
+
+// ===== Scalar =====
+
+template <typename T>
+struct Scalar {
+    using A = accumulator_t<T>;
+
+    static T sum(const T* data, size_t size) {
+        A acc = 0;
+        for (size_t idx = 0; idx < size; ++idx) {
+            acc += static_cast<A>(data[idx]);
+        }
+        return static_cast<T>(acc);
+    }
+
+    static T min(const T* data, size_t size) {
+        T acc = data[0];
+        for (size_t idx = 1; idx < size; ++idx) {
+            acc = data[idx] < acc ? data[idx] : acc;
+        }
+        return acc;
+    }
+
+    static T max(const T* data, size_t size) {
+        T acc = data[0];
+        for (size_t idx = 1; idx < size; ++idx) {
+            acc = acc < data[idx] ? data[idx] : acc;
+        }
+        return acc;
+    }
+
+    static std::pair<T, T> minmax(const T* data, size_t size) {
+        return {min(data, size), max(data, size)};
+    }
+
+    static T dot(const T* lhs, const T* rhs, size_t size) {
+        A acc = 0;
+        for (size_t idx = 0; idx < size; ++idx) {
+            acc += static_cast<A>(lhs[idx]) * static_cast<A>(rhs[idx]);
+        }
+        return static_cast<T>(acc);
+    }
+
+    static size_t count(const T* data, size_t size, T value) {
+        size_t result = 0;
+        for (size_t idx = 0; idx < size; ++idx) {
+            result += data[idx] == value;
+        }
+        return result;
+    }
+
+    static size_t find(const T* data, size_t size, T value) {
+        for (size_t idx = 0; idx < size; ++idx) {
+            if (data[idx] == value) {
+                return idx;
+            }
+        }
+        return size;
+    }
+};
+
+// ===== Vector =====
+
+/*
+ * Kernels written with GCC vector extensions for a given register width.
+ * Everything is always_inline, the code is generated by the ISA
+ * specific wrappers below with their target attribute. Helpers never
+ * take or return vectors by value, that would change the call ABI.
+ * Loops keep UNROLL independent accumulators to hide op latency.
+ */
+template <typename T, size_t Width>
+struct Vector {
+    using A = accumulator_t<T>;
+    using U = typename uint_of<sizeof(T)>::type;
+    using V = vector_t<T, Width>;
+    using VA = vector_t<A, Width>;
+    using VU = vector_t<U, Width>;
+    using VW = vector_t<uint64_t, Width>;
+
+    static constexpr size_t LANES = Width / sizeof(T);
+    static constexpr size_t UNROLL = 4;
+    static constexpr size_t STEP = LANES * UNROLL;
+
+    [[gnu::always_inline]] static const unaligned_vector_t<T, Width>& load(const T* ptr) {
+        return *reinterpret_cast<const unaligned_vector_t<T, Width>*>(ptr);
+    }
+
+    [[gnu::always_inline]] static const unaligned_vector_t<A, Width>& load_acc(const T* ptr) {
+        return *reinterpret_cast<const unaligned_vector_t<A, Width>*>(ptr);
+    }
+
+    template <typename Mask>
+    [[gnu::always_inline]] static bool any(const Mask& mask) {
+        const VW words = (VW)mask;
+        uint64_t acc = 0;
+        for (size_t idx = 0; idx < Width / sizeof(uint64_t); ++idx) {
+            acc |= words[idx];
+        }
+        return acc != 0;
+    }
+
+    template <typename R, typename Vec, typename Op>
+    [[gnu::always_inline]] static R fold(const Vec& vec, Op op) {
+        R acc = vec[0];
+        for (size_t idx = 1; idx < sizeof(Vec) / sizeof(vec[0]); ++idx) {
+            acc = op(acc, vec[idx]);
+        }
+        return acc;
+    }
+
+    // Sum of counter lanes, adjacent lanes are added pairwise until they are 64 bit wide
+    [[gnu::always_inline]] static size_t total(const VU& counters) {
+        VW words = (VW)counters;
+        for (size_t bits = 8 * sizeof(U); bits < 64; bits *= 2) {
+            const uint64_t low = ~uint64_t{0} / ((uint64_t{1} << bits) + 1);
+            words = (words & low) + ((words >> bits) & low);
+        }
+        return fold<size_t>(words, [](size_t lhs, size_t rhs) { return lhs + rhs; });
+    }
+
+    [[gnu::always_inline]] static T sum(const T* data, size_t size) {
+        VA acc[UNROLL] = {};
+        size_t idx = 0;
+        for (; idx + STEP <= size; idx += STEP) {
+            #pragma GCC unroll 4
+            for (size_t u = 0; u < UNROLL; ++u) {
+                acc[u] += load_acc(data + idx + u * LANES);
+            }
+        }
+        for (; idx + LANES <= size; idx += LANES) {
+            acc[0] += load_acc(data + idx);
+        }
+
+        A result = fold<A>((acc[0] + acc[1]) + (acc[2] + acc[3]), [](A lhs, A rhs) { return lhs + rhs; });
+        for (; idx < size; ++idx) {
+            result += static_cast<A>(data[idx]);
+        }
+        return static_cast<T>(result);
+    }
+
+    // The last vector is loaded overlapping the previous one, min and max do not mind
+    template <bool Min, bool Max>
+    [[gnu::always_inline]] static std::pair<T, T> extremes(const T* data, size_t size) {
+        if (size < LANES) {
+            return Scalar<T>::minmax(data, size);
+        }
+
+        V lo[UNROLL], hi[UNROLL];
+        #pragma GCC unroll 4
+        for (size_t u = 0; u < UNROLL; ++u) {
+            lo[u] = hi[u] = load(data);
+        }
+
+        size_t idx = 0;
+        for (; idx + STEP <= size; idx += STEP) {
+            #pragma GCC unroll 4
+            for (size_t u = 0; u < UNROLL; ++u) {
+                const V vec = load(data + idx + u * LANES);
+                if constexpr (Min) {
+                    lo[u] = vec < lo[u] ? vec : lo[u];
+                }
+                if constexpr (Max) {
+                    hi[u] = hi[u] < vec ? vec : hi[u];
+                }
+            }
+        }
+        for (; idx < size; idx += LANES) {
+            const V vec = load(data + std::min(idx, size - LANES));
+            if constexpr (Min) {
+                lo[0] = vec < lo[0] ? vec : lo[0];
+            }
+            if constexpr (Max) {
+                hi[0] = hi[0] < vec ? vec : hi[0];
+            }
+        }
+
+        #pragma GCC unroll 4
+        for (size_t u = 1; u < UNROLL; ++u) {
+            lo[0] = lo[u] < lo[0] ? lo[u] : lo[0];
+            hi[0] = hi[0] < hi[u] ? hi[u] : hi[0];
+        }
+        return {
+            fold<T>(lo[0], [](T lhs, T rhs) { return rhs < lhs ? rhs : lhs; }),
+            fold<T>(hi[0], [](T lhs, T rhs) { return lhs < rhs ? rhs : lhs; }),
+        };
+    }
+
+    [[gnu::always_inline]] static T min(const T* data, size_t size) {
+        return extremes<true, false>(data, size).first;
+    }
+
+    [[gnu::always_inline]] static T max(const T* data, size_t size) {
+        return extremes<false, true>(data, size).second;
+    }
+
+    [[gnu::always_inline]] static std::pair<T, T> minmax(const T* data, size_t size) {
+        return extremes<true, true>(data, size);
+    }
+
+    [[gnu::always_inline]] static T dot(const T* lhs, const T* rhs, size_t size) {
+        VA acc[UNROLL] = {};
+        size_t idx = 0;
+        for (; idx + STEP <= size; idx += STEP) {
+            #pragma GCC unroll 4
+            for (size_t u = 0; u < UNROLL; ++u) {
+                acc[u] += load_acc(lhs + idx + u * LANES) * load_acc(rhs + idx + u * LANES);
+            }
+        }
+        for (; idx + LANES <= size; idx += LANES) {
+            acc[0] += load_acc(lhs + idx) * load_acc(rhs + idx);
+        }
+
+        A result = fold<A>((acc[0] + acc[1]) + (acc[2] + acc[3]), [](A lhs, A rhs) { return lhs + rhs; });
+        for (; idx < size; ++idx) {
+            result += static_cast<A>(lhs[idx]) * static_cast<A>(rhs[idx]);
+        }
+        return static_cast<T>(result);
+    }
+
+    /*
+     * Matches are counted per lane in lane sized counters (a true
+     * comparison is all ones, subtracting it adds one). The UNROLL
+     * counters are summed and flushed before that sum can wrap.
+     */
+    [[gnu::always_inline]] static size_t count(const T* data, size_t size, T value) {
+        constexpr size_t BLOCK = sizeof(U) < sizeof(size_t) ? ((size_t{1} << (8 * sizeof(U))) - 1) / UNROLL : SIZE_MAX;
+        const V needle = V{} + value;
+
+        size_t result = 0;
+        size_t idx = 0;
+        while (size - idx >= STEP) {
+            const size_t steps = std::min((size - idx) / STEP, BLOCK);
+            VU acc[UNROLL] = {};
+            for (size_t step = 0; step < steps; ++step, idx += STEP) {
+                #pragma GCC unroll 4
+                for (size_t u = 0; u < UNROLL; ++u) {
+                    acc[u] -= (VU)(load(data + idx + u * LANES) == needle);
+                }
+            }
+            result += total((acc[0] + acc[1]) + (acc[2] + acc[3]));
+        }
+        return result + Scalar<T>::count(data + idx, size - idx, value);
+    }
+
+    [[gnu::always_inline]] static size_t find(const T* data, size_t size, T value) {
+        const V needle = V{} + value;
+
+        size_t idx = 0;
+        for (; idx + STEP <= size; idx += STEP) {
+            VU mask = (VU)(load(data + idx) == needle);
+            #pragma GCC unroll 4
+            for (size_t u = 1; u < UNROLL; ++u) {
+                mask |= (VU)(load(data + idx + u * LANES) == needle);
+            }
+            if (any(mask)) {
+                break;
+            }
+        }
+        for (; idx + LANES <= size; idx += LANES) {
+            if (any((VU)(load(data + idx) == needle))) {
+                break;
+            }
+        }
+        return idx + Scalar<T>::find(data + idx, size - idx, value);
+    }
+};
+
+// ===== Bits =====
+
+struct ScalarBits {
+    static size_t popcount(const uint64_t* words, size_t size) {
+        size_t result = 0;
+        for (size_t idx = 0; idx < size; ++idx) {
+            result += std::popcount(words[idx]);
+        }
+        return result;
+    }
+
+    static void bit_and(uint64_t* dst, const uint64_t* src, size_t size) {
+        for (size_t idx = 0; idx < size; ++idx) {
+            dst[idx] &= src[idx];
+        }
+    }
+
+    static void bit_or(uint64_t* dst, const uint64_t* src, size_t size) {
+        for (size_t idx = 0; idx < size; ++idx) {
+            dst[idx] |= src[idx];
+        }
+    }
+
+    static void bit_xor(uint64_t* dst, const uint64_t* src, size_t size) {
+        for (size_t idx = 0; idx < size; ++idx) {
+            dst[idx] ^= src[idx];
+        }
+    }
+
+    static void bit_not(uint64_t* words, size_t size) {
+        for (size_t idx = 0; idx < size; ++idx) {
+            words[idx] = ~words[idx];
+        }
+    }
+
+    static size_t find_nonzero(const uint64_t* words, size_t size) {
+        for (size_t idx = 0; idx < size; ++idx) {
+            if (words[idx] != 0) {
+                return idx;
+            }
+        }
+        return size;
+    }
+};
+
+/*
+ * Bitwise kernels on whole registers, inlined into the ISA wrappers like
+ * Vector. popcount stays on the scalar POPCNT instruction, one word per
+ * cycle on independent accumulators; it is memory bound past L2 anyway.
+ */
+template <size_t Width>
+struct VectorBits {
+    using V = vector_t<uint64_t, Width>;
+    using UV = unaligned_vector_t<uint64_t, Width>;
+
+    static constexpr size_t LANES = Width / sizeof(uint64_t);
+    static constexpr size_t UNROLL = 4;
+
+    [[gnu::always_inline]] static const UV& load(const uint64_t* ptr) {
+        return *reinterpret_cast<const UV*>(ptr);
+    }
+
+    [[gnu::always_inline]] static UV& at(uint64_t* ptr) {
+        return *reinterpret_cast<UV*>(ptr);
+    }
+
+    [[gnu::always_inline]] static size_t popcount(const uint64_t* words, size_t size) {
+        size_t acc[UNROLL] = {};
+        size_t idx = 0;
+        for (; idx + UNROLL <= size; idx += UNROLL) {
+            #pragma GCC unroll 4
+            for (size_t u = 0; u < UNROLL; ++u) {
+                acc[u] += static_cast<size_t>(__builtin_popcountll(words[idx + u]));
+            }
+        }
+        for (; idx < size; ++idx) {
+            acc[0] += static_cast<size_t>(__builtin_popcountll(words[idx]));
+        }
+        return (acc[0] + acc[1]) + (acc[2] + acc[3]);
+    }
+
+    enum class Op { And, Or, Xor };
+
+    template <Op O, typename W>
+    [[gnu::always_inline]] static void combine(W& dst, const W& src) {
+        if constexpr (O == Op::And) {
+            dst &= src;
+        } else if constexpr (O == Op::Or) {
+            dst |= src;
+        } else {
+            dst ^= src;
+        }
+    }
+
+    template <Op O>
+    [[gnu::always_inline]] static void apply(uint64_t* dst, const uint64_t* src, size_t size) {
+        size_t idx = 0;
+        for (; idx + LANES <= size; idx += LANES) {
+            combine<O>(at(dst + idx), load(src + idx));
+        }
+        for (; idx < size; ++idx) {
+            combine<O>(dst[idx], src[idx]);
+        }
+    }
+
+    [[gnu::always_inline]] static void bit_and(uint64_t* dst, const uint64_t* src, size_t size) {
+        apply<Op::And>(dst, src, size);
+    }
+
+    [[gnu::always_inline]] static void bit_or(uint64_t* dst, const uint64_t* src, size_t size) {
+        apply<Op::Or>(dst, src, size);
+    }
+
+    [[gnu::always_inline]] static void bit_xor(uint64_t* dst, const uint64_t* src, size_t size) {
+        apply<Op::Xor>(dst, src, size);
+    }
+
+    [[gnu::always_inline]] static void bit_not(uint64_t* words, size_t size) {
+        size_t idx = 0;
+        for (; idx + LANES <= size; idx += LANES) {
+            at(words + idx) = ~load(words + idx);
+        }
+        for (; idx < size; ++idx) {
+            words[idx] = ~words[idx];
+        }
+    }
+
+    [[gnu::always_inline]] static size_t find_nonzero(const uint64_t* words, size_t size) {
+        size_t idx = 0;
+        for (; idx + LANES * UNROLL <= size; idx += LANES * UNROLL) {
+            V acc = load(words + idx);
+            #pragma GCC unroll 4
+            for (size_t u = 1; u < UNROLL; ++u) {
+                acc |= load(words + idx + u * LANES);
+            }
+            uint64_t any = 0;
+            for (size_t lane = 0; lane < LANES; ++lane) {
+                any |= acc[lane];
+            }
+            if (any != 0) {
+                break;
+            }
+        }
+        return idx + ScalarBits::find_nonzero(words + idx, size - idx);
+    }
+};
+
+// ===== ISA entry points =====
+
+#define NOSTD_SIMD_DEFINE_KERNELS(NAME, TARGET, WIDTH)                                                     \
+    template <typename T>                                                                                  \
+    struct NAME {                                                                                          \
+        using Impl = Vector<T, WIDTH>;                                                                     \
+                                                                                                           \
+        [[gnu::target(TARGET)]] static T sum(const T* data, size_t size) {                                 \
+            return Impl::sum(data, size);                                                                  \
+        }                                                                                                  \
+        [[gnu::target(TARGET)]] static T min(const T* data, size_t size) {                                 \
+            return Impl::min(data, size);                                                                  \
+        }                                                                                                  \
+        [[gnu::target(TARGET)]] static T max(const T* data, size_t size) {                                 \
+            return Impl::max(data, size);                                                                  \
+        }                                                                                                  \
+        [[gnu::target(TARGET)]] static std::pair<T, T> minmax(const T* data, size_t size) {                \
+            return Impl::minmax(data, size);                                                               \
+        }                                                                                                  \
+        [[gnu::target(TARGET)]] static T dot(const T* lhs, const T* rhs, size_t size) {                    \
+            return Impl::dot(lhs, rhs, size);                                                              \
+        }                                                                                                  \
+        [[gnu::target(TARGET)]] static size_t count(const T* data, size_t size, T value) {                 \
+            return Impl::count(data, size, value);                                                         \
+        }                                                                                                  \
+        [[gnu::target(TARGET)]] static size_t find(const T* data, size_t size, T value) {                  \
+            return Impl::find(data, size, value);                                                          \
+        }                                                                                                  \
+    };
+
+#define NOSTD_SIMD_DEFINE_BIT_KERNELS(NAME, TARGET, WIDTH)                                                 \
+    struct NAME {                                                                                          \
+        using Impl = VectorBits<WIDTH>;                                                                    \
+                                                                                                           \
+        [[gnu::target(TARGET)]] static size_t popcount(const uint64_t* words, size_t size) {               \
+            return Impl::popcount(words, size);                                                            \
+        }                                                                                                  \
+        [[gnu::target(TARGET)]] static void bit_and(uint64_t* dst, const uint64_t* src, size_t size) {     \
+            Impl::bit_and(dst, src, size);                                                                 \
+        }                                                                                                  \
+        [[gnu::target(TARGET)]] static void bit_or(uint64_t* dst, const uint64_t* src, size_t size) {      \
+            Impl::bit_or(dst, src, size);                                                                  \
+        }                                                                                                  \
+        [[gnu::target(TARGET)]] static void bit_xor(uint64_t* dst, const uint64_t* src, size_t size) {     \
+            Impl::bit_xor(dst, src, size);                                                                 \
+        }                                                                                                  \
+        [[gnu::target(TARGET)]] static void bit_not(uint64_t* words, size_t size) {                        \
+            Impl::bit_not(words, size);                                                                    \
+        }                                                                                                  \
+        [[gnu::target(TARGET)]] static size_t find_nonzero(const uint64_t* words, size_t size) {           \
+            return Impl::find_nonzero(words, size);                                                        \
+        }                                                                                                  \
+    };
+
+#if defined(__x86_64__) || defined(__i386__)
+#define NOSTD_SIMD_X86 1
+
+NOSTD_SIMD_DEFINE_KERNELS(Sse2, "sse2", 16)
+NOSTD_SIMD_DEFINE_KERNELS(Avx2, "avx2", 32)
+NOSTD_SIMD_DEFINE_KERNELS(Avx512, "avx512f,avx512bw", 64)
+
+// Every CPU with AVX2 has POPCNT, SSE2 alone does not
+NOSTD_SIMD_DEFINE_BIT_KERNELS(Sse2Bits, "sse2", 16)
+NOSTD_SIMD_DEFINE_BIT_KERNELS(Avx2Bits, "avx2,popcnt", 32)
+NOSTD_SIMD_DEFINE_BIT_KERNELS(Avx512Bits, "avx512f,avx512bw,popcnt", 64)
+
+#endif
+
+#undef NOSTD_SIMD_DEFINE_KERNELS
+#undef NOSTD_SIMD_DEFINE_BIT_KERNELS
+
+template <template <typename> typename Impl, typename T>
+constexpr Kernels<T> make_kernels() {
+    return {
+        &Impl<T>::sum, &Impl<T>::min, &Impl<T>::max, &Impl<T>::minmax,
+        &Impl<T>::dot, &Impl<T>::count, &Impl<T>::find,
+    };
+}
+
+template <typename Impl>
+constexpr BitKernels make_bit_kernels() {
+    return {
+        &Impl::popcount, &Impl::bit_and, &Impl::bit_or,
+        &Impl::bit_xor, &Impl::bit_not, &Impl::find_nonzero,
+    };
+}
+
+} // nostd::simd::detail
+
+} // nostd::simd
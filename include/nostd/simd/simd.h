@@ -0,0 +1,173 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <stdexcept>
+#include <utility>
+
+#include <nostd/simd/kernels.h>
+
+namespace nostd::simd {
+
+/*
+ * Instruction set levels with a kernel implementation.
+ * Everything above Scalar is x86 only, elsewhere they fall back to Scalar.
+ */
+enum class Isa {
+    Scalar,
+    SSE2,
+    AVX2,
+    AVX512,
+};
+
+inline bool supported(Isa isa) noexcept {
+#ifdef NOSTD_SIMD_X86
+    __builtin_cpu_init();
+    switch (isa) {
+        case Isa::Scalar:
+        case Isa::SSE2:
+            return true;
+        case Isa::AVX2:
+            return __builtin_cpu_supports("avx2");
+        case Isa::AVX512:
+            return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw");
+    }
+    return false;
+#else
+    return isa == Isa::Scalar;
+#endif
+}
+
+// Widest level this CPU runs, detected once
+inline Isa best_isa() noexcept {
+    static const Isa isa = [] {
+        for (Isa level: {Isa::AVX512, Isa::AVX2, Isa::SSE2}) {
+            if (supported(level)) {
+                return level;
+            }
+        }
+        return Isa::Scalar;
+    }();
+    return isa;
+}
+
+// Kernel table of a level, the caller checks supported(isa)
+template <vectorizable T>
+const Kernels<T>& kernels(Isa isa) noexcept {
+#ifdef NOSTD_SIMD_X86
+    static constexpr Kernels<T> TABLE[] = {
+        detail::make_kernels<detail::Scalar, T>(),
+        detail::make_kernels<detail::Sse2, T>(),
+        detail::make_kernels<detail::Avx2, T>(),
+        detail::make_kernels<detail::Avx512, T>(),
+    };
+    return TABLE[static_cast<size_t>(isa)];
+#else
+    static constexpr Kernels<T> SCALAR = detail::make_kernels<detail::Scalar, T>();
+    return SCALAR;
+#endif
+}
+
+template <vectorizable T>
+const Kernels<T>& kernels() noexcept {
+    static const Kernels<T>& best = kernels<T>(best_isa());
+    return best;
+}
+
+// Bit kernels of a level, the caller checks supported(isa)
+inline const BitKernels& bit_kernels(Isa isa) noexcept {
+#ifdef NOSTD_SIMD_X86
+    static constexpr BitKernels TABLE[] = {
+        detail::make_bit_kernels<detail::ScalarBits>(),
+        detail::make_bit_kernels<detail::Sse2Bits>(),
+        detail::make_bit_kernels<detail::Avx2Bits>(),
+        detail::make_bit_kernels<detail::Avx512Bits>(),
+    };
+    return TABLE[static_cast<size_t>(isa)];
+#else
+    static constexpr BitKernels SCALAR = detail::make_bit_kernels<detail::ScalarBits>();
+    return SCALAR;
+#endif
+}
+
+inline const BitKernels& bit_kernels() noexcept {
+    static const BitKernels& best = bit_kernels(best_isa());
+    return best;
+}
+
+// ============================================================================
+
+namespace detail {
+
+template <typename R>
+concept vectorizable_range = std::ranges::contiguous_range<R> && std::ranges::sized_range<R> &&
+                             vectorizable<std::ranges::range_value_t<R>>;
+
+template <typename R>
+auto* checked_data(R& range, const char* what) {
+    if (std::ranges::empty(range)) {
+        throw std::invalid_argument(what);
+    }
+    return std::ranges::data(range);
+}
+
+} // nostd::simd::detail
+
+/*
+ * Algorithms over Array or any other contiguous range of arithmetic values.
+ * Floating point sums are reassociated across lanes, so the low bits may
+ * differ from a sequential loop. Integer sums and products wrap.
+ * min/max of a range containing NaN are unspecified.
+ */
+
+template <detail::vectorizable_range R>
+auto sum(const R& range) {
+    using T = std::ranges::range_value_t<R>;
+    return kernels<T>().sum(std::ranges::data(range), std::ranges::size(range));
+}
+
+template <detail::vectorizable_range R>
+auto min(const R& range) {
+    using T = std::ranges::range_value_t<R>;
+    return kernels<T>().min(detail::checked_data(range, "simd::min of an empty range"), std::ranges::size(range));
+}
+
+template <detail::vectorizable_range R>
+auto max(const R& range) {
+    using T = std::ranges::range_value_t<R>;
+    return kernels<T>().max(detail::checked_data(range, "simd::max of an empty range"), std::ranges::size(range));
+}
+
+// Returns {min, max}
+template <detail::vectorizable_range R>
+auto minmax(const R& range) {
+    using T = std::ranges::range_value_t<R>;
+    return kernels<T>().minmax(detail::checked_data(range, "simd::minmax of an empty range"), std::ranges::size(range));
+}
+
+template <detail::vectorizable_range L, detail::vectorizable_range R>
+requires std::same_as<std::ranges::range_value_t<L>, std::ranges::range_value_t<R>>
+auto dot(const L& lhs, const R& rhs) {
+    using T = std::ranges::range_value_t<L>;
+    if (std::ranges::size(lhs) != std::ranges::size(rhs)) {
+        throw std::invalid_argument("simd::dot of ranges with different sizes");
+    }
+    return kernels<T>().dot(std::ranges::data(lhs), std::ranges::data(rhs), std::ranges::size(lhs));
+}
+
+template <detail::vectorizable_range R>
+size_t count(const R& range, std::ranges::range_value_t<R> value) {
+    using T = std::ranges::range_value_t<R>;
+    return kernels<T>().count(std::ranges::data(range), std::ranges::size(range), value);
+}
+
+// Iterator to the first element equal to value, or end
+template <detail::vectorizable_range R>
+std::ranges::borrowed_iterator_t<R> find(R&& range, std::ranges::range_value_t<R> value) {
+    using T = std::ranges::range_value_t<R>;
+    const size_t idx = kernels<T>().find(std::ranges::data(range), std::ranges::size(range), value);
+    return std::ranges::next(std::ranges::begin(range), static_cast<std::ranges::range_difference_t<R>>(idx));
+}
+
+} // nostd::simd
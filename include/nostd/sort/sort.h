@@ -0,0 +1,369 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include <nostd/array/array.h>
+#include <nostd/concepts/concepts.h>
+#include <nostd/parallel/parallel.h>
+
+namespace nostd {
+
+// Keys sorted by their bits: integers and IEEE floats
+template <typename T>
+    concept radix_key =
+        (std::integral<T> && !std::same_as<T, bool>) ||
+        (std::floating_point<T> && std::numeric_limits<T>::is_iec559 && (sizeof(T) == 4 || sizeof(T) == 8));
+
+namespace detail {
+
+inline constexpr size_t SORT_INSERTION_MAX = 16;
+inline constexpr size_t SORT_COMPARISON_MAX = 1024;
+inline constexpr size_t SORT_RADIX_LSD_MAX = size_t{1} << 16;
+inline constexpr size_t SORT_PARALLEL_MIN = size_t{1} << 18;
+inline constexpr size_t SAMPLE_SORT_BUCKETS_PER_THREAD = 4;
+inline constexpr size_t SAMPLE_SORT_OVERSAMPLING = 64;
+
+// Sorting keys alone
+struct NoValues {};
+
+/*
+ * Unsigned bits of a key in key order: the sign bit of integers is
+ * flipped, negative floats have every bit flipped and positive ones
+ * the sign bit. -0.0 comes before 0.0, NaNs with the sign bit clear
+ * after +inf and the others before -inf.
+ */
+template <radix_key T>
+auto radix_bits(T value) noexcept {
+    if constexpr (std::floating_point<T>) {
+        using U = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+        constexpr U SIGN = U{1} << (sizeof(T) * 8 - 1);
+        const U bits = std::bit_cast<U>(value);
+        // Branchless, the sign of random keys is not predictable
+        const U mask = static_cast<U>(-(bits >> (sizeof(T) * 8 - 1))) | SIGN;
+        return static_cast<U>(bits ^ mask);
+    } else {
+        using U = std::make_unsigned_t<T>;
+        constexpr U SIGN = std::is_signed_v<T> ? U{1} << (sizeof(T) * 8 - 1) : U{0};
+        return static_cast<U>(static_cast<U>(value) ^ SIGN);
+    }
+}
+
+struct RadixLess {
+    template <radix_key T>
+    bool operator()(T lhs, T rhs) const noexcept {
+        return radix_bits(lhs) < radix_bits(rhs);
+    }
+};
+
+template <typename K, typename V, typename Less>
+void insertion_sort(K* keys, V* values, size_t size, Less& less) {
+    for (size_t idx = 1; idx < size; ++idx) {
+        K key = std::move(keys[idx]);
+        size_t pos = idx;
+        if constexpr (std::same_as<V, NoValues>) {
+            for (; pos > 0 && less(key, keys[pos - 1]); --pos) {
+                keys[pos] = std::move(keys[pos - 1]);
+            }
+        } else {
+            V value = std::move(values[idx]);
+            for (; pos > 0 && less(key, keys[pos - 1]); --pos) {
+                keys[pos] = std::move(keys[pos - 1]);
+                values[pos] = std::move(values[pos - 1]);
+            }
+            values[pos] = std::move(value);
+        }
+        keys[pos] = std::move(key);
+    }
+}
+
+// values + offset, unless there are no values
+template <typename V>
+V* advance(V* values, size_t offset) noexcept {
+    if constexpr (std::same_as<V, NoValues>) {
+        return values;
+    } else {
+        return values + offset;
+    }
+}
+
+/*
+ * Radix sort on the low `digits` bytes of the keys, stable. One read
+ * of the keys counts every byte, bytes that are the same in all keys
+ * are skipped. Up to SORT_RADIX_LSD_MAX keys are sorted LSD, a byte
+ * per pass between keys and scratch. Larger ranges are scattered into
+ * scratch by their highest varying byte first, so the LSD passes run
+ * over buckets that stay in cache instead of the whole range in memory.
+ * Returns true when the sorted keys (and values) are in scratch.
+ */
+template <radix_key K, typename V>
+bool radix_sort(K* keys, K* key_scratch, V* values, V* value_scratch, size_t size, size_t digits = sizeof(K)) {
+    RadixLess less;
+    if (size <= SORT_INSERTION_MAX) {
+        insertion_sort(keys, values, size, less);
+        return false;
+    }
+    if constexpr (std::same_as<V, NoValues>) {
+        // Keys alone need no stability, keys with the same bits are equal
+        if (size <= SORT_COMPARISON_MAX) {
+            std::sort(keys, keys + size, less);
+            return false;
+        }
+    }
+
+    // Every byte is counted, the loop unrolls
+    std::array<std::array<size_t, 256>, sizeof(K)> counts{};
+    for (size_t idx = 0; idx < size; ++idx) {
+        const auto bits = radix_bits(keys[idx]);
+        for (size_t digit = 0; digit < sizeof(K); ++digit) {
+            ++counts[digit][(bits >> (8 * digit)) & 0xff];
+        }
+    }
+
+    const auto first = radix_bits(keys[0]);
+    auto constant = [&](size_t digit) {
+        return counts[digit][(first >> (8 * digit)) & 0xff] == size;
+    };
+    auto scatter = [&](const K* src, K* dst, const V* value_src, V* value_dst, size_t digit) {
+        auto& offsets = counts[digit];
+        size_t offset = 0;
+        for (auto& count: offsets) {
+            offset += std::exchange(count, offset);
+        }
+        for (size_t idx = 0; idx < size; ++idx) {
+            const size_t pos = offsets[(radix_bits(src[idx]) >> (8 * digit)) & 0xff]++;
+            dst[pos] = src[idx];
+            if constexpr (!std::same_as<V, NoValues>) {
+                value_dst[pos] = value_src[idx];
+            }
+        }
+    };
+
+    size_t top = digits;
+    while (top > 0 && constant(top - 1)) {
+        --top;
+    }
+    if (top == 0) {
+        return false;
+    }
+
+    if (size > SORT_RADIX_LSD_MAX) {
+        // After the scatter, offsets[byte] is the end of the bucket of byte
+        scatter(keys, key_scratch, values, value_scratch, top - 1);
+        size_t begin = 0;
+        for (size_t end: counts[top - 1]) {
+            if (!radix_sort(key_scratch + begin, keys + begin, advance(value_scratch, begin), advance(values, begin),
+                            end - begin, top - 1)) {
+                std::copy(key_scratch + begin, key_scratch + end, keys + begin);
+                if constexpr (!std::same_as<V, NoValues>) {
+                    std::copy(value_scratch + begin, value_scratch + end, values + begin);
+                }
+            }
+            begin = end;
+        }
+        return false;
+    }
+
+    K* src = keys;
+    K* dst = key_scratch;
+    V* value_src = values;
+    V* value_dst = value_scratch;
+    bool in_scratch = false;
+    for (size_t digit = 0; digit < top; ++digit) {
+        if (constant(digit)) {
+            continue;
+        }
+        scatter(src, dst, value_src, value_dst, digit);
+        std::swap(src, dst);
+        std::swap(value_src, value_dst);
+        in_scratch = !in_scratch;
+    }
+    return in_scratch;
+}
+
+template <radix_key K, typename V>
+void radix_sort_in_place(K* keys, V* values, size_t size) {
+    if (size <= SORT_INSERTION_MAX) {
+        radix_sort(keys, keys, values, values, size);
+        return;
+    }
+
+    // Scratch is written before it is read, it is not initialized
+    auto key_scratch = std::make_unique_for_overwrite<K[]>(size);
+    std::unique_ptr<V[]> value_scratch;
+    if constexpr (!std::same_as<V, NoValues>) {
+        value_scratch = std::make_unique_for_overwrite<V[]>(size);
+    }
+
+    if (radix_sort(keys, key_scratch.get(), values, value_scratch.get(), size)) {
+        std::copy(key_scratch.get(), key_scratch.get() + size, keys);
+        if constexpr (!std::same_as<V, NoValues>) {
+            std::copy(value_scratch.get(), value_scratch.get() + size, values);
+        }
+    }
+}
+
+/*
+ * Parallel sample sort. Sorted random samples give a splitter per
+ * bucket, each chunk of the data counts its elements per bucket and
+ * moves them into a buffer at their bucket's place, then the buckets
+ * are sorted by sort_bucket(src, dst, size) into data, taken by the
+ * threads one after another. Equal elements share a bucket.
+ */
+template <typename T, typename Less, typename SortBucket>
+void sample_sort(T* data, size_t size, Less& less, SortBucket&& sort_bucket, size_t threads) {
+    const parallel::detail::Chunks chunks(data, size, sizeof(T), threads);
+    const size_t parts = chunks.size();
+    const size_t buckets = threads * SAMPLE_SORT_BUCKETS_PER_THREAD;
+
+    Array<T> splitters;
+    {
+        Array<T> samples;
+        samples.reserve(buckets * SAMPLE_SORT_OVERSAMPLING);
+        std::mt19937_64 gen(size);
+        for (size_t idx = 0; idx < buckets * SAMPLE_SORT_OVERSAMPLING; ++idx) {
+            samples.push_back(data[gen() % size]);
+        }
+        std::sort(samples.begin(), samples.end(), less);
+        splitters.reserve(buckets - 1);
+        for (size_t bucket = 1; bucket < buckets; ++bucket) {
+            splitters.push_back(samples[bucket * SAMPLE_SORT_OVERSAMPLING]);
+        }
+    }
+    auto bucket_of = [&](const T& value) {
+        return static_cast<size_t>(std::upper_bound(splitters.begin(), splitters.end(), value, less) - splitters.begin());
+    };
+
+    // offsets[part * buckets + bucket]: counts, then where the part writes in the bucket
+    Array<size_t> offsets(parts * buckets);
+    parallel::detail::run(chunks, [&](size_t part, size_t begin, size_t end) {
+        Array<size_t> counts(buckets);
+        for (size_t idx = begin; idx < end; ++idx) {
+            ++counts[bucket_of(data[idx])];
+        }
+        std::copy(counts.begin(), counts.end(), offsets.begin() + part * buckets);
+    });
+
+    Array<size_t> bucket_begin(buckets + 1);
+    size_t offset = 0;
+    for (size_t bucket = 0; bucket < buckets; ++bucket) {
+        bucket_begin[bucket] = offset;
+        for (size_t part = 0; part < parts; ++part) {
+            offset += std::exchange(offsets[part * buckets + bucket], offset);
+        }
+    }
+    bucket_begin[buckets] = size;
+
+    auto buffer = std::make_unique_for_overwrite<T[]>(size);
+    parallel::detail::run(chunks, [&](size_t part, size_t begin, size_t end) {
+        size_t* part_offsets = offsets.data() + part * buckets;
+        for (size_t idx = begin; idx < end; ++idx) {
+            buffer[part_offsets[bucket_of(data[idx])]++] = std::move(data[idx]);
+        }
+    });
+
+    std::atomic<size_t> next{0};
+    parallel::detail::run_tasks(std::min(threads, buckets), [&](size_t) {
+        for (size_t bucket = next++; bucket < buckets; bucket = next++) {
+            const size_t begin = bucket_begin[bucket];
+            sort_bucket(buffer.get() + begin, data + begin, bucket_begin[bucket + 1] - begin);
+        }
+    });
+}
+
+} // nostd::detail
+
+/*
+ * Sorts the array in ascending order with up to `threads` threads.
+ * Integer and IEEE float keys go through radix sort (floats in the
+ * order of radix_bits), other types through std::sort or comp.
+ * Up to SORT_INSERTION_MAX elements are insertion sorted, from
+ * SORT_PARALLEL_MIN on with more than one thread the array is split
+ * by a sample sort and the buckets are sorted in parallel.
+ */
+template <typename T, template <typename> typename Storage, typename Growth>
+void sort(Array<T, Storage, Growth>& array, size_t threads = parallel::default_threads());
+
+template <typename T, template <typename> typename Storage, typename Growth, typename Compare>
+    requires std::predicate<Compare&, const T&, const T&>
+void sort(Array<T, Storage, Growth>& array, Compare comp, size_t threads = parallel::default_threads());
+
+// Sorts keys by radix sort, values move with their keys. Stable,
+// std::invalid_argument if the sizes differ
+template <radix_key K, typename V, template <typename> typename KeyStorage, typename KeyGrowth,
+          template <typename> typename ValueStorage, typename ValueGrowth>
+    requires trivially_copyable<V>
+void sort_by_key(Array<K, KeyStorage, KeyGrowth>& keys, Array<V, ValueStorage, ValueGrowth>& values);
+
+// ============================================================================
+
+template <typename T, template <typename> typename Storage, typename Growth>
+void sort(Array<T, Storage, Growth>& array, size_t threads) {
+    if constexpr (radix_key<T>) {
+        T* data = array.data();
+        const size_t size = array.size();
+        if (threads <= 1 || size < detail::SORT_PARALLEL_MIN) {
+            detail::radix_sort_in_place(data, static_cast<detail::NoValues*>(nullptr), size);
+            return;
+        }
+
+        detail::RadixLess less;
+        detail::sample_sort(data, size, less, [](T* src, T* dst, size_t count) {
+            // The bucket sorts in the buffer with its place in data as scratch
+            detail::NoValues* values = nullptr;
+            if (!detail::radix_sort(src, dst, values, values, count)) {
+                std::copy(src, src + count, dst);
+            }
+        }, threads);
+    } else {
+        sort(array, std::less<>(), threads);
+    }
+}
+
+template <typename T, template <typename> typename Storage, typename Growth, typename Compare>
+    requires std::predicate<Compare&, const T&, const T&>
+void sort(Array<T, Storage, Growth>& array, Compare comp, size_t threads) {
+    T* data = array.data();
+    const size_t size = array.size();
+    if (size <= detail::SORT_INSERTION_MAX) {
+        detail::insertion_sort(data, static_cast<detail::NoValues*>(nullptr), size, comp);
+        return;
+    }
+    // Sample sort copies the samples and default-initializes its buffer
+    constexpr bool splittable = std::copyable<T> && std::default_initializable<T>;
+    if (!splittable || threads <= 1 || size < detail::SORT_PARALLEL_MIN) {
+        std::sort(data, data + size, comp);
+        return;
+    }
+
+    if constexpr (splittable) {
+        detail::sample_sort(data, size, comp, [&comp](T* src, T* dst, size_t count) {
+            std::sort(src, src + count, comp);
+            std::move(src, src + count, dst);
+        }, threads);
+    }
+}
+
+template <radix_key K, typename V, template <typename> typename KeyStorage, typename KeyGrowth,
+          template <typename> typename ValueStorage, typename ValueGrowth>
+    requires trivially_copyable<V>
+void sort_by_key(Array<K, KeyStorage, KeyGrowth>& keys, Array<V, ValueStorage, ValueGrowth>& values) {
+    if (keys.size() != values.size()) {
+        throw std::invalid_argument("keys and values differ in size");
+    }
+    detail::radix_sort_in_place(keys.data(), values.data(), keys.size());
+}
+
+} // nostd
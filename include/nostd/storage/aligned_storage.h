@@ -0,0 +1,134 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <new>
+
+#include <nostd/concepts/concepts.h>
+#include <nostd/storage/dynamic_storage.h>
+
+namespace nostd::storage {
+
+/*
+ * Heap buffer aligned to at least Alignment bytes (and alignof(T)),
+ * e.g. 64 for aligned AVX-512 loads of data().
+ * Blocks come from the aligned operator new; from MAP_THRESHOLD on they
+ * are mapped like in DynamicStorage, pages are aligned enough, and
+ * relocatable elements grow with mremap.
+ */
+template <typename T, size_t Alignment>
+struct AlignedStorageImpl {
+    static_assert(std::has_single_bit(Alignment), "alignment must be a power of two");
+
+    using value_type = T;
+    using size_type = size_t;
+
+    static constexpr size_t alignment = std::max(Alignment, alignof(T));
+
+    AlignedStorageImpl() noexcept = default;
+    void allocate(size_type cap);
+    void deallocate();
+    void swap(AlignedStorageImpl& other);
+
+    // Keeps elements, the buffer may move. False unless both blocks are mapped.
+    bool reallocate(size_type cap);
+
+    // Data
+    [[nodiscard]] size_type capacity() const;
+
+    template <typename... Args>
+    void construct(size_type idx, Args&&... args ) {
+        std::construct_at(data_ + idx, std::forward<Args>(args)...);
+    }
+    void destruct(size_type idx);
+
+    [[nodiscard]] const T& operator[](size_type idx) const;
+    [[nodiscard]] T& operator[](size_type idx);
+
+private:
+    // The smallest page size, mappings are aligned to it
+    static constexpr size_t MIN_PAGE_SIZE = size_t{4} << 10;
+
+    static bool mapped(size_type cap) {
+        return alignment <= MIN_PAGE_SIZE && detail::is_mapped_block(cap * sizeof(T));
+    }
+
+    T* data_{nullptr};
+    size_type capacity_{};
+};
+
+// ----------------------------------------------------------------------------
+
+template <typename T, size_t Alignment>
+void AlignedStorageImpl<T, Alignment>::allocate(size_type cap) {
+    if (cap == 0) {
+        return;
+    }
+
+    if (mapped(cap)) {
+        data_ = static_cast<T*>(detail::allocate_block(cap * sizeof(T)));
+    } else {
+        data_ = static_cast<T*>(::operator new(cap * sizeof(T), std::align_val_t{alignment}));
+    }
+    capacity_ = cap;
+}
+
+template <typename T, size_t Alignment>
+void AlignedStorageImpl<T, Alignment>::deallocate() {
+    if (capacity_ == 0) {
+        return;
+    }
+
+    if (mapped(capacity_)) {
+        detail::deallocate_block(data_, capacity_ * sizeof(T));
+    } else {
+        ::operator delete(data_, std::align_val_t{alignment});
+    }
+    data_ = nullptr;
+    capacity_ = 0;
+}
+
+template <typename T, size_t Alignment>
+bool AlignedStorageImpl<T, Alignment>::reallocate(size_type cap) {
+    // realloc does not keep the alignment, only the page table moves of mremap do
+    if (!trivially_relocatable<T> || !mapped(capacity_) || !mapped(cap)) {
+        return false;
+    }
+
+    void* block = detail::reallocate_block(data_, capacity_ * sizeof(T), cap * sizeof(T));
+    data_ = static_cast<T*>(block);
+    capacity_ = cap;
+    return true;
+}
+
+template <typename T, size_t Alignment>
+void AlignedStorageImpl<T, Alignment>::swap(AlignedStorageImpl& other) {
+    std::swap(capacity_, other.capacity_);
+    std::swap(data_, other.data_);
+}
+
+// ----------------------------------------------------------------------------
+
+template <typename T, size_t Alignment>
+typename AlignedStorageImpl<T, Alignment>::size_type AlignedStorageImpl<T, Alignment>::capacity() const {
+    return capacity_;
+}
+
+template <typename T, size_t Alignment>
+void AlignedStorageImpl<T, Alignment>::destruct(size_type idx) {
+    std::destroy_at(data_ + idx);
+}
+
+template <typename T, size_t Alignment>
+const T& AlignedStorageImpl<T, Alignment>::operator[](size_type idx) const {
+    return data_[idx];
+}
+
+template <typename T, size_t Alignment>
+T& AlignedStorageImpl<T, Alignment>::operator[](size_type idx) {
+    return data_[idx];
+}
+
+} // nostd::storage
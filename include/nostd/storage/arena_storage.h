@@ -0,0 +1,199 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <type_traits>
+
+#include <nostd/storage/dynamic_storage.h>
+
+namespace nostd::storage {
+
+/*
+ * Monotonic arena: allocations bump a pointer through large blocks and
+ * are freed together by release() or the destructor, e.g. everything
+ * built while serving one request.
+ * Deallocation is a no-op except for the latest allocation, whose bytes
+ * are handed out again, so temporaries freed in reverse order cost no
+ * memory. Buffers left behind by growth stay until release().
+ * Not thread safe.
+ */
+class Arena {
+public:
+    static constexpr size_t DEFAULT_BLOCK_SIZE = size_t{64} << 10;
+
+    explicit Arena(size_t block_size = DEFAULT_BLOCK_SIZE) noexcept;
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+    ~Arena();
+
+    [[nodiscard]] void* allocate(size_t bytes, size_t alignment);
+    void deallocate(void* ptr, size_t bytes) noexcept;
+
+    // Frees every allocation at once, one block is kept for reuse
+    void release() noexcept;
+
+    // Bytes of the blocks taken from malloc
+    [[nodiscard]] size_t reserved() const noexcept;
+
+private:
+    // Header in front of the bytes of each block
+    struct Block {
+        Block* next;
+        size_t size;
+    };
+
+    [[nodiscard]] void* allocate_block(size_t bytes, size_t alignment);
+
+    Block* head_ = nullptr;
+    std::byte* cur_ = nullptr;
+    std::byte* end_ = nullptr;
+    size_t block_size_;
+    size_t reserved_ = 0;
+};
+
+/*
+ * Allocator on an Arena, it does not own the arena. Copies of containers
+ * stay in the same arena, moves and swaps take it along.
+ */
+template <typename T>
+struct ArenaAllocator {
+    using value_type = T;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    // Implicit, so Array(arena) builds an array in the arena
+    ArenaAllocator(Arena& arena) noexcept // NOLINT
+        : arena_(&arena) {
+    }
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept // NOLINT
+        : arena_(&other.arena()) {
+    }
+
+    [[nodiscard]] T* allocate(size_t count) {
+        if (count > SIZE_MAX / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        return static_cast<T*>(arena_->allocate(count * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* ptr, size_t count) noexcept {
+        arena_->deallocate(ptr, count * sizeof(T));
+    }
+
+    [[nodiscard]] Arena& arena() const noexcept {
+        return *arena_;
+    }
+
+    template <typename U>
+    friend bool operator==(const ArenaAllocator& lhs, const ArenaAllocator<U>& rhs) noexcept {
+        return &lhs.arena() == &rhs.arena();
+    }
+
+private:
+    Arena* arena_;
+};
+
+// Arrays in an Arena, constructed with it: Array<T, ArenaStorage::storage_type> array(arena)
+struct ArenaStorage {
+    template <typename T>
+    using storage_type = DynamicStorageImpl<T, ArenaAllocator<T>>;
+};
+
+// ========================== Arena ===========================================
+// ----------------------------------------------------------------------------
+
+inline Arena::Arena(size_t block_size) noexcept
+    : block_size_(std::max(block_size, sizeof(Block))) {
+}
+
+inline Arena::~Arena() {
+    release();
+    std::free(head_);
+}
+
+inline void* Arena::allocate(size_t bytes, size_t alignment) {
+    const auto cur = reinterpret_cast<uintptr_t>(cur_);
+    const auto aligned = (cur + alignment - 1) & ~(alignment - 1);
+    if (cur_ != nullptr && aligned - cur <= static_cast<size_t>(end_ - cur_) &&
+        bytes <= static_cast<size_t>(end_ - cur_) - (aligned - cur)) {
+        cur_ = reinterpret_cast<std::byte*>(aligned + bytes);
+        return reinterpret_cast<void*>(aligned);
+    }
+    return allocate_block(bytes, alignment);
+}
+
+inline void Arena::deallocate(void* ptr, size_t bytes) noexcept {
+    if (static_cast<std::byte*>(ptr) + bytes == cur_) {
+        cur_ = static_cast<std::byte*>(ptr);
+    }
+}
+
+inline void Arena::release() noexcept {
+    // One regular block is kept for reuse, dedicated ones are larger
+    Block* kept = nullptr;
+    for (Block* block = head_; block != nullptr;) {
+        Block* next = block->next;
+        if (kept == nullptr && block->size == block_size_) {
+            kept = block;
+        } else {
+            reserved_ -= block->size;
+            std::free(block);
+        }
+        block = next;
+    }
+
+    head_ = kept;
+    if (kept == nullptr) {
+        cur_ = nullptr;
+        end_ = nullptr;
+        return;
+    }
+    kept->next = nullptr;
+    cur_ = reinterpret_cast<std::byte*>(kept + 1);
+    end_ = reinterpret_cast<std::byte*>(kept) + kept->size;
+}
+
+inline size_t Arena::reserved() const noexcept {
+    return reserved_;
+}
+
+// ----------------------------------------------------------------------------
+
+inline void* Arena::allocate_block(size_t bytes, size_t alignment) {
+    // Room for the header, the alignment gap and the bytes
+    const size_t padding = sizeof(Block) + std::max(alignment, alignof(std::max_align_t));
+    if (bytes > SIZE_MAX - padding) {
+        throw std::bad_alloc();
+    }
+    const bool dedicated = bytes + padding > block_size_;
+    const size_t size = dedicated ? bytes + padding : block_size_;
+
+    auto* block = static_cast<Block*>(std::malloc(size));
+    if (block == nullptr) {
+        throw std::bad_alloc();
+    }
+    block->size = size;
+    reserved_ += size;
+
+    auto* begin = reinterpret_cast<std::byte*>(block + 1);
+    if (dedicated && head_ != nullptr) {
+        // Large requests get a block of their own behind the current one, which stays in use
+        block->next = head_->next;
+        head_->next = block;
+        const auto aligned = (reinterpret_cast<uintptr_t>(begin) + alignment - 1) & ~(alignment - 1);
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    block->next = head_;
+    head_ = block;
+    cur_ = begin;
+    end_ = reinterpret_cast<std::byte*>(block) + size;
+    return allocate(bytes, alignment);
+}
+
+} // nostd::storage
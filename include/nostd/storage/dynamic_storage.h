@@ -1,19 +1,132 @@
 #pragma once
 
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include <nostd/concepts/concepts.h>
+
 namespace nostd::storage {
 
+namespace detail {
+
+/*
+ * Raw blocks for relocatable elements: small ones come from malloc
+ * and grow with realloc, page-sized ones are mapped and grow with
+ * mremap, so the kernel moves page tables instead of copying bytes.
+ */
+inline constexpr size_t MAP_THRESHOLD = size_t{1} << 20;
+
+inline bool is_mapped_block(size_t bytes) {
+#if defined(__linux__)
+    return bytes >= MAP_THRESHOLD;
+#else
+    return false;
+#endif
+}
+
+inline size_t round_to_pages(size_t bytes) {
+#if defined(__linux__)
+    static const auto page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    return (bytes + page_size - 1) / page_size * page_size;
+#else
+    return bytes;
+#endif
+}
+
+inline void* allocate_block(size_t bytes) {
+#if defined(__linux__)
+    if (is_mapped_block(bytes)) {
+        void* ptr = mmap(nullptr, round_to_pages(bytes), PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (ptr == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        return ptr;
+    }
+#endif
+
+    void* ptr = std::malloc(bytes);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+inline void deallocate_block(void* ptr, size_t bytes) {
+#if defined(__linux__)
+    if (is_mapped_block(bytes)) {
+        munmap(ptr, round_to_pages(bytes));
+        return;
+    }
+#endif
+
+    std::free(ptr);
+}
+
+inline void* reallocate_block(void* ptr, size_t old_bytes, size_t new_bytes) {
+    bool old_mapped = is_mapped_block(old_bytes);
+    bool new_mapped = is_mapped_block(new_bytes);
+
+    if (!old_mapped && !new_mapped) {
+        void* new_ptr = std::realloc(ptr, new_bytes);
+        if (new_ptr == nullptr) {
+            throw std::bad_alloc();
+        }
+        return new_ptr;
+    }
+
+#if defined(__linux__)
+    if (old_mapped && new_mapped) {
+        void* new_ptr = mremap(ptr, round_to_pages(old_bytes), round_to_pages(new_bytes), MREMAP_MAYMOVE);
+        if (new_ptr == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        return new_ptr;
+    }
+#endif
+
+    void* new_ptr = allocate_block(new_bytes);
+    std::memcpy(new_ptr, ptr, std::min(old_bytes, new_bytes));
+    deallocate_block(ptr, old_bytes);
+    return new_ptr;
+}
+
+} // nostd::storage::detail
+
+// ----------------------------------------------------------------------------
+
 template <typename T, typename Allocator = std::allocator<T>>
     requires std::is_same_v<T, typename Allocator::value_type>
 struct DynamicStorageImpl {
     using value_type = T;
     using size_type = size_t;
+    using allocator_type = Allocator;
+
+    // std::allocator has no state, so its memory can be taken from malloc
+    static constexpr bool raw_blocks =
+        std::is_same_v<Allocator, std::allocator<T>> &&
+        trivially_relocatable<T> &&
+        alignof(T) <= alignof(std::max_align_t);
 
     explicit DynamicStorageImpl(const Allocator& alloc = Allocator()) noexcept;
     void allocate(size_type cap);
     void deallocate();
     void swap(DynamicStorageImpl& other);
 
+    // Keeps elements, the buffer may move. Only for raw blocks,
+    // other storages are not reallocatable_storage
+    bool reallocate(size_type cap) requires raw_blocks;
+
     // Data
+    [[nodiscard]] allocator_type get_allocator() const;
     [[nodiscard]] size_type capacity() const;
 
     template <typename... Args>
@@ -48,7 +161,11 @@ void DynamicStorageImpl<T, Allocator>::allocate(size_type cap) {
         return;
     }
 
-    data_ = traits_t::allocate(alloc_, cap);
+    if constexpr (raw_blocks) {
+        data_ = static_cast<T*>(detail::allocate_block(cap * sizeof(T)));
+    } else {
+        data_ = traits_t::allocate(alloc_, cap);
+    }
     capacity_ = cap;
 }
 
@@ -59,7 +176,28 @@ void DynamicStorageImpl<T, Allocator>::deallocate() {
         return;
     }
 
-    traits_t::deallocate(alloc_, data_, capacity_);
+    if constexpr (raw_blocks) {
+        detail::deallocate_block(data_, capacity_ * sizeof(T));
+    } else {
+        traits_t::deallocate(alloc_, data_, capacity_);
+    }
+    data_ = nullptr;
+    capacity_ = 0;
+}
+
+template <typename T, typename Allocator>
+    requires std::is_same_v<T, typename Allocator::value_type>
+bool DynamicStorageImpl<T, Allocator>::reallocate(size_type cap) requires raw_blocks {
+    if (capacity_ == 0) {
+        allocate(cap);
+    } else if (cap == 0) {
+        deallocate();
+    } else {
+        void* block = detail::reallocate_block(data_, capacity_ * sizeof(T), cap * sizeof(T));
+        data_ = static_cast<T*>(block);
+        capacity_ = cap;
+    }
+    return true;
 }
 
 template <typename T, typename Allocator>
@@ -72,6 +210,12 @@ void DynamicStorageImpl<T, Allocator>::swap(DynamicStorageImpl& other) {
 
 // ----------------------------------------------------------------------------
 
+template <typename T, typename Allocator>
+    requires std::is_same_v<T, typename Allocator::value_type>
+typename DynamicStorageImpl<T, Allocator>::allocator_type DynamicStorageImpl<T, Allocator>::get_allocator() const {
+    return alloc_;
+}
+
 template <typename T, typename Allocator>
     requires std::is_same_v<T, typename Allocator::value_type>
 typename DynamicStorageImpl<T, Allocator>::size_type DynamicStorageImpl<T, Allocator>::capacity() const {
@@ -0,0 +1,259 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+
+#include <sys/mman.h>
+
+#include <nostd/storage/dynamic_storage.h>
+
+namespace nostd::storage {
+
+enum class PageKind {
+    // Base pages, for buffers smaller than a huge page
+    Regular,
+    // Aligned to huge pages and advised with MADV_HUGEPAGE, the kernel
+    // backs them with huge pages when it can (transparent huge pages)
+    Transparent,
+    // Reserved huge pages of hugetlbfs
+    HugeTlb,
+};
+
+/*
+ * Storage in anonymous mappings backed by 2 MiB pages, Linux only.
+ * Meant for large arrays whose random accesses miss the TLB: one huge
+ * page entry covers what takes 512 base page entries.
+ *
+ * From HUGE_PAGE_SIZE bytes on the buffer is taken from the reserved
+ * huge pages (MAP_HUGETLB), or, when none are reserved, mapped aligned
+ * to 2 MiB and advised for transparent huge pages. Without either it is
+ * ordinary memory. Smaller buffers are plain page-rounded mappings.
+ * Growth moves page tables with mremap, pair with growth::HugePageGranular.
+ */
+template <typename T>
+struct HugePageStorageImpl {
+    using value_type = T;
+    using size_type = size_t;
+
+    static constexpr size_t HUGE_PAGE_SIZE = size_t{2} << 20;
+
+    HugePageStorageImpl() noexcept = default;
+    void allocate(size_type cap);
+    void deallocate();
+    void swap(HugePageStorageImpl& other);
+
+    // Keeps elements, the mapping may move. False when the page kind changes.
+    bool reallocate(size_type cap);
+
+    // Data
+    [[nodiscard]] size_type capacity() const;
+    [[nodiscard]] PageKind page_kind() const;
+
+    template <typename... Args>
+    void construct(size_type idx, Args&&... args ) {
+        std::construct_at(data_ + idx, std::forward<Args>(args)...);
+    }
+    void destruct(size_type idx);
+
+    [[nodiscard]] const T& operator[](size_type idx) const;
+    [[nodiscard]] T& operator[](size_type idx);
+
+private:
+    static size_type round_to_huge_pages(size_type bytes);
+    // Mapping of bytes at a HUGE_PAGE_SIZE boundary, prot is PROT_NONE for reservations
+    static void* map_aligned(size_type bytes, int prot);
+
+    void assign(void* ptr, size_type bytes, PageKind kind);
+
+    T* data_ = nullptr;
+    size_type capacity_ = 0;
+    size_type bytes_ = 0;  // mapped length
+    PageKind kind_ = PageKind::Regular;
+};
+
+template <typename T>
+using HugePageStorage = HugePageStorageImpl<T>;
+
+// ========================== Allocation ======================================
+// ----------------------------------------------------------------------------
+
+template <typename T>
+void HugePageStorageImpl<T>::allocate(size_type cap) {
+    if (cap == 0) {
+        return;
+    }
+
+    const size_type bytes = cap * sizeof(T);
+    if (bytes < HUGE_PAGE_SIZE) {
+        const size_type pages = detail::round_to_pages(bytes);
+        void* ptr = mmap(nullptr, pages, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (ptr == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        assign(ptr, pages, PageKind::Regular);
+        return;
+    }
+
+    const size_type huge = round_to_huge_pages(bytes);
+#if defined(MAP_HUGETLB) && defined(MAP_HUGE_SHIFT)
+    // Fails with ENOMEM unless the administrator reserved enough pages
+    void* ptr = mmap(nullptr, huge, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | (21 << MAP_HUGE_SHIFT), -1, 0);
+    if (ptr != MAP_FAILED) {
+        assign(ptr, huge, PageKind::HugeTlb);
+        return;
+    }
+#endif
+
+    void* aligned = map_aligned(huge, PROT_READ | PROT_WRITE);
+#if defined(MADV_HUGEPAGE)
+    // Only a hint, fails when transparent huge pages are compiled out
+    madvise(aligned, huge, MADV_HUGEPAGE);
+#endif
+    assign(aligned, huge, PageKind::Transparent);
+}
+
+template <typename T>
+void HugePageStorageImpl<T>::deallocate() {
+    if (data_ != nullptr) {
+        munmap(data_, bytes_);
+    }
+
+    data_ = nullptr;
+    capacity_ = 0;
+    bytes_ = 0;
+    kind_ = PageKind::Regular;
+}
+
+template <typename T>
+void HugePageStorageImpl<T>::swap(HugePageStorageImpl& other) {
+    std::swap(data_, other.data_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(bytes_, other.bytes_);
+    std::swap(kind_, other.kind_);
+}
+
+template <typename T>
+bool HugePageStorageImpl<T>::reallocate(size_type cap) {
+    if (data_ == nullptr) {
+        allocate(cap);
+        return true;
+    }
+    if (cap == 0) {
+        deallocate();
+        return true;
+    }
+
+    const size_type bytes = cap * sizeof(T);
+    if ((bytes < HUGE_PAGE_SIZE) != (kind_ == PageKind::Regular)) {
+        // Array copies the elements once, to a mapping of the right kind
+        return false;
+    }
+
+    if (kind_ == PageKind::Regular) {
+        const size_type pages = detail::round_to_pages(bytes);
+        void* ptr = mremap(data_, bytes_, pages, MREMAP_MAYMOVE);
+        if (ptr == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        assign(ptr, pages, kind_);
+        return true;
+    }
+
+    const size_type huge = round_to_huge_pages(bytes);
+    // In place first, it keeps the alignment
+    void* ptr = mremap(data_, bytes_, huge, 0);
+    if (ptr == MAP_FAILED && kind_ == PageKind::HugeTlb) {
+        // The kernel places huge page mappings at huge page boundaries itself;
+        // older kernels refuse to move them, then Array copies
+        ptr = mremap(data_, bytes_, huge, MREMAP_MAYMOVE);
+        if (ptr == MAP_FAILED) {
+            return false;
+        }
+    } else if (ptr == MAP_FAILED) {
+        // Moved over an aligned reservation, a plain MREMAP_MAYMOVE could split the huge pages
+        void* target = map_aligned(huge, PROT_NONE);
+        ptr = mremap(data_, bytes_, huge, MREMAP_MAYMOVE | MREMAP_FIXED, target);
+        if (ptr == MAP_FAILED) {
+            munmap(target, huge);
+            throw std::bad_alloc();
+        }
+    }
+
+#if defined(MADV_HUGEPAGE)
+    if (kind_ == PageKind::Transparent) {
+        madvise(ptr, huge, MADV_HUGEPAGE);
+    }
+#endif
+    assign(ptr, huge, kind_);
+    return true;
+}
+
+// ========================== Data ============================================
+// ----------------------------------------------------------------------------
+
+template <typename T>
+typename HugePageStorageImpl<T>::size_type HugePageStorageImpl<T>::capacity() const {
+    return capacity_;
+}
+
+template <typename T>
+PageKind HugePageStorageImpl<T>::page_kind() const {
+    return kind_;
+}
+
+template <typename T>
+void HugePageStorageImpl<T>::destruct(size_type idx) {
+    std::destroy_at(data_ + idx);
+}
+
+template <typename T>
+const T& HugePageStorageImpl<T>::operator[](size_type idx) const {
+    return data_[idx];
+}
+
+template <typename T>
+T& HugePageStorageImpl<T>::operator[](size_type idx) {
+    return data_[idx];
+}
+
+// ----------------------------------------------------------------------------
+
+template <typename T>
+typename HugePageStorageImpl<T>::size_type HugePageStorageImpl<T>::round_to_huge_pages(size_type bytes) {
+    return (bytes + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+}
+
+template <typename T>
+void* HugePageStorageImpl<T>::map_aligned(size_type bytes, int prot) {
+    // Over-map by one huge page and trim both ends to the boundary
+    const size_type length = bytes + HUGE_PAGE_SIZE;
+    void* ptr = mmap(nullptr, length, prot, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (ptr == MAP_FAILED) {
+        throw std::bad_alloc();
+    }
+
+    const auto begin = reinterpret_cast<uintptr_t>(ptr);
+    const auto aligned = (begin + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+    if (aligned != begin) {
+        munmap(ptr, aligned - begin);
+    }
+    if (const size_type tail = begin + length - (aligned + bytes); tail != 0) {
+        munmap(reinterpret_cast<void*>(aligned + bytes), tail);
+    }
+    return reinterpret_cast<void*>(aligned);
+}
+
+template <typename T>
+void HugePageStorageImpl<T>::assign(void* ptr, size_type bytes, PageKind kind) {
+    data_ = static_cast<T*>(ptr);
+    bytes_ = bytes;
+    // The rest of the last page comes for free
+    capacity_ = bytes / sizeof(T);
+    kind_ = kind;
+}
+
+} // nostd::storage
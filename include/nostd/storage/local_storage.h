@@ -1,65 +1,128 @@
 #pragma once
 
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <utility>
 
 namespace nostd::storage {
 
+namespace detail {
+
+// Swaps constructed prefixes of two inline buffers, the longer tail is moved over.
+// The tail is destroyed only once all of it is moved: on exception the moved
+// elements are destroyed again and both buffers keep their sizes.
+template <typename Storage>
+constexpr void swap_constructed(Storage& lhs, Storage& rhs, size_t lhs_size, size_t rhs_size) {
+    using std::swap;
+
+    const size_t common = std::min(lhs_size, rhs_size);
+    for (size_t idx = 0; idx < common; ++idx) {
+        swap(lhs[idx], rhs[idx]);
+    }
+
+    Storage& from = lhs_size > rhs_size ? lhs : rhs;
+    Storage& to = lhs_size > rhs_size ? rhs : lhs;
+    const size_t from_size = std::max(lhs_size, rhs_size);
+
+    size_t idx = common;
+    try {
+        for (; idx < from_size; ++idx) {
+            to.construct(idx, std::move(from[idx]));
+        }
+    }
+    catch (...) {
+        while (idx-- > common) {
+            to.destruct(idx);
+        }
+        throw;
+    }
+
+    for (idx = common; idx < from_size; ++idx) {
+        from.destruct(idx);
+    }
+}
+
+} // nostd::storage::detail
+
+// ----------------------------------------------------------------------------
+
+/*
+ * Fixed buffer inside the object, never touches an allocator.
+ * Elements live in a union, so it is usable in constant evaluation.
+ */
 template <typename T, size_t Capacity>
 struct LocalStorageImpl {
+    static_assert(Capacity != 0, "local storage must not be empty");
+
     using value_type = T;
     using size_type = size_t;
-    static constexpr auto value_size = sizeof(T);
 
-    LocalStorageImpl() = default;
-    void allocate(size_type cap);
-    void deallocate();
-    void swap(LocalStorageImpl& other);
+    constexpr LocalStorageImpl() noexcept;
+    constexpr ~LocalStorageImpl() {}
 
-    [[nodiscard]] size_type capacity() const;
+    // Throws std::length_error if cap does not fit
+    constexpr void allocate(size_type cap);
+    constexpr void deallocate();
+    constexpr void swap(LocalStorageImpl& other, size_type size, size_type other_size);
+
+    [[nodiscard]] constexpr size_type capacity() const;
 
     template <typename... Args>
-    void construct(size_type idx, Args&&... args ) {
-        new(data_ + idx * value_size) T(std::forward<Args>(args)...);
+    constexpr void construct(size_type idx, Args&&... args ) {
+        std::construct_at(data_ + idx, std::forward<Args>(args)...);
     }
-    void destruct(size_type idx);
+    constexpr void destruct(size_type idx);
 
-    [[nodiscard]] const T& operator[](size_type idx) const;
-    [[nodiscard]] T& operator[](size_type idx);
+    [[nodiscard]] constexpr const T& operator[](size_type idx) const;
+    [[nodiscard]] constexpr T& operator[](size_type idx);
 private:
-    alignas(sizeof(T)) char data_[Capacity * sizeof(T)];
+    union {
+        char empty_;
+        T data_[Capacity];
+    };
 };
 
 template <typename T, size_t Capacity>
-void LocalStorageImpl<T, Capacity>::allocate(size_type cap) {
+constexpr LocalStorageImpl<T, Capacity>::LocalStorageImpl() noexcept
+    : empty_() {
+}
+
+template <typename T, size_t Capacity>
+constexpr void LocalStorageImpl<T, Capacity>::allocate(size_type cap) {
+    if (cap > Capacity) {
+        throw std::length_error("LocalStorage capacity exceeded");
+    }
 }
 
 template <typename T, size_t Capacity>
-void LocalStorageImpl<T, Capacity>::deallocate() {
+constexpr void LocalStorageImpl<T, Capacity>::deallocate() {
 }
 
 template <typename T, size_t Capacity>
-void LocalStorageImpl<T, Capacity>::swap(LocalStorageImpl& other) {
-    // TODO add swapping
+constexpr void LocalStorageImpl<T, Capacity>::swap(LocalStorageImpl& other, size_type size, size_type other_size) {
+    detail::swap_constructed(*this, other, size, other_size);
 }
 
 // ----------------------------------------------------------------------------
 
 template <typename T, size_t Capacity>
-typename LocalStorageImpl<T, Capacity>::size_type LocalStorageImpl<T, Capacity>::capacity() const {
+constexpr typename LocalStorageImpl<T, Capacity>::size_type LocalStorageImpl<T, Capacity>::capacity() const {
     return Capacity;
 }
 
 template <typename T, size_t Capacity>
-void LocalStorageImpl<T, Capacity>::destruct(size_type idx) {
-    reinterpret_cast<T*>(data_ + idx * value_size)->~T();
+constexpr void LocalStorageImpl<T, Capacity>::destruct(size_type idx) {
+    std::destroy_at(data_ + idx);
 }
 
 template <typename T, size_t Capacity>
-const typename LocalStorageImpl<T, Capacity>::value_type& LocalStorageImpl<T, Capacity>::operator[](size_type idx) const {
-    return *reinterpret_cast<const T*>(data_ + idx * value_size);
+constexpr const typename LocalStorageImpl<T, Capacity>::value_type& LocalStorageImpl<T, Capacity>::operator[](size_type idx) const {
+    return data_[idx];
 }
 template <typename T, size_t Capacity>
-typename LocalStorageImpl<T, Capacity>::value_type& LocalStorageImpl<T, Capacity>::operator[](size_type idx) {
-    return *reinterpret_cast<T*>(data_ + idx * value_size);
+constexpr typename LocalStorageImpl<T, Capacity>::value_type& LocalStorageImpl<T, Capacity>::operator[](size_type idx) {
+    return data_[idx];
 }
 
 } // nostd::storage
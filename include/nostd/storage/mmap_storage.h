@@ -0,0 +1,369 @@
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <nostd/concepts/concepts.h>
+#include <nostd/storage/dynamic_storage.h>
+
+namespace nostd::storage {
+
+enum class MapMode {
+    // PROT_READ only, pages are shared with every process mapping the file
+    ReadOnly,
+    // Copy-on-write, changes stay in this process
+    Private,
+    // Changes go to the file, growth extends it
+    Shared,
+};
+
+/*
+ * Storage in a memory mapping, POSIX only.
+ * Default constructed storages map anonymous memory. open() and create()
+ * map a file, the bytes of the file are the elements, so T must be
+ * trivially copyable; Array(std::move(storage)) adopts them.
+ *
+ * Anonymous maps grow with mremap, shared ones with ftruncate + mremap
+ * and keep capacity() elements in the file (shrink_to_fit() truncates
+ * it to the size). Read-only and private file maps cannot grow in
+ * place: Array moves their elements to an anonymous map instead.
+ * Writing to a read-only map faults, like writing through const.
+ */
+template <typename T>
+    requires trivially_copyable<T>
+struct MmapStorageImpl {
+    using value_type = T;
+    using size_type = size_t;
+
+    MmapStorageImpl() noexcept = default;
+    MmapStorageImpl(MmapStorageImpl&& other) noexcept;
+    MmapStorageImpl& operator=(MmapStorageImpl&& other) noexcept;
+    ~MmapStorageImpl();
+
+    // Maps the whole file, capacity() is its length in elements
+    static MmapStorageImpl open(const std::string& path, MapMode mode);
+    // Creates or truncates the file to cap elements and maps it shared
+    static MmapStorageImpl create(const std::string& path, size_type cap = 0);
+
+    void allocate(size_type cap);
+    void deallocate();
+    void swap(MmapStorageImpl& other);
+
+    // Keeps elements, the mapping may move. False for read-only and private file maps.
+    bool reallocate(size_type cap);
+
+    // Flushes a shared map to the file
+    void sync();
+
+    // Data
+    [[nodiscard]] size_type capacity() const;
+    [[nodiscard]] MapMode mode() const;
+    [[nodiscard]] bool file_backed() const;
+
+    template <typename... Args>
+    void construct(size_type idx, Args&&... args ) {
+        std::construct_at(data_ + idx, std::forward<Args>(args)...);
+    }
+    void destruct(size_type idx);
+
+    [[nodiscard]] const T& operator[](size_type idx) const;
+    [[nodiscard]] T& operator[](size_type idx);
+
+private:
+    [[noreturn]] static void fail(const char* what);
+
+    void map_file(size_type bytes);
+    void resize_file(size_type bytes);
+
+    T* data_ = nullptr;
+    size_type capacity_ = 0;
+    size_type bytes_ = 0;  // mapped length
+    int fd_ = -1;          // kept open by shared maps only
+    bool file_ = false;
+    MapMode mode_ = MapMode::Private;
+};
+
+template <typename T>
+using MmapStorage = MmapStorageImpl<T>;
+
+// ========================== Creating ========================================
+// ----------------------------------------------------------------------------
+
+template <typename T>
+    requires trivially_copyable<T>
+MmapStorageImpl<T>::MmapStorageImpl(MmapStorageImpl&& other) noexcept {
+    swap(other);
+}
+
+template <typename T>
+    requires trivially_copyable<T>
+MmapStorageImpl<T>& MmapStorageImpl<T>::operator=(MmapStorageImpl&& other) noexcept {
+    if (this != &other) {
+        deallocate();
+        swap(other);
+    }
+    return *this;
+}
+
+template <typename T>
+    requires trivially_copyable<T>
+MmapStorageImpl<T>::~MmapStorageImpl() {
+    deallocate();
+}
+
+template <typename T>
+    requires trivially_copyable<T>
+MmapStorageImpl<T> MmapStorageImpl<T>::open(const std::string& path, MapMode mode) {
+    MmapStorageImpl storage;
+    storage.file_ = true;
+    storage.mode_ = mode;
+
+    storage.fd_ = ::open(path.c_str(), (mode == MapMode::Shared ? O_RDWR : O_RDONLY) | O_CLOEXEC);
+    if (storage.fd_ < 0) {
+        fail("MmapStorage: open failed");
+    }
+
+    struct stat st{};
+    if (fstat(storage.fd_, &st) != 0) {
+        fail("MmapStorage: fstat failed");
+    }
+    const auto bytes = static_cast<size_type>(st.st_size);
+    if (bytes % sizeof(T) != 0) {
+        throw std::invalid_argument("MmapStorage: file length is not a multiple of the element size");
+    }
+
+    storage.map_file(bytes);
+    if (mode != MapMode::Shared) {
+        // The mapping keeps the file alive, only shared maps resize it later
+        ::close(storage.fd_);
+        storage.fd_ = -1;
+    }
+    return storage;
+}
+
+template <typename T>
+    requires trivially_copyable<T>
+MmapStorageImpl<T> MmapStorageImpl<T>::create(const std::string& path, size_type cap) {
+    MmapStorageImpl storage;
+    storage.file_ = true;
+    storage.mode_ = MapMode::Shared;
+
+    storage.fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (storage.fd_ < 0) {
+        fail("MmapStorage: create failed");
+    }
+
+    storage.resize_file(cap * sizeof(T));
+    storage.map_file(cap * sizeof(T));
+    return storage;
+}
+
+// ========================== Allocation ======================================
+// ----------------------------------------------------------------------------
+
+template <typename T>
+    requires trivially_copyable<T>
+void MmapStorageImpl<T>::allocate(size_type cap) {
+    if (file_) {
+        if (mode_ != MapMode::Shared) {
+            throw std::logic_error("MmapStorage: read-only and private file maps cannot allocate");
+        }
+        resize_file(cap * sizeof(T));
+        map_file(cap * sizeof(T));
+        return;
+    }
+
+    if (cap == 0) {
+        return;
+    }
+
+    const size_type bytes = detail::round_to_pages(cap * sizeof(T));
+    void* ptr = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (ptr == MAP_FAILED) {
+        throw std::bad_alloc();
+    }
+
+    data_ = static_cast<T*>(ptr);
+    bytes_ = bytes;
+    // The rest of the last page comes for free
+    capacity_ = bytes / sizeof(T);
+}
+
+template <typename T>
+    requires trivially_copyable<T>
+void MmapStorageImpl<T>::deallocate() {
+    if (data_ != nullptr) {
+        munmap(data_, bytes_);
+    }
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+
+    data_ = nullptr;
+    capacity_ = 0;
+    bytes_ = 0;
+    fd_ = -1;
+    file_ = false;
+    mode_ = MapMode::Private;
+}
+
+template <typename T>
+    requires trivially_copyable<T>
+void MmapStorageImpl<T>::swap(MmapStorageImpl& other) {
+    std::swap(data_, other.data_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(bytes_, other.bytes_);
+    std::swap(fd_, other.fd_);
+    std::swap(file_, other.file_);
+    std::swap(mode_, other.mode_);
+}
+
+template <typename T>
+    requires trivially_copyable<T>
+bool MmapStorageImpl<T>::reallocate(size_type cap) {
+    if (file_ && mode_ != MapMode::Shared) {
+        return false;
+    }
+    if (data_ == nullptr) {
+        allocate(cap);
+        return true;
+    }
+    if (cap == 0) {
+        munmap(data_, bytes_);
+        data_ = nullptr;
+        capacity_ = 0;
+        bytes_ = 0;
+        if (file_) {
+            resize_file(0);
+        }
+        return true;
+    }
+
+    if (!file_) {
+        const size_type bytes = detail::round_to_pages(cap * sizeof(T));
+        void* ptr = mremap(data_, bytes_, bytes, MREMAP_MAYMOVE);
+        if (ptr == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+
+        data_ = static_cast<T*>(ptr);
+        bytes_ = bytes;
+        capacity_ = bytes / sizeof(T);
+        return true;
+    }
+
+    const size_type bytes = cap * sizeof(T);
+    // Pages past the end of the file fault, so it grows before the map and shrinks after it
+    const size_type old_bytes = bytes_;
+    if (bytes > old_bytes) {
+        resize_file(bytes);
+    }
+    void* ptr = mremap(data_, old_bytes, bytes, MREMAP_MAYMOVE);
+    if (ptr == MAP_FAILED) {
+        fail("MmapStorage: mremap failed");
+    }
+    data_ = static_cast<T*>(ptr);
+    bytes_ = bytes;
+    capacity_ = cap;
+    if (bytes < old_bytes) {
+        resize_file(bytes);
+    }
+    return true;
+}
+
+template <typename T>
+    requires trivially_copyable<T>
+void MmapStorageImpl<T>::sync() {
+    if (data_ != nullptr && file_ && mode_ == MapMode::Shared && msync(data_, bytes_, MS_SYNC) != 0) {
+        fail("MmapStorage: msync failed");
+    }
+}
+
+// ========================== Data ============================================
+// ----------------------------------------------------------------------------
+
+template <typename T>
+    requires trivially_copyable<T>
+typename MmapStorageImpl<T>::size_type MmapStorageImpl<T>::capacity() const {
+    return capacity_;
+}
+
+template <typename T>
+    requires trivially_copyable<T>
+MapMode MmapStorageImpl<T>::mode() const {
+    return mode_;
+}
+
+template <typename T>
+    requires trivially_copyable<T>
+bool MmapStorageImpl<T>::file_backed() const {
+    return file_;
+}
+
+template <typename T>
+    requires trivially_copyable<T>
+void MmapStorageImpl<T>::destruct(size_type idx) {
+    std::destroy_at(data_ + idx);
+}
+
+template <typename T>
+    requires trivially_copyable<T>
+const T& MmapStorageImpl<T>::operator[](size_type idx) const {
+    return data_[idx];
+}
+
+template <typename T>
+    requires trivially_copyable<T>
+T& MmapStorageImpl<T>::operator[](size_type idx) {
+    return data_[idx];
+}
+
+// ----------------------------------------------------------------------------
+
+template <typename T>
+    requires trivially_copyable<T>
+void MmapStorageImpl<T>::fail(const char* what) {
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+template <typename T>
+    requires trivially_copyable<T>
+void MmapStorageImpl<T>::map_file(size_type bytes) {
+    capacity_ = bytes / sizeof(T);
+    bytes_ = bytes;
+    if (bytes == 0) {
+        // Empty files cannot be mapped, growth maps them later
+        return;
+    }
+
+    const int prot = mode_ == MapMode::ReadOnly ? PROT_READ : PROT_READ | PROT_WRITE;
+    const int flags = mode_ == MapMode::Private ? MAP_PRIVATE : MAP_SHARED;
+    void* ptr = mmap(nullptr, bytes, prot, flags, fd_, 0);
+    if (ptr == MAP_FAILED) {
+        capacity_ = 0;
+        bytes_ = 0;
+        fail("MmapStorage: mmap failed");
+    }
+    data_ = static_cast<T*>(ptr);
+}
+
+template <typename T>
+    requires trivially_copyable<T>
+void MmapStorageImpl<T>::resize_file(size_type bytes) {
+    if (ftruncate(fd_, static_cast<off_t>(bytes)) != 0) {
+        fail("MmapStorage: ftruncate failed");
+    }
+}
+
+} // nostd::storage
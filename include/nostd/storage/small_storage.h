@@ -0,0 +1,183 @@
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+#include <nostd/storage/local_storage.h>
+
+namespace nostd::storage {
+
+/*
+ * Keeps up to Inline elements in place, bigger buffers go to Allocator.
+ * Inline elements can not be pointer-swapped, so swap takes the counts
+ * of constructed elements and moves them. Swap is noexcept like
+ * Array::swap: a move constructor that throws there terminates.
+ */
+template <typename T, size_t Inline, typename Allocator = std::allocator<T>>
+    requires std::is_same_v<T, typename Allocator::value_type>
+struct SmallStorageImpl {
+    static_assert(Inline > 0, "SmallStorage needs an inline capacity, use DynamicStorage for none");
+
+    using value_type = T;
+    using size_type = size_t;
+    using allocator_type = Allocator;
+
+    explicit SmallStorageImpl(const Allocator& alloc = Allocator()) noexcept;
+    void allocate(size_type cap);
+    void deallocate();
+    void swap(SmallStorageImpl& other, size_type size, size_type other_size) noexcept;
+
+    // Data
+    [[nodiscard]] allocator_type get_allocator() const;
+    [[nodiscard]] size_type capacity() const;
+    [[nodiscard]] bool is_inline() const;
+
+    template <typename... Args>
+    void construct(size_type idx, Args&&... args ) {
+        traits_t::construct(alloc_, data() + idx, std::forward<Args>(args)...);
+    }
+    void destruct(size_type idx);
+
+    [[nodiscard]] const T& operator[](size_type idx) const;
+    [[nodiscard]] T& operator[](size_type idx);
+
+private:
+    using traits_t = std::allocator_traits<Allocator>;
+
+    [[nodiscard]] T* data();
+    [[nodiscard]] const T* data() const;
+    [[nodiscard]] T* inline_data();
+
+    Allocator alloc_;
+    T* heap_{nullptr};
+    size_type capacity_{Inline};
+    alignas(T) unsigned char inline_[Inline * sizeof(T)];
+};
+
+// ----------------------------------------------------------------------------
+
+template <typename T, size_t Inline, typename Allocator>
+    requires std::is_same_v<T, typename Allocator::value_type>
+SmallStorageImpl<T, Inline, Allocator>::SmallStorageImpl(const Allocator& alloc) noexcept
+    : alloc_(alloc) {
+}
+
+template <typename T, size_t Inline, typename Allocator>
+    requires std::is_same_v<T, typename Allocator::value_type>
+void SmallStorageImpl<T, Inline, Allocator>::allocate(size_type cap) {
+    if (cap <= Inline) {
+        return;
+    }
+
+    heap_ = traits_t::allocate(alloc_, cap);
+    capacity_ = cap;
+}
+
+template <typename T, size_t Inline, typename Allocator>
+    requires std::is_same_v<T, typename Allocator::value_type>
+void SmallStorageImpl<T, Inline, Allocator>::deallocate() {
+    if (heap_ == nullptr) {
+        return;
+    }
+
+    traits_t::deallocate(alloc_, heap_, capacity_);
+    heap_ = nullptr;
+    capacity_ = Inline;
+}
+
+template <typename T, size_t Inline, typename Allocator>
+    requires std::is_same_v<T, typename Allocator::value_type>
+void SmallStorageImpl<T, Inline, Allocator>::swap(SmallStorageImpl& other, size_type size, size_type other_size) noexcept {
+    if (!is_inline() && !other.is_inline()) {
+        std::swap(heap_, other.heap_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(alloc_, other.alloc_);
+        return;
+    }
+
+    if (is_inline() && other.is_inline()) {
+        detail::swap_constructed(*this, other, size, other_size);
+        std::swap(alloc_, other.alloc_);
+        return;
+    }
+
+    // Inline elements move to the inline buffer of the heap storage,
+    // then the heap buffer changes hands
+    SmallStorageImpl& small = is_inline() ? *this : other;
+    SmallStorageImpl& large = is_inline() ? other : *this;
+    const size_type small_size = is_inline() ? size : other_size;
+
+    for (size_type idx = 0; idx < small_size; ++idx) {
+        traits_t::construct(large.alloc_, large.inline_data() + idx, std::move(small[idx]));
+        small.destruct(idx);
+    }
+
+    small.heap_ = large.heap_;
+    small.capacity_ = large.capacity_;
+    large.heap_ = nullptr;
+    large.capacity_ = Inline;
+    std::swap(alloc_, other.alloc_);
+}
+
+// ----------------------------------------------------------------------------
+
+template <typename T, size_t Inline, typename Allocator>
+    requires std::is_same_v<T, typename Allocator::value_type>
+typename SmallStorageImpl<T, Inline, Allocator>::allocator_type SmallStorageImpl<T, Inline, Allocator>::get_allocator() const {
+    return alloc_;
+}
+
+template <typename T, size_t Inline, typename Allocator>
+    requires std::is_same_v<T, typename Allocator::value_type>
+typename SmallStorageImpl<T, Inline, Allocator>::size_type SmallStorageImpl<T, Inline, Allocator>::capacity() const {
+    return capacity_;
+}
+
+template <typename T, size_t Inline, typename Allocator>
+    requires std::is_same_v<T, typename Allocator::value_type>
+bool SmallStorageImpl<T, Inline, Allocator>::is_inline() const {
+    return heap_ == nullptr;
+}
+
+template <typename T, size_t Inline, typename Allocator>
+    requires std::is_same_v<T, typename Allocator::value_type>
+void SmallStorageImpl<T, Inline, Allocator>::destruct(size_type idx) {
+    traits_t::destroy(alloc_, data() + idx);
+}
+
+template <typename T, size_t Inline, typename Allocator>
+    requires std::is_same_v<T, typename Allocator::value_type>
+const typename SmallStorageImpl<T, Inline, Allocator>::value_type&
+SmallStorageImpl<T, Inline, Allocator>::operator[](size_type idx) const {
+    return *(data() + idx);
+}
+
+template <typename T, size_t Inline, typename Allocator>
+    requires std::is_same_v<T, typename Allocator::value_type>
+typename SmallStorageImpl<T, Inline, Allocator>::value_type&
+SmallStorageImpl<T, Inline, Allocator>::operator[](size_type idx) {
+    return *(data() + idx);
+}
+
+// ----------------------------------------------------------------------------
+
+template <typename T, size_t Inline, typename Allocator>
+    requires std::is_same_v<T, typename Allocator::value_type>
+T* SmallStorageImpl<T, Inline, Allocator>::data() {
+    return heap_ != nullptr ? heap_ : inline_data();
+}
+
+template <typename T, size_t Inline, typename Allocator>
+    requires std::is_same_v<T, typename Allocator::value_type>
+const T* SmallStorageImpl<T, Inline, Allocator>::data() const {
+    return heap_ != nullptr ? heap_ : reinterpret_cast<const T*>(inline_);
+}
+
+template <typename T, size_t Inline, typename Allocator>
+    requires std::is_same_v<T, typename Allocator::value_type>
+T* SmallStorageImpl<T, Inline, Allocator>::inline_data() {
+    return reinterpret_cast<T*>(inline_);
+}
+
+} // nostd::storage
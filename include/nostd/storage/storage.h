@@ -1,10 +1,49 @@
 #pragma once
 
+#include <concepts>
+#include <cstddef>
+#include <memory>
+
+#include <nostd/storage/aligned_storage.h>
 #include <nostd/storage/local_storage.h>
 #include <nostd/storage/dynamic_storage.h>
+#include <nostd/storage/small_storage.h>
 
 namespace nostd::storage {
 
+template <typename S>
+    concept reallocatable_storage = requires(S& storage, typename S::size_type cap) {
+        { storage.reallocate(cap) } -> std::same_as<bool>;
+    };
+
+// Storages on an allocator, Array passes it on to the storages it creates
+template <typename S>
+    concept allocator_aware_storage = requires(const S& storage) {
+        typename S::allocator_type;
+        { storage.get_allocator() } -> std::same_as<typename S::allocator_type>;
+    } && std::constructible_from<S, const typename S::allocator_type&>;
+
+// allocator_type of Arrays on storages without an allocator
+struct no_allocator {
+};
+
+template <typename S>
+struct allocator_of {
+    using type = no_allocator;
+};
+
+template <allocator_aware_storage S>
+struct allocator_of<S> {
+    using type = typename S::allocator_type;
+};
+
+template <typename S>
+    concept sized_swap_storage = requires(S& storage, S& other, typename S::size_type size) {
+        storage.swap(other, size, size);
+    };
+
+// ----------------------------------------------------------------------------
+
 template <typename Allocator>
 struct AllocatorStorage {
     template <typename T>
@@ -20,10 +59,24 @@ struct LocalStorage {
     using storage_type = LocalStorageImpl<T, Capacity>;
 };
 
+// Alignment of 64 covers aligned AVX-512 loads and keeps data() on a cache line
+template <size_t Alignment = 64>
+struct AlignedStorage {
+    template <typename T>
+    using storage_type = AlignedStorageImpl<T, Alignment>;
+};
+
+template <size_t Inline, typename Allocator = std::allocator<std::byte>>
+struct SmallStorage {
+    template <typename T>
+    using storage_type = SmallStorageImpl<T, Inline, typename std::allocator_traits<Allocator>::template rebind_alloc<T>>;
+};
+
 } // nostd::storage
 
 /*
  * Storage requirements:
+ * Elements are stored contiguously, &storage[0] is the buffer.
 
  * Storage();
 
@@ -35,8 +88,25 @@ struct LocalStorage {
  * template<class... Args >
    void construct(size_t idx, Args&&... args );
  * void destruct(size_t idx);
+   Array skips destruct for trivially destructible T and copies
+   trivially copyable T with memcpy instead of construct.
 
  * void swap(other& Storage);
+   or, for storages keeping elements inline (see sized_swap_storage):
+   void swap(other& Storage, size_t size, size_t other_size);
+   sizes are counts of constructed elements, they are moved if needed
+
+ * Optional, see allocator_aware_storage:
+ * using allocator_type = ...;
+ * explicit Storage(const allocator_type&);
+ * allocator_type get_allocator() const;
+   Array creates storages on the same allocator when it grows, copies
+   (after select_on_container_copy_construction) and moves.
+
+ * Optional, see reallocatable_storage:
+ * bool reallocate(size_t capacity);
+   keeps the first elements (trivially relocatable ones only) and may move
+   the buffer, returns false when Array should allocate+relocate instead.
 
  * const T& operator[](size_t) const;
  * T& operator[](size_t);
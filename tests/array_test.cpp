@@ -5,6 +5,13 @@
 #include "test_util.h"
 
 #include <algorithm>
+#include <cstring>
+#include <list>
+#include <numeric>
+#include <ranges>
+#include <span>
+#include <sstream>
+#include <vector>
 
 template <typename Array>
 void TestAccess(Array& array) {
@@ -117,6 +124,49 @@ TEST(IteratorTest, Range) {
     ASSERT_EQ(idx, a.size());
 }
 
+TEST(IteratorTest, Contiguous) {
+    using Array = nostd::Array<float>;
+    static_assert(std::contiguous_iterator<Array::iterator>);
+    static_assert(std::contiguous_iterator<Array::const_iterator>);
+    static_assert(std::ranges::contiguous_range<Array>);
+    static_assert(std::ranges::contiguous_range<const Array>);
+
+    Array a({1.0f, 2.0f, 3.0f});
+    EXPECT_EQ(std::to_address(a.begin()), a.data());
+    EXPECT_EQ(std::ranges::data(a), a.data());
+
+    std::span<const float> view(a.begin(), a.end());
+    EXPECT_EQ(view.size(), 3);
+    EXPECT_EQ(view[2], 3.0f);
+
+    Array::const_iterator it = a.begin() + 1;
+    EXPECT_EQ(*it, 2.0f);
+    EXPECT_EQ(it[1], 3.0f);
+    EXPECT_TRUE(a.begin() < it);
+    EXPECT_EQ(a.end() - it, 2);
+}
+
+#ifdef NOSTD_DEBUG_ITERATORS
+TEST(IteratorTest, DebugDifferentArrays) {
+    nostd::Array<int> a({1, 2, 3});
+    nostd::Array<int> b({1, 2, 3});
+    EXPECT_THROW((void)(a.begin() == b.begin()), std::invalid_argument);
+    EXPECT_THROW((void)(a.end() - b.begin()), std::invalid_argument);
+}
+#endif
+
+TEST(IteratorTest, Reverse) {
+    nostd::Array<int> a({1, 2, 3, 4});
+    std::vector<int> reversed(a.rbegin(), a.rend());
+    EXPECT_EQ(reversed, std::vector<int>({4, 3, 2, 1}));
+}
+
+TEST(IteratorTest, Transform) {
+    nostd::Array<float> a(1000, 1.5f);
+    std::ranges::transform(a, a.begin(), [](float val) { return val * 2; });
+    EXPECT_EQ(std::accumulate(a.begin(), a.end(), 0.0f), 3000.0f);
+}
+
 TEST(IteratorTest, Find) {
     nostd::Array<int> a({9, 5, 3, 10, 213});
     auto it = std::find(a.begin(), a.end(), 10);
@@ -258,6 +308,275 @@ TEST(MethodsTest, PopBack) {
     Tricky<size_t>::expect_no_instances();
 }
 
+namespace {
+
+struct Record {
+    int64_t id;
+    double weight;
+};
+
+// Not trivially copyable, but safe to relocate by memcpy
+struct Relocatable {
+    explicit Relocatable(int64_t val) : val(new int64_t(val)) {}
+    Relocatable(Relocatable&& other) noexcept : val(other.val) {
+        other.val = nullptr;
+        ++moves;
+    }
+    ~Relocatable() {
+        delete val;
+    }
+
+    int64_t* val;
+    static inline size_t moves = 0;
+};
+
+} // namespace
+
+template <>
+struct nostd::is_trivially_relocatable<Relocatable> : std::true_type {
+};
+
+TEST(RelocateTest, TrivialRecord) {
+    static_assert(nostd::trivially_relocatable<Record>);
+
+    size_t const N = 5000;
+    nostd::Array<Record> a;
+    for (size_t i = 0; i != N; ++i) {
+        a.push_back({static_cast<int64_t>(i), 0.5 * i});
+    }
+
+    for (size_t i = 0; i != N; ++i) {
+        EXPECT_EQ(static_cast<int64_t>(i), a[i].id);
+        EXPECT_EQ(0.5 * i, a[i].weight);
+    }
+}
+
+TEST(RelocateTest, OptIn) {
+    static_assert(nostd::trivially_relocatable<Relocatable>);
+
+    size_t const N = 500;
+    Relocatable::moves = 0;
+    nostd::Array<Relocatable> a;
+    for (size_t i = 0; i != N; ++i) {
+        a.emplace_back(static_cast<int64_t>(i));
+    }
+    a.shrink_to_fit();
+
+    // Only the values emplaced at growth are moved, old elements are not
+    EXPECT_LT(Relocatable::moves, N / 10);
+    for (size_t i = 0; i != N; ++i) {
+        EXPECT_EQ(static_cast<int64_t>(i), *a[i].val);
+    }
+}
+
+TEST(RelocateTest, PushBackSelf) {
+    nostd::Array<int64_t> a;
+    a.push_back(42);
+    for (size_t i = 0; i != 100; ++i) {
+        a.push_back(a[i]);
+    }
+
+    for (size_t i = 0; i != a.size(); ++i) {
+        EXPECT_EQ(42, a[i]);
+    }
+}
+
+template <typename Growth, typename T = int>
+using GrowthArray = nostd::Array<T, nostd::storage::DynamicStorage, Growth>;
+
+TEST(GrowthTest, Policies) {
+    using namespace nostd::growth;
+
+    static_assert(Doubling::next_capacity(0, 4) == 4);
+    static_assert(Doubling::next_capacity(16, 4) == 32);
+    static_assert(OneAndHalf::next_capacity(16, 4) == 24);
+    static_assert(FixedChunk<100>::next_capacity(16, 4) == 116);
+    static_assert(PageGranular<>::next_capacity(0, 8) == PAGE_SIZE / 8);
+    static_assert(PageGranular<>::next_capacity(PAGE_SIZE / 8, 8) == 2 * PAGE_SIZE / 8);
+    static_assert(HugePageGranular<>::next_capacity(0, 24) == HUGE_PAGE_SIZE / 24);
+}
+
+TEST(GrowthTest, OneAndHalf) {
+    GrowthArray<nostd::growth::OneAndHalf> a;
+    size_t prev = 0;
+    for (int i = 0; i != 1000; ++i) {
+        a.push_back(i);
+        if (a.capacity() != prev) {
+            EXPECT_TRUE(prev == 0 || a.capacity() == prev + prev / 2);
+            prev = a.capacity();
+        }
+    }
+
+    for (int i = 0; i != 1000; ++i) {
+        EXPECT_EQ(i, a[i]);
+    }
+}
+
+TEST(GrowthTest, FixedChunk) {
+    GrowthArray<nostd::growth::FixedChunk<64>, Tricky<int>> a;
+    for (int i = 0; i != 1000; ++i) {
+        a.push_back(i);
+        EXPECT_EQ(0, a.capacity() % 64);
+    }
+
+    for (int i = 0; i != 1000; ++i) {
+        EXPECT_EQ(i, a[i]);
+    }
+}
+
+TEST(GrowthTest, PageGranular) {
+    GrowthArray<nostd::growth::PageGranular<>, int64_t> a;
+    for (int64_t i = 0; i != 10000; ++i) {
+        a.push_back(i);
+        EXPECT_EQ(0, a.capacity() * sizeof(int64_t) % nostd::growth::PAGE_SIZE);
+    }
+
+    for (int64_t i = 0; i != 10000; ++i) {
+        EXPECT_EQ(i, a[i]);
+    }
+}
+
+TEST(GrowthTest, Bool) {
+    nostd::Array<bool, nostd::storage::DynamicStorage, nostd::growth::PageGranular<>> a;
+    for (size_t i = 0; i != 100000; ++i) {
+        a.push_back(i % 3 == 0);
+        EXPECT_EQ(0, a.capacity() % (8 * nostd::growth::PAGE_SIZE));
+    }
+
+    for (size_t i = 0; i != 100000; ++i) {
+        EXPECT_EQ(i % 3 == 0, a[i]);
+    }
+}
+
+TEST(BulkTest, AppendRange) {
+    std::vector<int> src(1000);
+    std::iota(src.begin(), src.end(), 0);
+
+    nostd::Array<int> a({-1, -2});
+    a.append_range(src);
+    ASSERT_EQ(a.size(), 1002);
+    EXPECT_EQ(-2, a[1]);
+    for (int i = 0; i != 1000; ++i) {
+        EXPECT_EQ(i, a[i + 2]);
+    }
+}
+
+TEST(BulkTest, AppendRangeSingleGrowth) {
+    std::list<size_t> src(1000, 42);
+    {
+        nostd::Array<Tricky<size_t>> a;
+        a.push_back(1);
+        ASSERT_LT(a.capacity(), 1001);
+
+        // One growth relocates the first element once, growing per element would copy it again each time
+        const size_t copies = Tricky<size_t>::copies();
+        a.append_range(src);
+        EXPECT_EQ(Tricky<size_t>::copies() - copies, 1);
+        ASSERT_EQ(a.size(), 1001);
+        EXPECT_EQ(1, a[0]);
+        for (size_t i = 1; i != a.size(); ++i) {
+            EXPECT_EQ(42, a[i]);
+        }
+    }
+    Tricky<size_t>::expect_no_instances();
+}
+
+TEST(BulkTest, AppendInputRange) {
+    std::istringstream in("1 2 3 4 5");
+    nostd::Array<int> a;
+    a.append_range(std::ranges::istream_view<int>(in));
+    ASSERT_EQ(a.size(), 5);
+    EXPECT_EQ(5, a.back());
+}
+
+TEST(BulkTest, AssignRange) {
+    nostd::Array<int> a(100, 7);
+    int src[] = {1, 2, 3};
+    a.assign_range(src);
+    ASSERT_EQ(a.size(), 3);
+    EXPECT_EQ(1, a[0]);
+    EXPECT_EQ(3, a[2]);
+}
+
+TEST(BulkTest, InsertTrivial) {
+    nostd::Array<int> a({0, 1, 5, 6});
+    int src[] = {2, 3, 4};
+    auto it = a.insert(a.begin() + 2, std::begin(src), std::end(src));
+    EXPECT_EQ(2, *it);
+
+    ASSERT_EQ(a.size(), 7);
+    for (int i = 0; i != 7; ++i) {
+        EXPECT_EQ(i, a[i]);
+    }
+
+    a.insert(a.end(), std::begin(src), std::end(src));
+    a.insert(a.begin(), std::begin(src), std::begin(src));
+    ASSERT_EQ(a.size(), 10);
+    EXPECT_EQ(4, a.back());
+}
+
+TEST(BulkTest, InsertNonTrivial) {
+    {
+        nostd::Array<Tricky<size_t>> a;
+        for (size_t i = 0; i != 10; ++i) {
+            a.push_back(i < 5 ? i : i + 100);
+        }
+        std::vector<size_t> src{5, 6, 7};
+        a.insert(a.begin() + 5, src.begin(), src.end());
+
+        ASSERT_EQ(a.size(), 13);
+        for (size_t i = 0; i != 8; ++i) {
+            EXPECT_EQ(i, a[i]);
+        }
+        EXPECT_EQ(105, a[8]);
+    }
+    Tricky<size_t>::expect_no_instances();
+}
+
+TEST(UninitTest, Construct) {
+    static_assert(nostd::implicit_lifetime<Record>);
+    static_assert(!nostd::implicit_lifetime<Tricky<int>>);
+
+    nostd::Array<Record> a(1000, nostd::uninit);
+    ASSERT_EQ(a.size(), 1000);
+    ASSERT_GE(a.capacity(), 1000);
+    for (size_t i = 0; i != a.size(); ++i) {
+        a[i] = {static_cast<int64_t>(i), 0.0};
+    }
+    EXPECT_EQ(999, a.back().id);
+}
+
+TEST(UninitTest, ResizeForOverwrite) {
+    nostd::Array<uint8_t> a({1, 2, 3});
+    a.resize_for_overwrite(4096);
+    ASSERT_EQ(a.size(), 4096);
+    EXPECT_EQ(3, a[2]);
+
+    std::memset(a.data() + 3, 0xAB, a.size() - 3);
+    EXPECT_EQ(0xAB, a.back());
+
+    a.resize_for_overwrite(2);
+    ASSERT_EQ(a.size(), 2);
+    EXPECT_EQ(2, a.back());
+}
+
+TEST(UninitTest, LocalStorage) {
+    nostd::Array<int, nostd::storage::LocalStorage<64>::storage_type> a(10, nostd::uninit);
+    ASSERT_EQ(a.size(), 10);
+    a.resize_for_overwrite(64);
+    ASSERT_EQ(a.size(), 64);
+    ASSERT_EQ(a.capacity(), 64);
+}
+
+TEST(UninitTest, AllocatorStorage) {
+    using Storage = nostd::storage::AllocatorStorage<std::allocator<uint32_t>>;
+    nostd::Array<uint32_t, Storage::storage_type> a(16, nostd::uninit);
+    ASSERT_EQ(a.size(), 16);
+    a.resize_for_overwrite(1000);
+    ASSERT_EQ(a.size(), 1000);
+    ASSERT_GE(a.capacity(), 1000);
+}
+
 // ---------------------------------------------------
 
 TEST(Bool, DefaultConstruct) {
@@ -431,3 +750,273 @@ TEST(Bool, PopBack) {
     EXPECT_TRUE(a.empty());
 }
 
+
+TEST(Bool, IteratorArithmetic) {
+    nostd::Array<bool> a;
+    for (size_t i = 0; i != 300; ++i) a.push_back(i % 5 == 0);
+
+    auto it = a.begin() + 130;
+    EXPECT_EQ(it - a.begin(), 130);
+    EXPECT_TRUE(*it);
+    it -= 129;
+    EXPECT_EQ(it - a.begin(), 1);
+    it += 199;
+    EXPECT_TRUE(*it);
+    EXPECT_EQ(a.end() - it, 100);
+    EXPECT_EQ(a.end() - a.begin(), 300);
+}
+
+TEST(Bool, CountAndFind) {
+    nostd::Array<bool> a;
+    EXPECT_EQ(a.count(), 0);
+    EXPECT_EQ(a.find_first(), 0);
+    EXPECT_TRUE(a.none());
+    EXPECT_TRUE(a.all());
+
+    for (size_t i = 0; i != 1000; ++i) a.push_back(i % 7 == 3);
+    EXPECT_EQ(a.count(), 143);
+    EXPECT_TRUE(a.any());
+    EXPECT_FALSE(a.all());
+
+    size_t visited = 0;
+    for (size_t i = a.find_first(); i != a.size(); i = a.find_next(i)) {
+        ASSERT_EQ(i % 7, 3);
+        ++visited;
+    }
+    EXPECT_EQ(visited, 143);
+    EXPECT_EQ(a.find_next(a.size()), a.size());
+
+    nostd::Array<bool> sparse(5000, false);
+    EXPECT_EQ(sparse.find_first(), 5000);
+    sparse[4321] = true;
+    EXPECT_EQ(sparse.find_first(), 4321);
+    EXPECT_EQ(sparse.find_next(63), 4321);
+    EXPECT_EQ(sparse.find_next(4321), 5000);
+
+    nostd::Array<bool> full(130, true);
+    EXPECT_TRUE(full.all());
+    EXPECT_EQ(full.count(), 130);
+}
+
+TEST(Bool, SetBits) {
+    nostd::Array<bool> empty;
+    EXPECT_EQ(empty.set_bits().begin(), empty.set_bits().end());
+    empty.for_each_set_bit([](size_t) { FAIL(); });
+
+    // Runs of zero words between the set bits, one in the last partial word
+    nostd::Array<bool> a(10000, false);
+    const std::vector<size_t> expected = {0, 1, 63, 64, 640, 641, 4095, 9000, 9999};
+    for (size_t idx: expected) {
+        a[idx] = true;
+    }
+
+    std::vector<size_t> visited;
+    for (size_t idx: a.set_bits()) {
+        visited.push_back(idx);
+    }
+    EXPECT_EQ(visited, expected);
+
+    visited.clear();
+    a.for_each_set_bit([&](size_t idx) { visited.push_back(idx); });
+    EXPECT_EQ(visited, expected);
+
+    static_assert(std::forward_iterator<decltype(a.set_bits().begin())>);
+    const auto bits = a.set_bits();
+    EXPECT_EQ(std::distance(bits.begin(), bits.end()), a.count());
+    EXPECT_EQ(*std::next(bits.begin(), 4), 640);
+
+    nostd::Array<bool> full(130, true);
+    size_t sum = 0;
+    full.for_each_set_bit([&](size_t idx) { sum += idx; });
+    EXPECT_EQ(sum, 129 * 130 / 2);
+}
+
+TEST(Bool, TailStaysZero) {
+    nostd::Array<bool> a(100, true);
+    a.pop_back();
+    a.pop_back();
+    EXPECT_EQ(a.count(), 98);
+    EXPECT_EQ(a.data()[1], (uint64_t{1} << 34) - 1);
+
+    a.clear();
+    a.push_back(false);
+    EXPECT_EQ(a.data()[0], 0);
+    EXPECT_TRUE(a.none());
+
+    const auto inverted = ~nostd::Array<bool>(70, false);
+    EXPECT_EQ(inverted.count(), 70);
+    EXPECT_TRUE(inverted.all());
+    EXPECT_EQ(inverted.data()[1], 0x3f);
+}
+
+TEST(Bool, FillConstruct) {
+    for (size_t n: {0, 1, 63, 64, 65, 1000, 100000}) {
+        nostd::Array<bool> ones(n, true);
+        ASSERT_EQ(ones.size(), n);
+        EXPECT_EQ(ones.count(), n);
+        nostd::Array<bool> zeros(n, false);
+        EXPECT_TRUE(zeros.none());
+    }
+}
+
+TEST(Bool, Resize) {
+    nostd::Array<bool> a({true, false, true});
+    a.resize(200, true);
+    ASSERT_EQ(a.size(), 200);
+    EXPECT_FALSE(a[1]);
+    EXPECT_EQ(a.count(), 199);
+
+    a.resize(70);
+    EXPECT_EQ(a.count(), 69);
+    a.resize(300);
+    EXPECT_EQ(a.count(), 69);
+    EXPECT_EQ(a.find_next(69), 300);
+
+    a.resize(0);
+    EXPECT_TRUE(a.empty());
+    a.resize(10, true);
+    EXPECT_TRUE(a.all());
+}
+
+TEST(Bool, Fill) {
+    nostd::Array<bool> a(1000, false);
+    a.fill(10, 20, true);
+    EXPECT_EQ(a.count(), 10);
+    EXPECT_EQ(a.find_first(), 10);
+
+    a.fill(60, 900, true);
+    EXPECT_EQ(a.count(), 850);
+    EXPECT_FALSE(a[59]);
+    EXPECT_TRUE(a[899]);
+    EXPECT_FALSE(a[900]);
+
+    a.fill(64, 128, false);
+    EXPECT_EQ(a.count(), 786);
+    a.fill(5, 5, true);
+    EXPECT_EQ(a.count(), 786);
+    a.fill(0, a.size(), true);
+    EXPECT_TRUE(a.all());
+}
+
+TEST(Bool, AppendBits) {
+    nostd::Array<bool> a;
+    nostd::Array<bool> expected;
+    uint64_t pattern = 0x9e3779b97f4a7c15;
+    for (size_t nbits = 0; nbits <= 64; ++nbits) {
+        a.append_bits(pattern, nbits);
+        for (size_t bit = 0; bit < nbits; ++bit) {
+            expected.push_back((pattern >> bit) & 1);
+        }
+        pattern = pattern * 31 + 7;
+    }
+
+    ASSERT_EQ(a.size(), expected.size());
+    for (size_t i = 0; i != a.size(); ++i) {
+        ASSERT_EQ(a[i], expected[i]) << i;
+    }
+    EXPECT_EQ(a.count(), expected.count());
+    // High bits of the word past nbits are ignored
+    nostd::Array<bool> b;
+    b.append_bits(~uint64_t{0}, 3);
+    EXPECT_EQ(b.count(), 3);
+    EXPECT_EQ(b.data()[0], 7);
+}
+
+TEST(Bool, BitwiseOps) {
+    nostd::Array<bool> a, b;
+    for (size_t i = 0; i != 1000; ++i) {
+        a.push_back(i % 2 == 0);
+        b.push_back(i % 3 == 0);
+    }
+
+    const auto both = a & b;
+    const auto either = a | b;
+    const auto one = a ^ b;
+    for (size_t i = 0; i != 1000; ++i) {
+        ASSERT_EQ(both[i], i % 6 == 0);
+        ASSERT_EQ(either[i], i % 2 == 0 || i % 3 == 0);
+        ASSERT_EQ(one[i], (i % 2 == 0) != (i % 3 == 0));
+    }
+    EXPECT_EQ(both.count() + one.count(), either.count());
+
+    a &= ~a;
+    EXPECT_TRUE(a.none());
+
+    nostd::Array<bool> shorter(999);
+    EXPECT_THROW(b |= shorter, std::invalid_argument);
+}
+
+// ---------------------------------------------------
+
+TEST(TrivialTest, CopyTrivial) {
+    nostd::Array<uint32_t> a(1000);
+    std::iota(a.begin(), a.end(), 0u);
+
+    nostd::Array<uint32_t> copy(a);
+    ASSERT_NE(copy.data(), a.data());
+    TestEqual(a, copy);
+
+    const nostd::Array<uint32_t> empty;
+    nostd::Array<uint32_t> empty_copy(empty);
+    EXPECT_TRUE(empty_copy.empty());
+}
+
+TEST(TrivialTest, CopyAssignReusesBuffer) {
+    nostd::Array<uint32_t> a(100, 5);
+    nostd::Array<uint32_t> b(200, 7);
+    const auto* buffer = b.data();
+
+    b = a;
+    EXPECT_EQ(b.data(), buffer);
+    TestEqual(a, b);
+
+    b = nostd::Array<uint32_t>(1000, 9);
+    nostd::Array<uint32_t> small(3, 1);
+    small = b;
+    TestEqual(small, b);
+}
+
+TEST(TrivialTest, ClearKeepsCapacity) {
+    static_assert(nostd::trivially_destructible<uint32_t>);
+    static_assert(!nostd::trivially_destructible<Tricky<int>>);
+
+    nostd::Array<uint32_t> a(1 << 20, 1);
+    const auto capacity = a.capacity();
+    a.clear();
+    EXPECT_TRUE(a.empty());
+    EXPECT_EQ(a.capacity(), capacity);
+
+    a.push_back(3);
+    EXPECT_EQ(3u, a.front());
+}
+
+TEST(TrivialTest, ClearNonTrivial) {
+    {
+        nostd::Array<Tricky<int>> a;
+        for (int i = 0; i != 100; ++i) {
+            a.push_back(Tricky<int>(i));
+        }
+        nostd::Array<Tricky<int>> copy(a);
+        copy = a;
+        a.clear();
+        EXPECT_TRUE(a.empty());
+    }
+    Tricky<int>::expect_no_instances();
+}
+
+TEST(TrivialTest, CopyBool) {
+    nostd::Array<bool> a;
+    for (size_t i = 0; i != 1001; ++i) {
+        a.push_back(i % 3 == 0);
+    }
+
+    nostd::Array<bool> copy(a);
+    ASSERT_EQ(copy.size(), a.size());
+    for (size_t i = 0; i != a.size(); ++i) {
+        ASSERT_EQ(copy[i], i % 3 == 0);
+    }
+
+    copy.clear();
+    EXPECT_TRUE(copy.empty());
+    EXPECT_GE(copy.capacity(), 1001u);
+}
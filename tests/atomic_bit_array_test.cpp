@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+
+#include <nostd/array/atomic_bit_array.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <random>
+#include <thread>
+#include <vector>
+
+TEST(AtomicBitArray, SingleThread) {
+    nostd::AtomicBitArray bits(200);
+    EXPECT_EQ(bits.size(), 200);
+    EXPECT_TRUE(bits.none());
+    EXPECT_EQ(bits.find_first(), 200);
+
+    EXPECT_FALSE(bits.test_and_set(70));
+    EXPECT_TRUE(bits.test_and_set(70));
+    EXPECT_TRUE(bits.test(70));
+    EXPECT_FALSE(bits.test(71, std::memory_order_relaxed));
+    EXPECT_FALSE(bits.test_and_set(199, std::memory_order_relaxed));
+
+    EXPECT_EQ(bits.fetch_or(0, 0b1011), 0);
+    EXPECT_EQ(bits.fetch_and(0, ~uint64_t{0b10}), 0b1011);
+    EXPECT_TRUE(bits.reset(3));
+    EXPECT_FALSE(bits.reset(3));
+
+    EXPECT_EQ(bits.count(), 3);
+    EXPECT_EQ(bits.find_first(), 0);
+    EXPECT_EQ(bits.find_next(0), 70);
+    EXPECT_EQ(bits.find_next(70), 199);
+    EXPECT_EQ(bits.find_next(199), 200);
+
+    std::vector<size_t> visited;
+    bits.for_each_set_bit([&](size_t idx) { visited.push_back(idx); });
+    EXPECT_EQ(visited, std::vector<size_t>({0, 70, 199}));
+
+    bits.clear();
+    EXPECT_TRUE(bits.none());
+    EXPECT_TRUE(nostd::AtomicBitArray().empty());
+
+    bits.test_and_set(5);
+    nostd::AtomicBitArray moved(std::move(bits));
+    EXPECT_EQ(moved.size(), 200);
+    EXPECT_TRUE(moved.test(5));
+    EXPECT_EQ(bits.size(), 0);
+    EXPECT_TRUE(bits.none());
+    EXPECT_EQ(bits.count(), 0);
+    bits = std::move(moved);
+    EXPECT_EQ(bits.find_first(), 5);
+    EXPECT_EQ(moved.size(), 0);
+    EXPECT_TRUE(moved.none());
+}
+
+TEST(AtomicBitArray, SetMany) {
+    nostd::AtomicBitArray bits(1000);
+    const std::vector<size_t> indices = {1, 2, 3, 63, 64, 65, 500, 3, 999};
+    // 3 comes twice, set once
+    EXPECT_EQ(bits.set_many(indices), 8);
+    EXPECT_EQ(bits.set_many(indices), 0);
+    EXPECT_EQ(bits.count(), 8);
+    for (size_t idx: indices) {
+        EXPECT_TRUE(bits.test(idx));
+    }
+    EXPECT_EQ(bits.set_many({}), 0);
+}
+
+TEST(AtomicBitArray, FromAndToBits) {
+    nostd::Array<bool> packed(1000, false);
+    packed.fill(100, 300, true);
+    packed[999] = true;
+
+    const nostd::AtomicBitArray bits(packed);
+    EXPECT_EQ(bits.count(), 201);
+    EXPECT_FALSE(bits.all());
+    const auto back = bits.to_bits();
+    ASSERT_EQ(back.size(), 1000);
+    EXPECT_TRUE(std::equal(back.begin(), back.end(), packed.begin()));
+}
+
+TEST(AtomicBitArray, ConcurrentMarks) {
+    // Every thread marks every vertex, each one is claimed exactly once
+    constexpr size_t THREADS = 8;
+    constexpr size_t SIZE = 100000;
+    nostd::AtomicBitArray visited(SIZE);
+    std::atomic<size_t> claimed{0};
+
+    std::vector<std::thread> workers;
+    for (size_t thread = 0; thread < THREADS; ++thread) {
+        workers.emplace_back([&, thread] {
+            std::vector<size_t> order(SIZE);
+            for (size_t idx = 0; idx < SIZE; ++idx) {
+                order[idx] = idx;
+            }
+            std::shuffle(order.begin(), order.end(), std::mt19937_64(thread));
+
+            size_t mine = 0;
+            for (size_t pos = 0; pos < SIZE; ++pos) {
+                if (thread % 2 == 0) {
+                    mine += visited.test_and_set(order[pos], std::memory_order_relaxed) ? 0 : 1;
+                } else {
+                    // Batches of neighbours, sorted like rows of an adjacency list
+                    const size_t begin = pos;
+                    pos = std::min(SIZE, pos + 16) - 1;
+                    std::sort(order.begin() + begin, order.begin() + pos + 1);
+                    mine += visited.set_many({order.data() + begin, pos + 1 - begin});
+                }
+            }
+            claimed += mine;
+        });
+    }
+    for (auto& worker: workers) {
+        worker.join();
+    }
+
+    EXPECT_EQ(claimed.load(), SIZE);
+    EXPECT_TRUE(visited.all());
+}
+
+TEST(AtomicBitArray, ConcurrentFind) {
+    // The writers set and reset the last bits of each word, the readers
+    // find either one of them or nothing, never a bit past a cleared word
+    constexpr size_t SIZE = 130;
+    constexpr size_t ROUNDS = 20000;
+    const std::vector<size_t> toggled = {63, 127, 129};
+    nostd::AtomicBitArray bits(SIZE);
+    std::atomic<bool> done{false};
+
+    std::vector<std::thread> writers;
+    for (size_t idx: toggled) {
+        writers.emplace_back([&, idx] {
+            for (size_t round = 0; round < ROUNDS; ++round) {
+                bits.test_and_set(idx, std::memory_order_relaxed);
+                bits.reset(idx, std::memory_order_relaxed);
+            }
+        });
+    }
+
+    std::vector<std::thread> readers;
+    std::vector<std::vector<size_t>> found(2);
+    for (size_t reader = 0; reader < found.size(); ++reader) {
+        readers.emplace_back([&, reader] {
+            while (!done.load(std::memory_order_relaxed)) {
+                found[reader].push_back(bits.find_first());
+                found[reader].push_back(bits.find_next(64));
+                found[reader].push_back(bits.find_next(128));
+            }
+        });
+    }
+    for (auto& writer: writers) {
+        writer.join();
+    }
+    done = true;
+    for (auto& reader: readers) {
+        reader.join();
+    }
+
+    for (const auto& results: found) {
+        for (size_t idx: results) {
+            ASSERT_LE(idx, SIZE);
+            if (idx != SIZE) {
+                EXPECT_NE(std::find(toggled.begin(), toggled.end(), idx), toggled.end()) << idx;
+            }
+        }
+    }
+}
@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+
+#include <nostd/array/array.h>
+#include <nostd/bits/compressed_bitmap.h>
+
+#include "test_util.h"
+
+#include <cstdint>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace {
+
+using nostd::bits::CompressedBitmap;
+
+// Runs of ones with random gaps, density about run / (run + gap)
+nostd::Array<bool> ClusteredBits(size_t size, size_t run, size_t gap, std::mt19937_64& gen) {
+    nostd::Array<bool> bits(size, false);
+    std::uniform_int_distribution<size_t> gaps(0, 2 * gap);
+    std::uniform_int_distribution<size_t> runs(1, 2 * run);
+    for (size_t pos = gaps(gen); pos < size;) {
+        const size_t last = std::min(size, pos + runs(gen));
+        bits.fill(pos, last, true);
+        pos = last + gaps(gen) + 1;
+    }
+    return bits;
+}
+
+std::vector<uint64_t> Positions(const CompressedBitmap& bitmap) {
+    std::vector<uint64_t> result;
+    bitmap.for_each([&](uint64_t pos) { result.push_back(pos); });
+    return result;
+}
+
+std::vector<uint64_t> Positions(const nostd::Array<bool>& bits) {
+    std::vector<uint64_t> result;
+    for (size_t pos = bits.find_first(); pos < bits.size(); pos = bits.find_next(pos)) {
+        result.push_back(pos);
+    }
+    return result;
+}
+
+} // namespace
+
+TEST(CompressedBitmap, AddAndContains) {
+    CompressedBitmap bitmap;
+    EXPECT_TRUE(bitmap.empty());
+    EXPECT_FALSE(bitmap.contains(0));
+
+    std::mt19937_64 gen(1);
+    std::set<uint64_t> expected;
+    for (int i = 0; i < 20000; ++i) {
+        // Dense in the first chunks, sparse far away
+        const uint64_t value = i % 4 == 0 ? gen() : gen() % 200000;
+        bitmap.add(value);
+        expected.insert(value);
+    }
+
+    EXPECT_EQ(bitmap.cardinality(), expected.size());
+    EXPECT_EQ(Positions(bitmap), std::vector<uint64_t>(expected.begin(), expected.end()));
+    for (uint64_t value = 0; value < 200000; ++value) {
+        ASSERT_EQ(bitmap.contains(value), expected.contains(value)) << value;
+    }
+
+    bitmap.clear();
+    EXPECT_TRUE(bitmap.empty());
+    EXPECT_EQ(bitmap.cardinality(), 0);
+}
+
+TEST(CompressedBitmap, AddToRuns) {
+    nostd::Array<bool> bits(1 << 17, false);
+    bits.fill(100, 200, true);
+    bits.fill(300, 400, true);
+    CompressedBitmap bitmap(bits);
+
+    // Extends, joins and splits runs
+    for (uint64_t value: {99, 200, 250, 201, 202, 299, 298, 203, 90000, 70000}) {
+        bitmap.add(value);
+        bits[value] = true;
+    }
+    for (uint64_t value = 201; value < 298; ++value) {
+        bitmap.add(value);
+        bits[value] = true;
+    }
+    EXPECT_EQ(Positions(bitmap), Positions(bits));
+    EXPECT_EQ(bitmap.cardinality(), bits.count());
+}
+
+TEST(CompressedBitmap, RoundTrip) {
+    std::mt19937_64 gen(7);
+    const size_t size = 1000003;
+    for (const auto& bits: {RandomBits(size, 0.001, gen), RandomBits(size, 0.3, gen),
+                            ClusteredBits(size, 500, 50000, gen), nostd::Array<bool>(size, true),
+                            nostd::Array<bool>(size, false)}) {
+        const CompressedBitmap bitmap(bits);
+        EXPECT_EQ(bitmap.cardinality(), bits.count());
+        const auto back = bitmap.to_bits(size);
+        ASSERT_EQ(back.size(), size);
+        EXPECT_TRUE(std::equal(bits.data(), bits.data() + (size + 63) / 64, back.data()));
+
+        // A shorter array drops the positions past it
+        const auto prefix = bitmap.to_bits(70001);
+        for (size_t pos = 0; pos < prefix.size(); ++pos) {
+            ASSERT_EQ(prefix[pos], bits[pos]);
+        }
+        EXPECT_EQ(prefix.data()[70001 / 64] >> (70001 % 64), 0);
+    }
+}
+
+TEST(CompressedBitmap, SetOperations) {
+    std::mt19937_64 gen(3);
+    const size_t size = 1 << 20;
+    // Every pair of container kinds meets in some chunk
+    const std::vector<nostd::Array<bool>> inputs = {
+        RandomBits(size, 0.01, gen), RandomBits(size, 0.5, gen), ClusteredBits(size, 2000, 2000, gen),
+        ClusteredBits(size, 20, 3000, gen), nostd::Array<bool>(size, true)};
+
+    for (const auto& lhs: inputs) {
+        for (const auto& rhs: inputs) {
+            const CompressedBitmap left(lhs);
+            const CompressedBitmap right(rhs);
+
+            const auto both = left & right;
+            EXPECT_EQ(Positions(both), Positions(lhs & rhs));
+            EXPECT_EQ(both.cardinality(), (lhs & rhs).count());
+
+            auto either = left;
+            either |= right;
+            EXPECT_EQ(Positions(either), Positions(lhs | rhs));
+            EXPECT_EQ(either.cardinality(), (lhs | rhs).count());
+
+            either.optimize();
+            EXPECT_EQ(Positions(either), Positions(lhs | rhs));
+        }
+    }
+}
+
+TEST(CompressedBitmap, SparseMemory) {
+    // 0.1% of the bits, in clusters
+    std::mt19937_64 gen(5);
+    const auto bits = ClusteredBits(size_t{1} << 28, 64, 64000, gen);
+    const CompressedBitmap bitmap(bits);
+    EXPECT_EQ(bitmap.cardinality(), bits.count());
+    EXPECT_LT(bitmap.memory_bytes() * 10, bits.capacity() / 8);
+
+    // Scattered positions stay in arrays
+    const auto scattered = RandomBits(size_t{1} << 24, 0.001, gen);
+    EXPECT_LT(CompressedBitmap(scattered).memory_bytes() * 10, scattered.capacity() / 8);
+}
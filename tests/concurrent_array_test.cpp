@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+
+#include <nostd/array/concurrent_array.h>
+
+#include "test_util.h"
+
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(ConcurrentArray, SingleThread) {
+    nostd::ConcurrentArray<std::string, 4> array;
+    EXPECT_TRUE(array.empty());
+    EXPECT_EQ(array.get(0), nullptr);
+
+    for (int idx = 0; idx < 100; ++idx) {
+        EXPECT_EQ(array.push_back(std::to_string(idx)), idx);
+    }
+    ASSERT_EQ(array.size(), 100);
+    EXPECT_EQ(array[42], "42");
+    EXPECT_EQ(*array.get(99), "99");
+    EXPECT_EQ(array.get(100), nullptr);
+    EXPECT_TRUE(array.published(0));
+}
+
+TEST(ConcurrentArray, ManyProducers) {
+    constexpr size_t THREADS = 8;
+    constexpr size_t PER_THREAD = 20000;
+    nostd::ConcurrentArray<uint64_t> array;
+
+    std::vector<std::thread> producers;
+    for (size_t thread = 0; thread < THREADS; ++thread) {
+        producers.emplace_back([&array, thread] {
+            for (size_t idx = 0; idx < PER_THREAD; ++idx) {
+                const size_t slot = array.push_back(thread * PER_THREAD + idx);
+                ASSERT_EQ(array[slot], thread * PER_THREAD + idx);
+            }
+        });
+    }
+    for (auto& producer: producers) {
+        producer.join();
+    }
+
+    ASSERT_EQ(array.size(), THREADS * PER_THREAD);
+    std::vector<bool> seen(THREADS * PER_THREAD);
+    size_t count = 0;
+    array.for_each([&](size_t, uint64_t val) {
+        ASSERT_FALSE(seen[val]);
+        seen[val] = true;
+        ++count;
+    });
+    EXPECT_EQ(count, THREADS * PER_THREAD);
+}
+
+TEST(ConcurrentArray, ReadersSeePublishedElements) {
+    constexpr size_t SIZE = 100000;
+    nostd::ConcurrentArray<std::pair<uint64_t, uint64_t>, 16> array;
+    std::atomic<bool> done = false;
+
+    std::thread reader([&] {
+        while (!done.load()) {
+            const size_t size = array.size();
+            for (size_t idx = size > 64 ? size - 64 : 0; idx < size; ++idx) {
+                if (const auto* element = array.get(idx)) {
+                    // Both halves were written before the element was published
+                    ASSERT_EQ(element->first * 3, element->second);
+                }
+            }
+        }
+    });
+
+    std::vector<std::thread> producers;
+    for (size_t thread = 0; thread < 4; ++thread) {
+        producers.emplace_back([&] {
+            for (uint64_t val = 0; val < SIZE / 4; ++val) {
+                array.emplace_back(val, val * 3);
+            }
+        });
+    }
+    for (auto& producer: producers) {
+        producer.join();
+    }
+    done = true;
+    reader.join();
+
+    EXPECT_EQ(array.size(), SIZE);
+    for (size_t idx = 0; idx < SIZE; ++idx) {
+        ASSERT_TRUE(array.published(idx));
+    }
+}
+
+namespace {
+
+struct Throwing {
+    explicit Throwing(int val) : val(val) {
+        if (val < 0) {
+            throw std::runtime_error("negative");
+        }
+    }
+
+    Tricky<int> val;
+};
+
+} // namespace
+
+TEST(ConcurrentArray, ThrowingConstructorLeavesAHole) {
+    {
+        nostd::ConcurrentArray<Throwing, 4> array(100);
+        array.emplace_back(1);
+        EXPECT_THROW(array.emplace_back(-1), std::runtime_error);
+        array.emplace_back(3);
+
+        EXPECT_EQ(array.size(), 3);
+        EXPECT_FALSE(array.published(1));
+        EXPECT_TRUE(array.published(2));
+
+        size_t count = 0;
+        array.for_each([&](size_t, const Throwing&) { ++count; });
+        EXPECT_EQ(count, 2);
+    }
+    Tricky<int>::expect_no_instances();
+}
@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+
+#include <nostd/array/array.h>
+#include <nostd/parallel/parallel.h>
+
+#include <atomic>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+const size_t THREADS[] = {1, 2, 3, 8, 17};
+const size_t SIZES[] = {0, 1, 7, 100, 10007};
+
+nostd::Array<int64_t> Iota(size_t size) {
+    nostd::Array<int64_t> array(size);
+    std::iota(array.begin(), array.end(), 1);
+    return array;
+}
+
+} // namespace
+
+TEST(Parallel, ForEach) {
+    for (size_t threads: THREADS) {
+        for (size_t size: SIZES) {
+            auto array = Iota(size);
+            nostd::parallel::for_each(array, [](int64_t& val) { val *= 2; }, threads);
+            for (size_t idx = 0; idx < size; ++idx) {
+                ASSERT_EQ(array[idx], 2 * static_cast<int64_t>(idx + 1));
+            }
+        }
+    }
+}
+
+TEST(Parallel, Transform) {
+    for (size_t threads: THREADS) {
+        for (size_t size: SIZES) {
+            auto array = Iota(size);
+            nostd::Array<double> out(size);
+            nostd::parallel::transform(array, out, [](int64_t val) { return val * 0.5; }, threads);
+            for (size_t idx = 0; idx < size; ++idx) {
+                ASSERT_EQ(out[idx], 0.5 * static_cast<double>(idx + 1));
+            }
+        }
+    }
+}
+
+TEST(Parallel, Fill) {
+    for (size_t threads: THREADS) {
+        std::vector<uint8_t> vec(1001);
+        nostd::parallel::fill(vec, uint8_t{7}, threads);
+        EXPECT_EQ(std::count(vec.begin(), vec.end(), 7), 1001);
+    }
+}
+
+TEST(Parallel, Reduce) {
+    for (size_t threads: THREADS) {
+        for (size_t size: SIZES) {
+            auto array = Iota(size);
+            auto sum = nostd::parallel::reduce(array, int64_t{10}, std::plus<>(), threads);
+            ASSERT_EQ(sum, 10 + static_cast<int64_t>(size * (size + 1) / 2));
+        }
+    }
+}
+
+TEST(Parallel, ReduceNonCommutative) {
+    nostd::Array<std::string> words;
+    for (size_t idx = 0; idx < 1000; ++idx) {
+        words.push_back(std::to_string(idx % 10));
+    }
+
+    std::string expected = std::accumulate(words.begin(), words.end(), std::string(">"));
+    for (size_t threads: THREADS) {
+        ASSERT_EQ(nostd::parallel::reduce(words, std::string(">"), std::plus<>(), threads), expected);
+    }
+}
+
+TEST(Parallel, Scan) {
+    for (size_t threads: THREADS) {
+        for (size_t size: SIZES) {
+            auto array = Iota(size);
+            std::vector<int64_t> expected(size);
+
+            nostd::Array<int64_t> out(size);
+            nostd::parallel::inclusive_scan(array, out, std::plus<>(), threads);
+            std::inclusive_scan(array.begin(), array.end(), expected.begin());
+            ASSERT_TRUE(std::equal(out.begin(), out.end(), expected.begin()));
+
+            nostd::parallel::exclusive_scan(array, out, int64_t{5}, std::plus<>(), threads);
+            std::exclusive_scan(array.begin(), array.end(), expected.begin(), int64_t{5});
+            ASSERT_TRUE(std::equal(out.begin(), out.end(), expected.begin()));
+
+            // In place
+            std::inclusive_scan(array.begin(), array.end(), expected.begin());
+            nostd::parallel::inclusive_scan(array, array, std::plus<>(), threads);
+            ASSERT_TRUE(std::equal(array.begin(), array.end(), expected.begin()));
+        }
+    }
+}
+
+TEST(Parallel, Exception) {
+    auto array = Iota(10000);
+    auto fn = [](int64_t& val) {
+        if (val == 9000) {
+            throw std::runtime_error("worker");
+        }
+    };
+    EXPECT_THROW(nostd::parallel::for_each(array, fn, 4), std::runtime_error);
+}
+
+TEST(Parallel, ChunksAligned) {
+    alignas(64) static double buffer[4096];
+    nostd::parallel::detail::Chunks chunks(buffer, 4096, sizeof(double), 7);
+    ASSERT_EQ(chunks.size(), 7);
+    for (size_t chunk = 0; chunk < chunks.size(); ++chunk) {
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(buffer + chunks.begin(chunk)) % 64, 0);
+        EXPECT_LE(chunks.begin(chunk), chunks.end(chunk));
+    }
+    EXPECT_EQ(chunks.end(6), 4096);
+}
@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+
+#include <nostd/array/array.h>
+#include <nostd/bits/rank_select.h>
+
+#include "test_util.h"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+
+// Checks every rank and select against a scan
+void CheckIndex(const nostd::Array<bool>& bits, const nostd::bits::RankSelect<>& index) {
+    ASSERT_EQ(index.size(), bits.size());
+    size_t rank = 0;
+    for (size_t i = 0; i != bits.size(); ++i) {
+        ASSERT_EQ(index.rank1(i), rank) << i;
+        ASSERT_EQ(index.rank0(i), i - rank) << i;
+        if (bits[i]) {
+            ASSERT_EQ(index.select1(rank), i) << rank;
+            ++rank;
+        }
+    }
+    EXPECT_EQ(index.rank1(bits.size()), rank);
+    EXPECT_EQ(index.ones(), rank);
+    EXPECT_EQ(index.select1(rank), bits.size());
+}
+
+} // namespace
+
+TEST(RankSelect, Empty) {
+    nostd::Array<bool> bits;
+    nostd::bits::RankSelect index(bits);
+    EXPECT_EQ(index.size(), 0);
+    EXPECT_EQ(index.rank1(0), 0);
+    EXPECT_EQ(index.select1(0), 0);
+
+    nostd::Array<bool> zeros(10000, false);
+    nostd::bits::RankSelect zero_index(zeros);
+    EXPECT_EQ(zero_index.rank1(9999), 0);
+    EXPECT_EQ(zero_index.select1(0), 10000);
+}
+
+TEST(RankSelect, Densities) {
+    std::mt19937_64 gen(11);
+    for (double density: {0.001, 0.1, 0.5, 0.97, 1.0}) {
+        SCOPED_TRACE(density);
+        const auto bits = RandomBits(100003, density, gen);
+        nostd::bits::RankSelect index(bits);
+        CheckIndex(bits, index);
+    }
+}
+
+TEST(RankSelect, SparseSelectAcrossSamples) {
+    // Samples far apart: select searches many blocks between them
+    nostd::Array<bool> bits(3000000, false);
+    std::vector<size_t> positions;
+    for (size_t i = 17; i < bits.size(); i += 181) {
+        bits[i] = true;
+        positions.push_back(i);
+    }
+
+    nostd::bits::RankSelect index(bits);
+    ASSERT_EQ(index.ones(), positions.size());
+    for (size_t k = 0; k != positions.size(); ++k) {
+        ASSERT_EQ(index.select1(k), positions[k]);
+    }
+    EXPECT_EQ(index.rank1(positions.back() + 1), positions.size());
+}
+
+TEST(RankSelect, IncrementalUpdate) {
+    std::mt19937_64 gen(5);
+    std::bernoulli_distribution dist(0.3);
+    nostd::Array<bool> bits;
+    nostd::bits::RankSelect index(bits);
+
+    for (size_t round = 0; round != 40; ++round) {
+        const size_t count = round * 97 + 1;
+        for (size_t i = 0; i != count; ++i) {
+            bits.push_back(dist(gen));
+        }
+        index.update();
+        CheckIndex(bits, index);
+    }
+
+    // In place changes need a rebuild
+    bits.fill(1000, 5000, true);
+    index.rebuild();
+    CheckIndex(bits, index);
+}
+
+TEST(RankSelect, SpaceOverhead) {
+    std::mt19937_64 gen(3);
+    const auto bits = RandomBits(1 << 24, 0.5, gen);
+    nostd::bits::RankSelect index(bits);
+    const double overhead = static_cast<double>(index.index_bytes()) / static_cast<double>(bits.size() / 8);
+    EXPECT_LT(overhead, 0.035);
+}
@@ -0,0 +1,196 @@
+#include <gtest/gtest.h>
+
+#include <nostd/array/segmented_array.h>
+
+#include "test_util.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+TEST(SegmentIndex, Layout) {
+    using Index = nostd::detail::SegmentIndex<4>;
+    // Segments of 4, 8, 16... elements
+    EXPECT_EQ(Index::segment(0), 0);
+    EXPECT_EQ(Index::segment(3), 0);
+    EXPECT_EQ(Index::segment(4), 1);
+    EXPECT_EQ(Index::offset(4), 0);
+    EXPECT_EQ(Index::segment(11), 1);
+    EXPECT_EQ(Index::offset(11), 7);
+    EXPECT_EQ(Index::segment(12), 2);
+    EXPECT_EQ(Index::segment_begin(3), 28);
+
+    for (size_t idx = 0; idx < 100000; ++idx) {
+        const size_t segment = Index::segment(idx);
+        ASSERT_EQ(Index::segment_begin(segment) + Index::offset(idx), idx);
+        ASSERT_LT(Index::offset(idx), Index::segment_size(segment));
+    }
+}
+
+TEST(SegmentedArray, PushBackKeepsAddresses) {
+    nostd::SegmentedArray<int64_t> array;
+    std::vector<const int64_t*> addresses;
+    for (int64_t idx = 0; idx < 100000; ++idx) {
+        addresses.push_back(&array.emplace_back(idx));
+    }
+
+    ASSERT_EQ(array.size(), 100000);
+    for (size_t idx = 0; idx < array.size(); ++idx) {
+        ASSERT_EQ(&array[idx], addresses[idx]);
+        ASSERT_EQ(*addresses[idx], idx);
+    }
+    EXPECT_EQ(array.front(), 0);
+    EXPECT_EQ(array.back(), 99999);
+    EXPECT_GE(array.capacity(), array.size());
+    EXPECT_LT(array.capacity(), 2 * array.size() + 16);
+}
+
+TEST(SegmentedArray, Iterators) {
+    nostd::SegmentedArray<int, 4> array(100);
+    std::iota(array.begin(), array.end(), 0);
+    EXPECT_EQ(std::accumulate(array.begin(), array.end(), 0), 4950);
+    EXPECT_EQ(array.end() - array.begin(), 100);
+    EXPECT_EQ(*std::find(array.begin(), array.end(), 42), 42);
+    EXPECT_EQ(*array.rbegin(), 99);
+
+    std::sort(array.begin(), array.end(), std::greater<>());
+    EXPECT_EQ(array[0], 99);
+    EXPECT_TRUE(std::is_sorted(array.rbegin(), array.rend()));
+
+    const auto& view = array;
+    nostd::SegmentedArray<int, 4>::const_iterator it = array.begin();
+    EXPECT_EQ(it, view.begin());
+    EXPECT_EQ(it[5], 94);
+    static_assert(std::random_access_iterator<nostd::SegmentedArray<int>::iterator>);
+}
+
+TEST(SegmentedArray, ForEachSegment) {
+    nostd::SegmentedArray<int, 4> array;
+    for (int idx = 0; idx < 30; ++idx) {
+        array.push_back(idx);
+    }
+
+    std::vector<size_t> sizes;
+    int expected = 0;
+    array.for_each_segment([&](std::span<int> segment) {
+        sizes.push_back(segment.size());
+        for (int val: segment) {
+            EXPECT_EQ(val, expected++);
+        }
+    });
+    EXPECT_EQ(sizes, (std::vector<size_t>{4, 8, 16, 2}));
+}
+
+TEST(SegmentedArray, CopyMove) {
+    nostd::SegmentedArray<std::string> array = {"a", "b", "c"};
+    for (int idx = 0; idx < 100; ++idx) {
+        array.push_back(std::to_string(idx));
+    }
+
+    auto copy = array;
+    ASSERT_EQ(copy.size(), 103);
+    EXPECT_EQ(copy[2], "c");
+    EXPECT_EQ(copy[102], "99");
+
+    const std::string* address = &array[50];
+    auto moved = std::move(array);
+    EXPECT_EQ(&moved[50], address);
+    EXPECT_TRUE(array.empty());
+
+    array = moved;
+    EXPECT_EQ(array[50], moved[50]);
+
+    nostd::SegmentedArray<uint32_t> trivial(1000, 7);
+    nostd::SegmentedArray<uint32_t> trivial_copy(trivial);
+    EXPECT_EQ(std::count(trivial_copy.begin(), trivial_copy.end(), 7u), 1000);
+}
+
+namespace {
+
+template <typename T, bool Propagate>
+struct TaggedAllocator : std::allocator<T> {
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::bool_constant<Propagate>;
+
+    explicit TaggedAllocator(int tag) noexcept : tag(tag) {}
+    template <typename U>
+    TaggedAllocator(const TaggedAllocator<U, Propagate>& other) noexcept : tag(other.tag) {} // NOLINT
+
+    template <typename U>
+    struct rebind {
+        using other = TaggedAllocator<U, Propagate>;
+    };
+
+    friend bool operator==(const TaggedAllocator&, const TaggedAllocator&) = default;
+
+    int tag;
+};
+
+template <bool Propagate>
+void CheckCopyAssignAllocator() {
+    using Alloc = TaggedAllocator<std::string, Propagate>;
+    nostd::SegmentedArray<std::string, 16, Alloc> source(100, "x", Alloc(1));
+    nostd::SegmentedArray<std::string, 16, Alloc> target(3, "y", Alloc(2));
+
+    target = source;
+    ASSERT_EQ(target.size(), 100);
+    EXPECT_EQ(target[99], "x");
+    EXPECT_EQ(target.get_allocator().tag, Propagate ? 1 : 2);
+}
+
+} // namespace
+
+TEST(SegmentedArray, CopyAssignAllocator) {
+    CheckCopyAssignAllocator<false>();
+    CheckCopyAssignAllocator<true>();
+}
+
+TEST(SegmentedArray, Destruction) {
+    {
+        nostd::SegmentedArray<Tricky<int>> array;
+        for (int idx = 0; idx < 1000; ++idx) {
+            array.emplace_back(idx);
+        }
+        array.pop_back();
+        auto copy = array;
+        copy.clear();
+        copy.push_back(1);
+    }
+    Tricky<int>::expect_no_instances();
+}
+
+TEST(SegmentedArray, ReserveShrink) {
+    nostd::SegmentedArray<int, 8> array;
+    array.reserve(100);
+    EXPECT_GE(array.capacity(), 100);
+    const size_t segments = array.segment_count();
+
+    array.push_back(1);
+    const int* first = &array[0];
+    for (int idx = 0; idx < 99; ++idx) {
+        array.push_back(idx);
+    }
+    EXPECT_EQ(array.segment_count(), segments);
+    EXPECT_EQ(&array[0], first);
+
+    while (array.size() > 8) {
+        array.pop_back();
+    }
+    array.shrink_to_fit();
+    EXPECT_EQ(array.segment_count(), 1);
+    EXPECT_EQ(&array[0], first);
+
+    array.clear();
+    array.shrink_to_fit();
+    EXPECT_EQ(array.capacity(), 0);
+}
+
+TEST(SegmentedArray, At) {
+    nostd::SegmentedArray<int> array(3, 1);
+    EXPECT_EQ(array.at(2), 1);
+    EXPECT_THROW(static_cast<void>(array.at(3)), std::out_of_range);
+}
@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+
+#include <nostd/array/array.h>
+#include <nostd/serialization/serialization.h>
+
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+struct alignas(16) Vec4 {
+    float x, y, z, w;
+};
+
+// Aligned for every element type in the tests
+template <typename A>
+nostd::Array<std::max_align_t> ToBytes(const A& array) {
+    nostd::Array<std::max_align_t> buffer;
+    nostd::Array<std::byte> bytes;
+    nostd::serialize(array, [&](std::span<const std::byte> chunk) {
+        bytes.append_range(chunk);
+    });
+    EXPECT_EQ(bytes.size(), nostd::serialized_size(array));
+
+    buffer.resize_for_overwrite(nostd::util::CeilDiv(bytes.size(), sizeof(std::max_align_t)));
+    if (!bytes.empty()) {
+        std::memcpy(buffer.data(), bytes.data(), bytes.size());
+    }
+    return buffer;
+}
+
+template <typename A>
+std::span<const std::byte> AsBytes(const nostd::Array<std::max_align_t>& buffer, const A& array) {
+    return std::as_bytes(std::span(buffer.data(), buffer.size())).first(nostd::serialized_size(array));
+}
+
+} // namespace
+
+TEST(SerializationTest, RoundTrip) {
+    nostd::Array<int64_t> array(1000);
+    std::iota(array.begin(), array.end(), -500);
+
+    const auto buffer = ToBytes(array);
+    const auto bytes = AsBytes(buffer, array);
+
+    const auto view = nostd::view_from_bytes<int64_t>(bytes);
+    ASSERT_EQ(view.size(), array.size());
+    EXPECT_EQ(static_cast<const void*>(view.data()), static_cast<const void*>(bytes.data() + 24));
+    EXPECT_TRUE(std::equal(view.begin(), view.end(), array.begin()));
+
+    const auto copy = nostd::deserialize<int64_t>(bytes);
+    ASSERT_EQ(copy.size(), array.size());
+    EXPECT_TRUE(std::equal(copy.begin(), copy.end(), array.begin()));
+}
+
+TEST(SerializationTest, Empty) {
+    const nostd::Array<double> array;
+    const auto buffer = ToBytes(array);
+    const auto bytes = AsBytes(buffer, array);
+    EXPECT_EQ(bytes.size(), sizeof(nostd::serialization::Header));
+
+    EXPECT_TRUE(nostd::view_from_bytes<double>(bytes).empty());
+    EXPECT_TRUE(nostd::deserialize<double>(bytes).empty());
+}
+
+TEST(SerializationTest, OverAligned) {
+    nostd::Array<Vec4> array;
+    for (int i = 0; i != 10; ++i) {
+        array.push_back({float(i), 1, 2, 3});
+    }
+
+    const auto buffer = ToBytes(array);
+    const auto bytes = AsBytes(buffer, array);
+    // Header is padded up to the element alignment
+    EXPECT_EQ(bytes.size(), 32 + 10 * sizeof(Vec4));
+
+    const auto view = nostd::view_from_bytes<Vec4>(bytes);
+    ASSERT_EQ(view.size(), 10);
+    EXPECT_EQ(view[7].x, 7.0f);
+}
+
+TEST(SerializationTest, Stream) {
+    nostd::Array<uint16_t> array = {1, 2, 3, 65535};
+    std::ostringstream out;
+    nostd::serialize(array, out);
+
+    const std::string str = out.str();
+    ASSERT_EQ(str.size(), nostd::serialized_size(array));
+    const auto copy = nostd::deserialize<uint16_t>(std::as_bytes(std::span(str.data(), str.size())));
+    ASSERT_EQ(copy.size(), 4);
+    EXPECT_EQ(copy[3], 65535);
+}
+
+TEST(SerializationTest, Bool) {
+    nostd::Array<bool> array;
+    for (size_t i = 0; i != 1003; ++i) {
+        array.push_back(i % 7 == 0);
+    }
+    // Bits past the size must not reach the output
+    array.push_back(true);
+    array.pop_back();
+
+    const auto buffer = ToBytes(array);
+    const auto bytes = AsBytes(buffer, array);
+    EXPECT_EQ(bytes.size(), 24 + 126);
+    // Bits 1000..1002, only 1001 is a multiple of 7
+    EXPECT_EQ(bytes.back(), std::byte{0x02});
+
+    const auto copy = nostd::deserialize<bool>(bytes);
+    ASSERT_EQ(copy.size(), array.size());
+    for (size_t i = 0; i != copy.size(); ++i) {
+        ASSERT_EQ(copy[i], i % 7 == 0);
+    }
+}
+
+TEST(SerializationTest, Errors) {
+    nostd::Array<int32_t> array = {1, 2, 3};
+    const auto buffer = ToBytes(array);
+    const auto bytes = AsBytes(buffer, array);
+
+    EXPECT_THROW(nostd::view_from_bytes<int32_t>(bytes.first(10)), std::invalid_argument);
+    EXPECT_THROW(nostd::view_from_bytes<int32_t>(bytes.first(bytes.size() - 1)), std::invalid_argument);
+    EXPECT_THROW(nostd::view_from_bytes<uint64_t>(bytes), std::invalid_argument);
+    EXPECT_THROW(nostd::deserialize<bool>(bytes), std::invalid_argument);
+
+    auto corrupt = buffer;
+    std::memset(corrupt.data(), 0, 4);
+    EXPECT_THROW(nostd::view_from_bytes<int32_t>(AsBytes(corrupt, array)), std::invalid_argument);
+
+    // A count that would overflow when multiplied by the element size
+    auto huge = buffer;
+    const uint64_t count = ~uint64_t{0} / 2;
+    std::memcpy(reinterpret_cast<std::byte*>(huge.data()) + 16, &count, sizeof(count));
+    EXPECT_THROW(nostd::view_from_bytes<int32_t>(AsBytes(huge, array)), std::invalid_argument);
+}
@@ -0,0 +1,199 @@
+#include <gtest/gtest.h>
+
+#include <nostd/array/array.h>
+#include <nostd/simd/simd.h>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <stdexcept>
+
+namespace {
+
+using nostd::simd::Isa;
+
+const Isa ISAS[] = {Isa::Scalar, Isa::SSE2, Isa::AVX2, Isa::AVX512};
+const size_t SIZES[] = {0, 1, 3, 15, 16, 17, 63, 64, 65, 257, 1000, 4099};
+
+// Small integral values keep float sums exact, so every level must agree bit for bit
+template <typename T>
+nostd::Array<T> Random(size_t size, std::mt19937& gen) {
+    std::uniform_int_distribution<int> dist(0, 15);
+    nostd::Array<T> array(size);
+    for (auto& val: array) {
+        val = static_cast<T>(dist(gen));
+    }
+    return array;
+}
+
+template <typename T>
+void CheckKernels() {
+    std::mt19937 gen(42);
+    const auto& scalar = nostd::simd::kernels<T>(Isa::Scalar);
+
+    for (Isa isa: ISAS) {
+        if (!nostd::simd::supported(isa)) {
+            continue;
+        }
+        const auto& kernels = nostd::simd::kernels<T>(isa);
+
+        for (size_t size: SIZES) {
+            SCOPED_TRACE(testing::Message() << "isa " << static_cast<int>(isa) << " size " << size);
+            const auto lhs = Random<T>(size, gen);
+            const auto rhs = Random<T>(size, gen);
+
+            EXPECT_EQ(kernels.sum(lhs.data(), size), scalar.sum(lhs.data(), size));
+            EXPECT_EQ(kernels.dot(lhs.data(), rhs.data(), size), scalar.dot(lhs.data(), rhs.data(), size));
+            EXPECT_EQ(kernels.count(lhs.data(), size, T(7)), static_cast<size_t>(std::count(lhs.begin(), lhs.end(), T(7))));
+            EXPECT_EQ(kernels.find(lhs.data(), size, T(7)), static_cast<size_t>(std::find(lhs.begin(), lhs.end(), T(7)) - lhs.begin()));
+            EXPECT_EQ(kernels.find(lhs.data(), size, T(99)), size);
+
+            if (size != 0) {
+                const auto [lo, hi] = std::minmax_element(lhs.begin(), lhs.end());
+                EXPECT_EQ(kernels.min(lhs.data(), size), *lo);
+                EXPECT_EQ(kernels.max(lhs.data(), size), *hi);
+                EXPECT_EQ(kernels.minmax(lhs.data(), size), std::make_pair(*lo, *hi));
+            }
+        }
+    }
+}
+
+} // namespace
+
+TEST(SimdTest, Int8) {
+    CheckKernels<int8_t>();
+}
+
+TEST(SimdTest, Uint8) {
+    CheckKernels<uint8_t>();
+}
+
+TEST(SimdTest, Int16) {
+    CheckKernels<int16_t>();
+}
+
+TEST(SimdTest, Int32) {
+    CheckKernels<int32_t>();
+}
+
+TEST(SimdTest, Uint32) {
+    CheckKernels<uint32_t>();
+}
+
+TEST(SimdTest, Int64) {
+    CheckKernels<int64_t>();
+}
+
+TEST(SimdTest, Float) {
+    CheckKernels<float>();
+}
+
+TEST(SimdTest, Double) {
+    CheckKernels<double>();
+}
+
+TEST(SimdTest, ExtremesAtEnds) {
+    for (size_t size: {1, 5, 64, 100, 1001}) {
+        nostd::Array<int32_t> array(size, 0);
+        array.front() = -3;
+        array.back() = 9;
+        if (size == 1) {
+            array.back() = -3;
+        }
+        EXPECT_EQ(nostd::simd::min(array), -3);
+        EXPECT_EQ(nostd::simd::max(array), size == 1 ? -3 : 9);
+    }
+}
+
+TEST(SimdTest, SignedRanges) {
+    nostd::Array<int8_t> array = {5, -128, 127, -1, 0};
+    EXPECT_EQ(nostd::simd::minmax(array), std::make_pair(int8_t(-128), int8_t(127)));
+
+    nostd::Array<double> doubles = {1.5, -0.0, -2.25, 1e300};
+    EXPECT_EQ(nostd::simd::min(doubles), -2.25);
+    EXPECT_EQ(nostd::simd::max(doubles), 1e300);
+}
+
+TEST(SimdTest, CountManyNarrow) {
+    // Per lane counters of uint8_t must be flushed before they wrap
+    nostd::Array<uint8_t> array(100000, 3);
+    EXPECT_EQ(nostd::simd::count(array, 3), 100000u);
+    EXPECT_EQ(nostd::simd::count(array, 4), 0u);
+
+    nostd::Array<int16_t> shorts(300000, -1);
+    EXPECT_EQ(nostd::simd::count(shorts, -1), 300000u);
+}
+
+TEST(SimdTest, SumWraps) {
+    nostd::Array<int32_t> array(3, std::numeric_limits<int32_t>::max());
+    EXPECT_EQ(nostd::simd::sum(array), std::numeric_limits<int32_t>::max() - 2);
+}
+
+TEST(SimdTest, Find) {
+    nostd::Array<float> array(1000, 1.0f);
+    array[731] = 2.0f;
+    array[900] = 2.0f;
+    auto it = nostd::simd::find(array, 2.0f);
+    EXPECT_EQ(it - array.begin(), 731);
+    EXPECT_EQ(nostd::simd::find(array, 3.0f), array.end());
+    EXPECT_EQ(nostd::simd::count(array, std::nanf("")), 0u);
+}
+
+TEST(SimdTest, BitKernels) {
+    std::mt19937_64 gen(7);
+    for (Isa isa: ISAS) {
+        if (!nostd::simd::supported(isa)) {
+            continue;
+        }
+        const auto& kernels = nostd::simd::bit_kernels(isa);
+
+        for (size_t size: SIZES) {
+            SCOPED_TRACE(testing::Message() << "isa " << static_cast<int>(isa) << " size " << size);
+            nostd::Array<uint64_t> lhs(size);
+            nostd::Array<uint64_t> rhs(size);
+            size_t bits = 0;
+            for (size_t idx = 0; idx < size; ++idx) {
+                lhs[idx] = gen();
+                rhs[idx] = gen();
+                bits += std::popcount(lhs[idx]);
+            }
+            EXPECT_EQ(kernels.popcount(lhs.data(), size), bits);
+
+            auto result = lhs;
+            kernels.bit_and(result.data(), rhs.data(), size);
+            for (size_t idx = 0; idx < size; ++idx) {
+                ASSERT_EQ(result[idx], lhs[idx] & rhs[idx]);
+            }
+            result = lhs;
+            kernels.bit_or(result.data(), rhs.data(), size);
+            for (size_t idx = 0; idx < size; ++idx) {
+                ASSERT_EQ(result[idx], lhs[idx] | rhs[idx]);
+            }
+            result = lhs;
+            kernels.bit_xor(result.data(), rhs.data(), size);
+            kernels.bit_not(result.data(), size);
+            for (size_t idx = 0; idx < size; ++idx) {
+                ASSERT_EQ(result[idx], ~(lhs[idx] ^ rhs[idx]));
+            }
+
+            nostd::Array<uint64_t> sparse(size, 0);
+            EXPECT_EQ(kernels.find_nonzero(sparse.data(), size), size);
+            if (size != 0) {
+                sparse[size * 2 / 3] = uint64_t{1} << 40;
+                EXPECT_EQ(kernels.find_nonzero(sparse.data(), size), size * 2 / 3);
+            }
+        }
+    }
+}
+
+TEST(SimdTest, Errors) {
+    nostd::Array<int32_t> empty;
+    nostd::Array<int32_t> one(1);
+    EXPECT_EQ(nostd::simd::sum(empty), 0);
+    EXPECT_THROW(nostd::simd::min(empty), std::invalid_argument);
+    EXPECT_THROW(nostd::simd::minmax(empty), std::invalid_argument);
+    EXPECT_THROW(nostd::simd::dot(empty, one), std::invalid_argument);
+}
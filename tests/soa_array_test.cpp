@@ -0,0 +1,220 @@
+#include <gtest/gtest.h>
+
+#include <nostd/array/soa_array.h>
+#include <nostd/simd/simd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+
+namespace {
+
+// Throws on the copy number `fail_at`, counts live instances
+struct Fragile {
+    static inline int live = 0;
+    static inline int copies = 0;
+    static inline int fail_at = -1;
+
+    Fragile() noexcept {
+        ++live;
+    }
+
+    Fragile(const Fragile&) {
+        if (copies++ == fail_at) {
+            throw std::runtime_error("copy failed");
+        }
+        ++live;
+    }
+
+    Fragile(Fragile&&) noexcept {
+        ++live;
+    }
+
+    ~Fragile() {
+        --live;
+    }
+};
+
+} // namespace
+
+TEST(SoaArray, Layout) {
+    using Soa = nostd::SoaArray<double, int8_t, int32_t>;
+    static_assert(Soa::COLUMNS == 3);
+    static_assert(Soa::ROW_SIZE == 13);
+
+    Soa soa;
+    for (int idx = 0; idx < 1000; ++idx) {
+        soa.emplace_back(idx * 0.5, static_cast<int8_t>(idx), idx);
+    }
+
+    const auto first = reinterpret_cast<uintptr_t>(soa.column<0>().data());
+    const auto second = reinterpret_cast<uintptr_t>(soa.column<1>().data());
+    const auto third = reinterpret_cast<uintptr_t>(soa.column<2>().data());
+    EXPECT_EQ(first % Soa::COLUMN_ALIGNMENT, 0);
+    EXPECT_EQ(second % Soa::COLUMN_ALIGNMENT, 0);
+    EXPECT_EQ(third % Soa::COLUMN_ALIGNMENT, 0);
+    // One block, columns one after another
+    EXPECT_GE(second - first, soa.capacity() * sizeof(double));
+    EXPECT_LT(second - first, soa.capacity() * sizeof(double) + Soa::COLUMN_ALIGNMENT);
+    EXPECT_GE(third - second, soa.capacity());
+    EXPECT_LT(third - second, soa.capacity() + Soa::COLUMN_ALIGNMENT);
+
+    ASSERT_EQ(soa.column<2>().size(), 1000);
+    for (int idx = 0; idx < 1000; ++idx) {
+        ASSERT_EQ(soa.column<0>()[idx], idx * 0.5);
+        ASSERT_EQ(soa.column<1>()[idx], static_cast<int8_t>(idx));
+        ASSERT_EQ(soa.column<2>()[idx], idx);
+    }
+}
+
+TEST(SoaArray, RowProxies) {
+    nostd::SoaArray<int, std::string> soa;
+    soa.push_back({1, "one"});
+    soa.emplace_back(2, "two");
+
+    auto [id, name] = soa[1];
+    EXPECT_EQ(id, 2);
+    EXPECT_EQ(name, "two");
+    id = 20;
+    name += "!";
+    EXPECT_EQ(soa.column<0>()[1], 20);
+    EXPECT_EQ(soa.column<1>()[1], "two!");
+
+    soa[0] = std::tuple{10, "ten"};
+    EXPECT_EQ(std::get<0>(soa.front()), 10);
+    EXPECT_EQ(std::get<1>(soa.front()), "ten");
+
+    const std::tuple<int, std::string> row = soa.back();
+    EXPECT_EQ(row, std::tuple(20, "two!"));
+
+    const auto& view = soa;
+    EXPECT_EQ(std::get<1>(view.at(0)), "ten");
+    EXPECT_THROW((void)view.at(2), std::out_of_range);
+}
+
+TEST(SoaArray, Iterators) {
+    nostd::SoaArray<int, int64_t> soa(100);
+    int next = 0;
+    for (auto [key, value]: soa) {
+        key = next++;
+        value = key * 2;
+    }
+
+    EXPECT_EQ(soa.end() - soa.begin(), 100);
+    EXPECT_EQ(std::get<1>(*(soa.begin() + 42)), 84);
+    const auto found = std::find_if(soa.begin(), soa.end(), [](auto row) { return std::get<0>(row) == 17; });
+    EXPECT_EQ(found - soa.begin(), 17);
+
+    int64_t total = 0;
+    for (const auto& [key, value]: std::as_const(soa)) {
+        total += value - key;
+    }
+    EXPECT_EQ(total, 4950);
+}
+
+TEST(SoaArray, SimdOverColumn) {
+    nostd::SoaArray<float, int32_t, double> soa;
+    for (int32_t idx = 0; idx < 10000; ++idx) {
+        soa.emplace_back(1.0F, idx, 2.0);
+    }
+
+    EXPECT_EQ(nostd::simd::sum(soa.column<1>()), 49995000);
+    EXPECT_DOUBLE_EQ(nostd::simd::sum(soa.column<2>()), 20000.0);
+    EXPECT_EQ(nostd::simd::max(soa.column<1>()), 9999);
+}
+
+TEST(SoaArray, GrowthKeepsRows) {
+    nostd::SoaArray<std::string, int> soa;
+    for (int idx = 0; idx < 1000; ++idx) {
+        soa.emplace_back(std::to_string(idx), idx);
+        ASSERT_EQ(std::get<0>(soa.back()), std::to_string(idx));
+    }
+    for (int idx = 0; idx < 1000; ++idx) {
+        ASSERT_EQ(std::get<0>(soa[idx]), std::to_string(idx));
+        ASSERT_EQ(std::get<1>(soa[idx]), idx);
+    }
+
+    // Arguments referring to a row survive the relocation
+    soa.shrink_to_fit();
+    ASSERT_EQ(soa.size(), soa.capacity());
+    soa.emplace_back(std::get<0>(soa[0]), std::get<1>(soa[999]));
+    EXPECT_EQ(soa.back(), std::tuple("0", 999));
+}
+
+TEST(SoaArray, CapacityAndModifiers) {
+    nostd::SoaArray<int, char> soa;
+    EXPECT_TRUE(soa.empty());
+    EXPECT_EQ(soa.capacity(), 0);
+    EXPECT_TRUE(soa.column<0>().empty());
+
+    soa.reserve(100);
+    EXPECT_EQ(soa.capacity(), 100);
+    soa.resize(10);
+    EXPECT_EQ(soa.size(), 10);
+    EXPECT_EQ(soa.back(), std::tuple(0, '\0'));
+
+    soa.pop_back();
+    EXPECT_EQ(soa.size(), 9);
+    soa.resize(3);
+    EXPECT_EQ(soa.size(), 3);
+
+    soa.clear();
+    EXPECT_TRUE(soa.empty());
+    EXPECT_EQ(soa.capacity(), 100);
+    soa.shrink_to_fit();
+    EXPECT_EQ(soa.capacity(), 0);
+
+    EXPECT_THROW(soa.reserve(soa.max_size() + 1), std::length_error);
+}
+
+TEST(SoaArray, CopyAndMove) {
+    nostd::SoaArray<std::string, double> soa;
+    for (int idx = 0; idx < 100; ++idx) {
+        soa.emplace_back(std::string(idx, 'x'), idx);
+    }
+
+    nostd::SoaArray<std::string, double> copy(soa);
+    ASSERT_EQ(copy.size(), 100);
+    EXPECT_EQ(std::get<0>(copy[50]), std::string(50, 'x'));
+    EXPECT_NE(copy.column<1>().data(), soa.column<1>().data());
+
+    nostd::SoaArray<std::string, double> moved(std::move(copy));
+    EXPECT_TRUE(copy.empty());
+    EXPECT_EQ(moved.size(), 100);
+
+    copy = moved;
+    EXPECT_EQ(std::get<1>(copy[99]), 99);
+    moved = std::move(soa);
+    EXPECT_EQ(std::get<0>(moved[10]), std::string(10, 'x'));
+
+    copy.swap(soa);
+    EXPECT_EQ(soa.size(), 100);
+}
+
+TEST(SoaArray, ExceptionSafety) {
+    {
+        nostd::SoaArray<Fragile, Fragile> soa(10);
+        EXPECT_EQ(Fragile::live, 20);
+
+        // The second field of a row fails: the first one is destroyed, the row is not added
+        const Fragile value;
+        Fragile::copies = 0;
+        Fragile::fail_at = 1;
+        EXPECT_THROW(soa.emplace_back(value, value), std::runtime_error);
+        EXPECT_EQ(soa.size(), 10);
+        EXPECT_EQ(Fragile::live, 21);
+
+        // The copy fails in the second column: the first column is destroyed again
+        Fragile::copies = 0;
+        Fragile::fail_at = 15;
+        using Soa = nostd::SoaArray<Fragile, Fragile>;
+        EXPECT_THROW(Soa copy(soa), std::runtime_error);
+        EXPECT_EQ(Fragile::live, 21);
+        Fragile::fail_at = -1;
+    }
+    EXPECT_EQ(Fragile::live, 0);
+}
@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+
+#include <nostd/array/array.h>
+#include <nostd/sort/sort.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+const size_t THREADS[] = {1, 3, 8};
+// Insertion sorted, comparison sorted, radix sorted in cache and in buckets, split by sample sort
+const size_t SIZES[] = {0, 1, 7, 16, 17, 1000, 1025, 100000, 300007};
+
+template <typename T>
+nostd::Array<T> RandomArray(size_t size, uint64_t seed) {
+    std::mt19937_64 gen(seed);
+    nostd::Array<T> array;
+    array.reserve(size);
+    for (size_t idx = 0; idx < size; ++idx) {
+        if constexpr (std::floating_point<T>) {
+            array.push_back(static_cast<T>(std::normal_distribution<double>(0, 1e6)(gen)));
+        } else {
+            array.push_back(static_cast<T>(gen()));
+        }
+    }
+    return array;
+}
+
+template <typename T>
+void CheckSort() {
+    for (size_t threads: THREADS) {
+        for (size_t size: SIZES) {
+            auto array = RandomArray<T>(size, size + threads);
+            std::vector<T> expected(array.begin(), array.end());
+            std::sort(expected.begin(), expected.end());
+
+            nostd::sort(array, threads);
+            ASSERT_TRUE(std::equal(array.begin(), array.end(), expected.begin(), expected.end()))
+                << size << " elements, " << threads << " threads";
+        }
+    }
+}
+
+} // namespace
+
+TEST(Sort, Integers) {
+    CheckSort<uint8_t>();
+    CheckSort<int16_t>();
+    CheckSort<uint32_t>();
+    CheckSort<int32_t>();
+    CheckSort<uint64_t>();
+    CheckSort<int64_t>();
+}
+
+TEST(Sort, Floats) {
+    CheckSort<float>();
+    CheckSort<double>();
+
+    constexpr double INF = std::numeric_limits<double>::infinity();
+    nostd::Array<double> array = {3.5, -0.0, INF, -1e300, 0.0, -INF, 1e-300, -2.5, 0.0, -0.0};
+    nostd::sort(array);
+    const std::vector<double> expected = {-INF, -1e300, -2.5, -0.0, -0.0, 0.0, 0.0, 1e-300, 3.5, INF};
+    ASSERT_TRUE(std::equal(array.begin(), array.end(), expected.begin(), expected.end()));
+    EXPECT_TRUE(std::signbit(array[3]));
+    EXPECT_FALSE(std::signbit(array[5]));
+
+    // NaN goes past +inf, its negative before -inf
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    nostd::Array<double> with_nan = {1.0, nan, -INF, -nan, INF};
+    nostd::sort(with_nan);
+    EXPECT_TRUE(std::isnan(with_nan[0]));
+    EXPECT_EQ(with_nan[1], -INF);
+    EXPECT_EQ(with_nan[3], INF);
+    EXPECT_TRUE(std::isnan(with_nan[4]));
+}
+
+TEST(Sort, SkewedInputs) {
+    for (size_t threads: THREADS) {
+        // Few distinct keys fill few buckets, sorted input has one byte of each key changing
+        auto duplicates = RandomArray<uint64_t>(500000, 1);
+        for (auto& value: duplicates) {
+            value %= 3;
+        }
+        const auto ones = std::count(duplicates.begin(), duplicates.end(), 1);
+        nostd::sort(duplicates, threads);
+        EXPECT_TRUE(std::is_sorted(duplicates.begin(), duplicates.end()));
+        EXPECT_EQ(std::count(duplicates.begin(), duplicates.end(), 1), ones);
+
+        nostd::Array<int64_t> descending(400000);
+        for (size_t idx = 0; idx < descending.size(); ++idx) {
+            descending[idx] = -static_cast<int64_t>(idx);
+        }
+        nostd::sort(descending, threads);
+        for (size_t idx = 0; idx < descending.size(); ++idx) {
+            ASSERT_EQ(descending[idx], static_cast<int64_t>(idx) - 399999);
+        }
+
+        nostd::Array<uint32_t> same(300000, 7);
+        nostd::sort(same, threads);
+        EXPECT_EQ(std::count(same.begin(), same.end(), 7), 300000);
+    }
+}
+
+TEST(Sort, Comparator) {
+    for (size_t threads: THREADS) {
+        for (size_t size: SIZES) {
+            auto array = RandomArray<int32_t>(size, size);
+            std::vector<int32_t> expected(array.begin(), array.end());
+            std::sort(expected.begin(), expected.end(), std::greater<>());
+
+            nostd::sort(array, std::greater<>(), threads);
+            ASSERT_TRUE(std::equal(array.begin(), array.end(), expected.begin(), expected.end()));
+        }
+    }
+
+    // Not a radix key
+    std::mt19937_64 gen(9);
+    nostd::Array<std::string> strings;
+    for (size_t idx = 0; idx < 300000; ++idx) {
+        strings.push_back(std::to_string(gen() % 1000000));
+    }
+    std::vector<std::string> expected(strings.begin(), strings.end());
+    std::sort(expected.begin(), expected.end());
+    nostd::sort(strings, 4);
+    EXPECT_TRUE(std::equal(strings.begin(), strings.end(), expected.begin(), expected.end()));
+}
+
+TEST(Sort, ByKey) {
+    for (size_t size: SIZES) {
+        auto keys = RandomArray<int32_t>(size, size);
+        for (auto& key: keys) {
+            key %= 1000;
+        }
+        nostd::Array<uint32_t> values(size);
+        for (size_t idx = 0; idx < size; ++idx) {
+            values[idx] = static_cast<uint32_t>(idx);
+        }
+        const auto original = keys;
+
+        nostd::sort_by_key(keys, values);
+        for (size_t idx = 0; idx < size; ++idx) {
+            ASSERT_EQ(keys[idx], original[values[idx]]);
+            if (idx > 0) {
+                ASSERT_LE(keys[idx - 1], keys[idx]);
+                // Stable: equal keys keep their order
+                if (keys[idx - 1] == keys[idx]) {
+                    ASSERT_LT(values[idx - 1], values[idx]);
+                }
+            }
+        }
+    }
+
+    nostd::Array<double> keys = {2.0, 1.0};
+    nostd::Array<char> values = {'b'};
+    EXPECT_THROW(nostd::sort_by_key(keys, values), std::invalid_argument);
+}
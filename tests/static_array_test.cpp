@@ -0,0 +1,205 @@
+#include <gtest/gtest.h>
+
+#include <nostd/array/array.h>
+#include <nostd/array/static_array.h>
+
+#include "test_util.h"
+
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+template <typename T, size_t N>
+using StaticArray = nostd::StaticArray<T, N>;
+
+namespace {
+
+constexpr int ConstexprSum() {
+    nostd::StaticArray<int, 8> a({1, 2, 3});
+    a.push_back(4);
+
+    nostd::StaticArray<int, 8> b(a);
+    b.pop_back();
+    a.swap(b);
+
+    int sum = 0;
+    for (int val: a) {
+        sum += val;
+    }
+    return sum + static_cast<int>(b.size());
+}
+
+constinit nostd::StaticArray<int, 16> global_array;
+
+// Copy-only, so moves copy too; the copy after copies_left ones throws
+struct ThrowingCopy {
+    ThrowingCopy(size_t val) : val(val) { // NOLINT
+    }
+
+    ThrowingCopy(const ThrowingCopy& other) : val(other.val) {
+        if (copies_left-- == 0) {
+            throw std::runtime_error("ThrowingCopy");
+        }
+    }
+
+    ThrowingCopy& operator=(const ThrowingCopy& other) = default;
+
+    static inline size_t copies_left = SIZE_MAX;
+
+    Tricky<size_t> val;
+};
+
+} // namespace
+
+TEST(StaticArray, Constexpr) {
+    static_assert(ConstexprSum() == 10);
+    EXPECT_TRUE(global_array.empty());
+}
+
+TEST(StaticArray, Layout) {
+    struct alignas(32) Wide {
+        char val;
+    };
+
+    static_assert(alignof(StaticArray<Wide, 3>) == 32);
+    static_assert(alignof(StaticArray<char, 3>) == alignof(size_t));
+    static_assert(std::contiguous_iterator<StaticArray<int, 4>::iterator>);
+
+    StaticArray<Wide, 3> a(3);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(a.data()) % 32, 0);
+}
+
+TEST(StaticArray, PushBack) {
+    {
+        StaticArray<Tricky<size_t>, 16> a;
+        for (size_t i = 0; i != 16; ++i) {
+            EXPECT_TRUE(a.push_back(i));
+        }
+        EXPECT_TRUE(a.full());
+        EXPECT_THROW(a.push_back(16), std::length_error);
+
+        for (size_t i = 0; i != 16; ++i) {
+            EXPECT_EQ(i, a[i]);
+        }
+        EXPECT_EQ(15, a.back());
+        EXPECT_THROW((void)a.at(16), std::out_of_range);
+    }
+    Tricky<size_t>::expect_no_instances();
+}
+
+TEST(StaticArray, ReturnFalse) {
+    nostd::StaticArray<int, 2, nostd::overflow::ReturnFalse> a({1, 2, 3});
+    EXPECT_EQ(a.size(), 2);
+    EXPECT_FALSE(a.push_back(4));
+    EXPECT_EQ(a.back(), 2);
+}
+
+TEST(StaticArray, AbortDeath) {
+    nostd::StaticArray<int, 1, nostd::overflow::Abort> a({1});
+    EXPECT_DEATH((void)a.push_back(2), "");
+}
+
+TEST(StaticArray, MoveSwap) {
+    {
+        StaticArray<Tricky<size_t>, 8> a(3, 1);
+        StaticArray<Tricky<size_t>, 8> b(7, 2);
+
+        a.swap(b);
+        EXPECT_EQ(a.size(), 7);
+        EXPECT_EQ(b.size(), 3);
+        EXPECT_EQ(2, a[6]);
+        EXPECT_EQ(1, b[2]);
+
+        auto moved(std::move(a));
+        EXPECT_EQ(moved.size(), 7);
+        EXPECT_TRUE(a.empty());
+
+        b = moved;
+        EXPECT_EQ(b.size(), 7);
+        a = std::move(b);
+        EXPECT_EQ(a.size(), 7);
+        EXPECT_EQ(2, a.front());
+    }
+    Tricky<size_t>::expect_no_instances();
+}
+
+TEST(StaticArray, ThrowingMoveSwap) {
+    using ThrowingArray = StaticArray<ThrowingCopy, 8>;
+    {
+        ThrowingArray a(7, 1);
+        ThrowingCopy::copies_left = 5;
+        EXPECT_THROW(ThrowingArray moved(std::move(a)), std::runtime_error);
+        EXPECT_EQ(a.size(), 7);
+
+        ThrowingArray b(2, 2);
+        // Two copies swap the prefix, the third element of the tail throws
+        ThrowingCopy::copies_left = 4;
+        EXPECT_THROW(a.swap(b), std::runtime_error);
+        ThrowingCopy::copies_left = SIZE_MAX;
+        ASSERT_EQ(a.size(), 7);
+        ASSERT_EQ(b.size(), 2);
+        EXPECT_EQ(2, a[0].val);
+        EXPECT_EQ(1, b[1].val);
+        EXPECT_EQ(1, a[6].val);
+
+        a.swap(b);
+        EXPECT_EQ(a.size(), 2);
+        EXPECT_EQ(b.size(), 7);
+    }
+    Tricky<size_t>::expect_no_instances();
+}
+
+TEST(StaticArray, Strings) {
+    StaticArray<std::string, 4> a({"a", "bb", "ccc"});
+    StaticArray<std::string, 4> b;
+    b.swap(a);
+    EXPECT_EQ(std::accumulate(b.begin(), b.end(), std::string()), "abbccc");
+    EXPECT_TRUE(a.empty());
+}
+
+TEST(LocalStorage, ArrayMove) {
+    using LocalArray = nostd::Array<Tricky<size_t>, nostd::storage::LocalStorage<8>::storage_type>;
+    {
+        LocalArray a;
+        for (size_t i = 0; i != 8; ++i) {
+            a.push_back(i);
+        }
+        EXPECT_THROW(a.push_back(8), std::length_error);
+
+        LocalArray b(std::move(a));
+        EXPECT_EQ(b.size(), 8);
+        EXPECT_EQ(7, b.back());
+
+        LocalArray c;
+        c.push_back(42);
+        c.swap(b);
+        EXPECT_EQ(c.size(), 8);
+        EXPECT_EQ(42, b.back());
+    }
+    Tricky<size_t>::expect_no_instances();
+}
+
+TEST(LocalStorage, BoolArrayMove) {
+    using LocalBits = nostd::Array<bool, nostd::storage::LocalStorage<4>::storage_type>;
+    LocalBits a;
+    for (size_t i = 0; i != 200; ++i) {
+        a.push_back(i % 3 == 0);
+    }
+
+    LocalBits b(std::move(a));
+    EXPECT_EQ(b.size(), 200);
+    EXPECT_EQ(b.count(), 67);
+    EXPECT_TRUE(b[198]);
+
+    LocalBits c(5, true);
+    c.swap(b);
+    EXPECT_EQ(c.size(), 200);
+    EXPECT_EQ(c.count(), 67);
+    EXPECT_EQ(b.size(), 5);
+    EXPECT_EQ(b.count(), 5);
+
+    b = std::move(c);
+    EXPECT_EQ(b.size(), 200);
+    EXPECT_EQ(b.count(), 67);
+}
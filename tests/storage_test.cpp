@@ -0,0 +1,723 @@
+#include <gtest/gtest.h>
+
+#include <nostd/array/array.h>
+#include <nostd/storage/arena_storage.h>
+#include <nostd/storage/huge_page_storage.h>
+#include <nostd/storage/mmap_storage.h>
+#include <nostd/storage/storage.h>
+
+#include "test_util.h"
+
+#include <array>
+#include <cstdint>
+#include <numeric>
+#include <string>
+#include <system_error>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+using nostd::storage::DynamicStorage;
+
+TEST(DynamicStorage, Reallocate) {
+    DynamicStorage<int64_t> storage;
+    static_assert(nostd::storage::reallocatable_storage<DynamicStorage<int64_t>>);
+
+    ASSERT_TRUE(storage.reallocate(16));
+    ASSERT_EQ(storage.capacity(), 16);
+    for (size_t idx = 0; idx < 16; ++idx) {
+        storage.construct(idx, static_cast<int64_t>(idx));
+    }
+
+    ASSERT_TRUE(storage.reallocate(1024));
+    ASSERT_EQ(storage.capacity(), 1024);
+    for (size_t idx = 0; idx < 16; ++idx) {
+        ASSERT_EQ(storage[idx], idx);
+    }
+
+    ASSERT_TRUE(storage.reallocate(0));
+    ASSERT_EQ(storage.capacity(), 0);
+}
+
+TEST(DynamicStorage, ReallocateMapped) {
+    // Crosses the malloc -> mmap -> mremap -> malloc boundaries
+    size_t const N = (size_t{4} << 20) / sizeof(int64_t);
+    DynamicStorage<int64_t> storage;
+    storage.allocate(16);
+    for (size_t idx = 0; idx < 16; ++idx) {
+        storage.construct(idx, static_cast<int64_t>(idx));
+    }
+
+    ASSERT_TRUE(storage.reallocate(N / 2));
+    for (size_t idx = 16; idx < N / 2; ++idx) {
+        storage.construct(idx, static_cast<int64_t>(idx));
+    }
+
+    ASSERT_TRUE(storage.reallocate(N));
+    for (size_t idx = 0; idx < N / 2; ++idx) {
+        ASSERT_EQ(storage[idx], idx);
+    }
+
+    ASSERT_TRUE(storage.reallocate(8));
+    for (size_t idx = 0; idx < 8; ++idx) {
+        ASSERT_EQ(storage[idx], idx);
+    }
+    storage.deallocate();
+}
+
+TEST(DynamicStorage, NoReallocateForNonTrivial) {
+    // Array takes the allocate+relocate path directly, without a failed reallocate first
+    static_assert(!nostd::storage::reallocatable_storage<DynamicStorage<Tricky<int>>>);
+    struct alignas(64) Wide {
+        int64_t val;
+    };
+    static_assert(!nostd::storage::reallocatable_storage<DynamicStorage<Wide>>);
+
+    nostd::Array<Tricky<size_t>> a;
+    for (size_t idx = 0; idx < 100; ++idx) {
+        a.push_back(idx);
+    }
+    EXPECT_EQ(99, a.back());
+}
+
+TEST(DynamicStorage, ArrayGrowth) {
+    size_t const N = size_t{1} << 20;
+    nostd::Array<uint64_t> a;
+    for (size_t idx = 0; idx < N; ++idx) {
+        a.push_back(idx);
+    }
+    a.shrink_to_fit();
+    ASSERT_EQ(a.capacity(), N);
+
+    for (size_t idx = 0; idx < N; ++idx) {
+        ASSERT_EQ(a[idx], idx);
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+namespace {
+
+size_t heap_allocations = 0;
+
+template <typename T>
+struct CountingAllocator : std::allocator<T> {
+    using value_type = T;
+
+    CountingAllocator() = default;
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U>&) noexcept {} // NOLINT
+
+    T* allocate(size_t count) {
+        ++heap_allocations;
+        return std::allocator<T>::allocate(count);
+    }
+
+    template <typename U>
+    struct rebind {
+        using other = CountingAllocator<U>;
+    };
+};
+
+template <typename T>
+using SmallArray = nostd::Array<T, nostd::storage::SmallStorage<8, CountingAllocator<std::byte>>::storage_type>;
+
+template <typename Array>
+void Fill(Array& array, size_t count, size_t base) {
+    for (size_t idx = 0; idx < count; ++idx) {
+        array.push_back(base + idx);
+    }
+}
+
+template <typename Array>
+void ExpectFilled(const Array& array, size_t count, size_t base) {
+    ASSERT_EQ(array.size(), count);
+    for (size_t idx = 0; idx < count; ++idx) {
+        EXPECT_EQ(array[idx], base + idx);
+    }
+}
+
+} // namespace
+
+TEST(SmallStorage, StaysInline) {
+    heap_allocations = 0;
+    {
+        SmallArray<Tricky<size_t>> a;
+        Fill(a, 8, 0);
+        ExpectFilled(a, 8, 0);
+        EXPECT_EQ(a.capacity(), 8);
+    }
+    EXPECT_EQ(heap_allocations, 0);
+    Tricky<size_t>::expect_no_instances();
+}
+
+TEST(SmallStorage, Spills) {
+    heap_allocations = 0;
+    {
+        SmallArray<Tricky<size_t>> a;
+        Fill(a, 100, 0);
+        ExpectFilled(a, 100, 0);
+        EXPECT_GT(heap_allocations, 0);
+
+        // Back to the inline buffer
+        while (a.size() > 5) {
+            a.pop_back();
+        }
+        a.shrink_to_fit();
+        ExpectFilled(a, 5, 0);
+        EXPECT_EQ(a.capacity(), 8);
+    }
+    Tricky<size_t>::expect_no_instances();
+}
+
+TEST(SmallStorage, MoveSwap) {
+    {
+        SmallArray<Tricky<size_t>> inline_a, inline_b, heap_a, heap_b;
+        Fill(inline_a, 3, 0);
+        Fill(inline_b, 7, 100);
+        Fill(heap_a, 20, 200);
+        Fill(heap_b, 30, 300);
+
+        inline_a.swap(inline_b);
+        ExpectFilled(inline_a, 7, 100);
+        ExpectFilled(inline_b, 3, 0);
+
+        inline_a.swap(heap_a);
+        ExpectFilled(inline_a, 20, 200);
+        ExpectFilled(heap_a, 7, 100);
+
+        heap_b.swap(inline_b);
+        ExpectFilled(heap_b, 3, 0);
+        ExpectFilled(inline_b, 30, 300);
+
+        inline_b.swap(inline_a);
+        ExpectFilled(inline_b, 20, 200);
+        ExpectFilled(inline_a, 30, 300);
+
+        auto moved(std::move(heap_a));
+        ExpectFilled(moved, 7, 100);
+
+        auto copy(inline_b);
+        ExpectFilled(copy, 20, 200);
+        copy = heap_b;
+        ExpectFilled(copy, 3, 0);
+    }
+    Tricky<size_t>::expect_no_instances();
+}
+
+TEST(SmallStorage, Trivial) {
+    // Stateful allocators never take the reallocate path
+    static_assert(!nostd::storage::reallocatable_storage<
+        nostd::storage::DynamicStorageImpl<uint64_t, CountingAllocator<uint64_t>>>);
+
+    SmallArray<uint64_t> a;
+    Fill(a, 1000, 0);
+    ExpectFilled(a, 1000, 0);
+
+    SmallArray<uint64_t> b;
+    Fill(b, 2, 5);
+    a.swap(b);
+    ExpectFilled(a, 2, 5);
+    ExpectFilled(b, 1000, 0);
+}
+
+TEST(SmallStorage, BoolMoveSwap) {
+    using SmallBits = nostd::Array<bool, nostd::storage::SmallStorage<4, CountingAllocator<std::byte>>::storage_type>;
+    SmallBits inline_a(100, false), heap_a(1000, false);
+    for (size_t idx = 0; idx < 100; idx += 7) {
+        inline_a[idx] = true;
+    }
+    for (size_t idx = 0; idx < 1000; idx += 3) {
+        heap_a[idx] = true;
+    }
+
+    inline_a.swap(heap_a);
+    EXPECT_EQ(inline_a.size(), 1000);
+    EXPECT_EQ(inline_a.count(), 334);
+    EXPECT_EQ(heap_a.size(), 100);
+    EXPECT_EQ(heap_a.count(), 15);
+
+    SmallBits moved_inline(std::move(heap_a));
+    EXPECT_EQ(moved_inline.size(), 100);
+    EXPECT_EQ(moved_inline.count(), 15);
+    EXPECT_TRUE(moved_inline[98]);
+
+    SmallBits moved_heap(std::move(inline_a));
+    EXPECT_EQ(moved_heap.size(), 1000);
+    EXPECT_EQ(moved_heap.count(), 334);
+
+    moved_heap = std::move(moved_inline);
+    EXPECT_EQ(moved_heap.size(), 100);
+    EXPECT_EQ(moved_heap.count(), 15);
+}
+
+// ---------------------------------------------------
+
+namespace {
+
+using MmapArray = nostd::Array<int64_t, nostd::storage::MmapStorage>;
+using nostd::storage::MapMode;
+using nostd::storage::MmapStorage;
+
+struct TempFile {
+    TempFile() {
+        char name[] = "/tmp/nostd_mmap_XXXXXX";
+        const int fd = mkstemp(name);
+        EXPECT_GE(fd, 0);
+        close(fd);
+        path = name;
+    }
+
+    ~TempFile() {
+        unlink(path.c_str());
+    }
+
+    [[nodiscard]] size_t length() const {
+        struct stat st{};
+        EXPECT_EQ(stat(path.c_str(), &st), 0);
+        return static_cast<size_t>(st.st_size);
+    }
+
+    std::string path;
+};
+
+void WriteTable(const std::string& path, size_t size) {
+    MmapArray array(MmapStorage<int64_t>::create(path), 0);
+    for (size_t i = 0; i != size; ++i) {
+        array.push_back(static_cast<int64_t>(i * 3));
+    }
+    array.shrink_to_fit();
+}
+
+} // namespace
+
+TEST(MmapStorage, Anonymous) {
+    MmapArray array;
+    for (int64_t i = 0; i != 100000; ++i) {
+        array.push_back(i);
+    }
+    ASSERT_EQ(array.size(), 100000);
+    EXPECT_EQ(99999, array.back());
+
+    MmapArray copy(array);
+    EXPECT_EQ(copy[500], 500);
+
+    array.shrink_to_fit();
+    EXPECT_EQ(array[77777], 77777);
+}
+
+TEST(MmapStorage, SharedGrowsFile) {
+    TempFile file;
+    WriteTable(file.path, 10000);
+    EXPECT_EQ(file.length(), 10000 * sizeof(int64_t));
+
+    MmapArray table(MmapStorage<int64_t>::open(file.path, MapMode::ReadOnly));
+    ASSERT_EQ(table.size(), 10000);
+    for (size_t i = 0; i != table.size(); ++i) {
+        ASSERT_EQ(table[i], static_cast<int64_t>(i * 3));
+    }
+}
+
+TEST(MmapStorage, SharedWritesThrough) {
+    TempFile file;
+    WriteTable(file.path, 100);
+    {
+        auto storage = MmapStorage<int64_t>::open(file.path, MapMode::Shared);
+        ASSERT_EQ(storage.capacity(), 100);
+        MmapArray table(std::move(storage));
+        table[7] = -1;
+    }
+
+    MmapArray table(MmapStorage<int64_t>::open(file.path, MapMode::ReadOnly));
+    EXPECT_EQ(table[7], -1);
+}
+
+TEST(MmapStorage, PrivateIsCopyOnWrite) {
+    TempFile file;
+    WriteTable(file.path, 1000);
+    {
+        MmapArray table(MmapStorage<int64_t>::open(file.path, MapMode::Private));
+        table[10] = -1;
+        EXPECT_EQ(table[10], -1);
+
+        // Cannot grow the file, elements move to anonymous memory
+        table.push_back(42);
+        ASSERT_EQ(table.size(), 1001);
+        EXPECT_EQ(table[10], -1);
+        EXPECT_EQ(table.back(), 42);
+    }
+
+    MmapArray table(MmapStorage<int64_t>::open(file.path, MapMode::ReadOnly));
+    EXPECT_EQ(table.size(), 1000);
+    EXPECT_EQ(table[10], 30);
+}
+
+TEST(MmapStorage, ReadOnlyGrowthCopies) {
+    TempFile file;
+    WriteTable(file.path, 10);
+
+    // Writes to a read-only map fault, growth moves the elements to writable memory
+    MmapArray table(MmapStorage<int64_t>::open(file.path, MapMode::ReadOnly));
+    ASSERT_EQ(table.size(), 10);
+    table.push_back(-5);
+    table[0] = -100;
+    EXPECT_EQ(table[9], 27);
+    EXPECT_EQ(table[10], -5);
+    EXPECT_EQ(file.length(), 10 * sizeof(int64_t));
+}
+
+TEST(MmapStorage, Errors) {
+    EXPECT_THROW(MmapStorage<int64_t>::open("/nonexistent/nostd", MapMode::ReadOnly), std::system_error);
+
+    TempFile file;
+    {
+        nostd::Array<char, nostd::storage::MmapStorage> bytes(nostd::storage::MmapStorage<char>::create(file.path), 0);
+        bytes.push_back('x');
+        bytes.shrink_to_fit();
+    }
+    EXPECT_THROW(MmapStorage<int64_t>::open(file.path, MapMode::ReadOnly), std::invalid_argument);
+    EXPECT_THROW(MmapArray(MmapStorage<int64_t>::create(file.path, 2), 3), std::length_error);
+}
+
+// ----------------------------------------------------------------------------
+
+namespace {
+
+template <typename T>
+using Aligned64Array = nostd::Array<T, nostd::storage::AlignedStorage<64>::storage_type>;
+
+bool IsAligned(const void* ptr, size_t alignment) {
+    return reinterpret_cast<uintptr_t>(ptr) % alignment == 0;
+}
+
+} // namespace
+
+TEST(AlignedStorage, KeepsAlignmentOnGrowth) {
+    // Crosses from operator new blocks to mapped ones
+    Aligned64Array<float> array;
+    for (size_t idx = 0; idx < (size_t{2} << 20) / sizeof(float); ++idx) {
+        array.push_back(static_cast<float>(idx));
+        ASSERT_TRUE(IsAligned(array.data(), 64));
+    }
+    EXPECT_EQ(array[123456], 123456.0f);
+
+    while (array.size() > 3) {
+        array.pop_back();
+    }
+    array.shrink_to_fit();
+    EXPECT_TRUE(IsAligned(array.data(), 64));
+    EXPECT_EQ(array[2], 2.0f);
+}
+
+TEST(AlignedStorage, LargeAlignment) {
+    nostd::Array<uint8_t, nostd::storage::AlignedStorage<8192>::storage_type> array(100, 1);
+    EXPECT_TRUE(IsAligned(array.data(), 8192));
+    // Mapped blocks are aligned to pages only, larger alignments stay on operator new
+    array.resize_for_overwrite(size_t{3} << 20);
+    array.back() = 2;
+    EXPECT_TRUE(IsAligned(array.data(), 8192));
+    EXPECT_EQ(array[99], 1);
+    EXPECT_EQ(array.back(), 2);
+}
+
+TEST(AlignedStorage, Reallocate) {
+    using Storage = nostd::storage::AlignedStorage<64>::storage_type<int64_t>;
+    static_assert(nostd::storage::reallocatable_storage<Storage>);
+
+    Storage storage;
+    storage.allocate(16);
+    // Small blocks cannot be realloc'ed without losing the alignment
+    EXPECT_FALSE(storage.reallocate(32));
+    storage.deallocate();
+
+    const size_t N = (size_t{4} << 20) / sizeof(int64_t);
+    storage.allocate(N / 2);
+    for (size_t idx = 0; idx < N / 2; ++idx) {
+        storage.construct(idx, static_cast<int64_t>(idx));
+    }
+    ASSERT_TRUE(storage.reallocate(N));
+    EXPECT_TRUE(IsAligned(&storage[0], 64));
+    for (size_t idx = 0; idx < N / 2; ++idx) {
+        ASSERT_EQ(storage[idx], idx);
+    }
+    storage.deallocate();
+}
+
+TEST(AlignedStorage, NonTrivial) {
+    Aligned64Array<Tricky<int>> array;
+    for (int idx = 0; idx < 100; ++idx) {
+        array.emplace_back(idx);
+    }
+    EXPECT_TRUE(IsAligned(array.data(), 64));
+    EXPECT_EQ(array[99].get(), 99);
+}
+
+// ----------------------------------------------------------------------------
+
+using nostd::storage::HugePageStorage;
+using nostd::storage::PageKind;
+
+TEST(HugePageStorage, SmallUsesRegularPages) {
+    HugePageStorage<int32_t> storage;
+    storage.allocate(10);
+    EXPECT_EQ(storage.page_kind(), PageKind::Regular);
+    // Rounded up to whole pages
+    EXPECT_GE(storage.capacity(), 1024);
+    storage.deallocate();
+}
+
+TEST(HugePageStorage, LargeIsHugePageAligned) {
+    // Whatever backs it, the mapping is aligned to huge pages
+    const size_t N = (size_t{5} << 20) / sizeof(int64_t);
+    HugePageStorage<int64_t> storage;
+    storage.allocate(N);
+    EXPECT_NE(storage.page_kind(), PageKind::Regular);
+    EXPECT_TRUE(IsAligned(&storage[0], HugePageStorage<int64_t>::HUGE_PAGE_SIZE));
+    EXPECT_EQ(storage.capacity(), (size_t{6} << 20) / sizeof(int64_t));
+
+    for (size_t idx = 0; idx < N; ++idx) {
+        storage.construct(idx, static_cast<int64_t>(idx));
+    }
+    if (storage.reallocate(4 * N)) {
+        EXPECT_TRUE(IsAligned(&storage[0], HugePageStorage<int64_t>::HUGE_PAGE_SIZE));
+        for (size_t idx = 0; idx < N; ++idx) {
+            ASSERT_EQ(storage[idx], idx);
+        }
+    }
+    storage.deallocate();
+}
+
+TEST(HugePageStorage, ArrayGrowth) {
+    // Grows through regular pages, the switch to huge pages and mremap of huge ones
+    nostd::Array<uint64_t, HugePageStorage, nostd::growth::HugePageGranular<>> array;
+    const size_t N = size_t{3} << 20;
+    for (size_t idx = 0; idx < N; ++idx) {
+        array.push_back(idx);
+    }
+    ASSERT_EQ(array.size(), N);
+    EXPECT_TRUE(IsAligned(array.data(), HugePageStorage<uint64_t>::HUGE_PAGE_SIZE));
+    for (size_t idx = 0; idx < N; idx += 4097) {
+        ASSERT_EQ(array[idx], idx);
+    }
+
+    while (array.size() > 1000) {
+        array.pop_back();
+    }
+    array.shrink_to_fit();
+    EXPECT_EQ(array.back(), 999);
+
+    nostd::Array<uint64_t, HugePageStorage> filled(N / 2);
+    std::iota(filled.begin(), filled.end(), uint64_t{0});
+    EXPECT_EQ(filled[N / 2 - 1], N / 2 - 1);
+}
+
+// ----------------------------------------------------------------------------
+
+namespace {
+
+// Stateful allocator, every one counts the blocks it hands out
+template <typename T, bool Propagate = false>
+struct TaggedAllocator {
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::bool_constant<Propagate>;
+
+    explicit TaggedAllocator(int tag) noexcept : tag(tag) {}
+    template <typename U>
+    TaggedAllocator(const TaggedAllocator<U, Propagate>& other) noexcept : tag(other.tag) {} // NOLINT
+
+    T* allocate(size_t count) {
+        ++Live()[tag];
+        return std::allocator<T>().allocate(count);
+    }
+
+    void deallocate(T* ptr, size_t count) {
+        --Live()[tag];
+        std::allocator<T>().deallocate(ptr, count);
+    }
+
+    static std::array<int, 4>& Live() {
+        static std::array<int, 4> live{};
+        return live;
+    }
+
+    template <typename U>
+    struct rebind {
+        using other = TaggedAllocator<U, Propagate>;
+    };
+
+    friend bool operator==(const TaggedAllocator&, const TaggedAllocator&) = default;
+
+    int tag;
+};
+
+template <typename T, bool Propagate = false>
+using TaggedArray = nostd::Array<T, nostd::storage::AllocatorStorage<TaggedAllocator<T, Propagate>>::template storage_type>;
+
+} // namespace
+
+TEST(AllocatorPropagation, Growth) {
+    using Alloc = TaggedAllocator<int64_t>;
+    {
+        TaggedArray<int64_t> array(Alloc(1));
+        Fill(array, 1000, 0);
+        EXPECT_EQ(array.get_allocator().tag, 1);
+        EXPECT_EQ(Alloc::Live()[1], 1);
+        EXPECT_EQ(Alloc::Live()[0], 0);
+
+        TaggedArray<int64_t> filled(10, 7, Alloc(2));
+        EXPECT_EQ(filled.get_allocator().tag, 2);
+        filled.shrink_to_fit();
+        filled.reserve(100);
+        EXPECT_EQ(Alloc::Live()[2], 1);
+    }
+    EXPECT_EQ(Alloc::Live()[1], 0);
+    EXPECT_EQ(Alloc::Live()[2], 0);
+}
+
+TEST(AllocatorPropagation, CopyAndMove) {
+    using Alloc = TaggedAllocator<std::string>;
+    {
+        TaggedArray<std::string> array(Alloc(1));
+        array.push_back("a");
+        array.push_back("b");
+
+        TaggedArray<std::string> copy(array);
+        EXPECT_EQ(copy.get_allocator().tag, 1);
+        EXPECT_EQ(Alloc::Live()[1], 2);
+
+        TaggedArray<std::string> moved(std::move(copy));
+        EXPECT_EQ(moved.get_allocator().tag, 1);
+        EXPECT_EQ(moved[1], "b");
+
+        // Not propagated on copy assignment, the target keeps its allocator
+        TaggedArray<std::string> target(Alloc(2));
+        target.push_back("x");
+        target = array;
+        EXPECT_EQ(target.get_allocator().tag, 2);
+        EXPECT_EQ(target[0], "a");
+        EXPECT_EQ(Alloc::Live()[2], 1);
+    }
+    EXPECT_EQ(Alloc::Live()[1], 0);
+    EXPECT_EQ(Alloc::Live()[2], 0);
+}
+
+TEST(AllocatorPropagation, PropagatedCopyAssignment) {
+    using Alloc = TaggedAllocator<int32_t, true>;
+    {
+        TaggedArray<int32_t, true> source(4, 1, Alloc(1));
+        TaggedArray<int32_t, true> target(100, 2, Alloc(2));
+        // Fits, but the buffer belongs to the replaced allocator
+        target = source;
+        EXPECT_EQ(target.get_allocator().tag, 1);
+        EXPECT_EQ(target.size(), 4);
+        EXPECT_EQ(Alloc::Live()[1], 2);
+        EXPECT_EQ(Alloc::Live()[2], 0);
+    }
+    EXPECT_EQ(Alloc::Live()[1], 0);
+}
+
+TEST(AllocatorPropagation, Bool) {
+    using Alloc = TaggedAllocator<uint64_t>;
+    {
+        nostd::Array<bool, nostd::storage::AllocatorStorage<Alloc>::template storage_type> bits(Alloc(3));
+        for (size_t idx = 0; idx < 1000; ++idx) {
+            bits.push_back(idx % 3 == 0);
+        }
+        auto copy = bits;
+        EXPECT_EQ(copy.get_allocator().tag, 3);
+        EXPECT_TRUE(copy[999]);
+        EXPECT_EQ(Alloc::Live()[3], 2);
+    }
+    EXPECT_EQ(Alloc::Live()[3], 0);
+}
+
+// ----------------------------------------------------------------------------
+
+using nostd::storage::Arena;
+
+template <typename T>
+using ArenaArray = nostd::Array<T, nostd::storage::ArenaStorage::storage_type>;
+
+TEST(ArenaStorage, ArraysShareTheArena) {
+    Arena arena(4096);
+    ArenaArray<int64_t> ints(arena);
+    ArenaArray<double> doubles(arena);
+    for (int64_t idx = 0; idx < 10000; ++idx) {
+        ints.push_back(idx);
+        doubles.push_back(static_cast<double>(idx) / 2);
+    }
+    EXPECT_EQ(ints[9999], 9999);
+    EXPECT_EQ(doubles[9999], 4999.5);
+    EXPECT_EQ(&ints.get_allocator().arena(), &arena);
+    EXPECT_GT(arena.reserved(), 2 * 10000 * sizeof(int64_t));
+
+    auto copy = ints;
+    EXPECT_EQ(&copy.get_allocator().arena(), &arena);
+    EXPECT_EQ(copy[5000], 5000);
+}
+
+TEST(ArenaStorage, LatestAllocationIsReused) {
+    Arena arena;
+    void* first = arena.allocate(100, 8);
+    arena.deallocate(first, 100);
+    EXPECT_EQ(arena.allocate(100, 8), first);
+
+    // Temporaries destroyed before the next one is built take no extra memory
+    for (int idx = 0; idx < 1000; ++idx) {
+        ArenaArray<int32_t> temporary(1000, idx, arena);
+        EXPECT_EQ(temporary[999], idx);
+    }
+    EXPECT_EQ(arena.reserved(), Arena::DEFAULT_BLOCK_SIZE);
+}
+
+TEST(ArenaStorage, SizedConstructors) {
+    Arena arena;
+    ArenaArray<int64_t> zeros(100, arena);
+    EXPECT_EQ(zeros.size(), 100);
+    EXPECT_EQ(zeros[99], 0);
+    EXPECT_EQ(&zeros.get_allocator().arena(), &arena);
+
+    ArenaArray<int64_t> scratch(1000, nostd::uninit, arena);
+    EXPECT_EQ(scratch.size(), 1000);
+    EXPECT_EQ(&scratch.get_allocator().arena(), &arena);
+    for (int64_t idx = 0; idx < 1000; ++idx) {
+        scratch[idx] = idx;
+    }
+    EXPECT_EQ(scratch[999], 999);
+    EXPECT_GE(arena.reserved(), 1100 * sizeof(int64_t));
+
+    ArenaArray<int64_t> empty(0, nostd::uninit, arena);
+    EXPECT_TRUE(empty.empty());
+}
+
+TEST(ArenaStorage, Release) {
+    Arena arena(1024);
+    for (int round = 0; round < 3; ++round) {
+        {
+            ArenaArray<std::string> strings(arena);
+            for (int idx = 0; idx < 100; ++idx) {
+                strings.push_back(std::to_string(idx));
+            }
+            ArenaArray<uint8_t> big(10000, 1, arena);
+            EXPECT_EQ(strings[42], "42");
+            EXPECT_EQ(big[9999], 1);
+        }
+        arena.release();
+        // A single regular block survives
+        EXPECT_EQ(arena.reserved(), 1024);
+    }
+}
+
+TEST(ArenaStorage, Alignment) {
+    Arena arena;
+    void* byte = arena.allocate(1, 1);
+    void* line = arena.allocate(64, 64);
+    EXPECT_NE(byte, line);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(line) % 64, 0);
+
+    void* huge = arena.allocate(size_t{1} << 20, 4096);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(huge) % 4096, 0);
+    // The current block is still in use after a dedicated one
+    void* next = arena.allocate(8, 8);
+    EXPECT_LT(reinterpret_cast<std::byte*>(next) - reinterpret_cast<std::byte*>(line), 128);
+}
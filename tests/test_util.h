@@ -3,6 +3,10 @@
 #include "gtest/gtest.h"
 #include "unordered_set"
 
+#include <random>
+
+#include <nostd/array/array.h>
+
 template<typename T>
 T const &as_const(T &obj) {
     return obj;
@@ -44,6 +48,12 @@ struct Tricky {
         return instances;
     }
 
+    // Copy constructions and assignments so far
+    static size_t &copies() {
+        static size_t copies = 0;
+        return copies;
+    }
+
     static void expect_no_instances() {
         if (!instances().empty()) {
             FAIL() << "not all instances are destroyed";
@@ -90,8 +100,19 @@ private:
     }
 
     void copy() {
+        ++copies();
     }
 
     T val;
 };
 
+
+// size bits, each set with probability density
+inline nostd::Array<bool> RandomBits(size_t size, double density, std::mt19937_64& gen) {
+    std::bernoulli_distribution dist(density);
+    nostd::Array<bool> bits;
+    for (size_t i = 0; i != size; ++i) {
+        bits.push_back(dist(gen));
+    }
+    return bits;
+}